@@ -0,0 +1,318 @@
+/*
+ * apsp.c - All-Pairs Shortest Paths (cache-blocked Floyd–Warshall)
+ *
+ * For small, dense graphs a full distance table is cheaper to compute
+ * in one go than with V separate Dijkstra runs: Floyd–Warshall does
+ * V³ additions, but they run over contiguous rows with no heap and no
+ * pointer chasing, so they vectorize.
+ *
+ *   for k: for i: for j:  d[i][j] = min(d[i][j], d[i][k] + d[k][j])
+ *
+ * Blocking:
+ *   The plain triple loop streams the whole V×V matrix through the cache
+ *   once per k. Instead the matrix is cut into APSP_TILE × APSP_TILE
+ *   tiles and, for each block of APSP_TILE values of k, processed in
+ *   three phases (Venkataraman et al.):
+ *
+ *     ┌───┬───┬───┐   1. the diagonal tile (kb, kb)
+ *     │ 3 │ 2 │ 3 │   2. the rest of tile row kb and tile column kb,
+ *     ├───┼───┼───┤      each using the finished diagonal tile
+ *     │ 2 │ 1 │ 2 │   3. every other tile (i, j), using tile (i, kb)
+ *     ├───┼───┼───┤      and tile (kb, j) from phase 2
+ *     │ 3 │ 2 │ 3 │
+ *     └───┴───┴───┘
+ *
+ *   A tile update touches three tiles (3 × 16 KB), which stay in L2 for
+ *   all APSP_TILE values of k. Tiles within phase 2 and within phase 3
+ *   are independent, so they are split across threads.
+ *
+ * Kernels:
+ *   The inner loop is a min-plus row update plus a next-hop select,
+ *   written once against simd.h: AVX2 (8 lanes) with make MARCH=native,
+ *   SSE2 (4 lanes) by default on x86-64, plain ints elsewhere.
+ *
+ * Infinity:
+ *   Unreachable entries hold INF, like the results of the other engines.
+ *   Every entry is >= 0, so d[i][k] + d[k][j] wraps past INT_MAX exactly
+ *   when the sum comes out below d[i][k]; the kernel masks those lanes
+ *   out, which makes the table saturate at INF the way dist_add() does.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include "simd.h"
+#include "threads.h"
+
+#define APSP_TILE         64            /* Tile side; a multiple of every vector width */
+#define APSP_MAX_VERTICES 65536         /* Keeps V² entries addressable and next hops in 32 bits */
+
+/* Tile sets processed in parallel for one block of k */
+typedef enum {
+    APSP_PHASE_CROSS,   /* Tile row and tile column kb */
+    APSP_PHASE_REST     /* Every tile outside them */
+} ApspPhase;
+
+typedef struct ApspTask {
+    DistanceMatrix *m;
+    ApspPhase phase;
+    vertex_t kb;        /* First k of the block (tile index * APSP_TILE) */
+    vertex_t tiles;     /* Tiles per row */
+    vertex_t first;     /* Range of tile numbers [first, last) */
+    vertex_t last;
+} ApspTask;
+
+/*====================================================================
+ * MIN-PLUS KERNELS (one body for every instruction set, see simd.h)
+ *====================================================================*/
+
+/*
+ * relax_step - cur = min(cur, a + row) on one vector, taking h where it improves
+ *
+ * Lanes where a + row wrapped (came out below a) never improve.
+ */
+#define relax_step(cur, hops, a, row, h) do {                           \
+        simd_vec cand_ = vec_add((a), (row));                           \
+        simd_vec better_ = vec_andnot(vec_gt((a), cand_),               \
+                                      vec_gt((cur), cand_));            \
+        (cur) = vec_select(better_, cand_, (cur));                      \
+        (hops) = vec_select(better_, (h), (hops));                      \
+    } while (0)
+
+/*
+ * relax_tile - Runs k = kb .. kb + APSP_TILE - 1 over tile (ib, jb)
+ *
+ * With k outermost this is Floyd–Warshall restricted to the tile, so it
+ * is also correct when the tile is (kb, jb), (ib, kb) or (kb, kb) itself:
+ * row k and column k do not change while k is the pivot (d[k][k] = 0).
+ */
+static void relax_tile(DistanceMatrix *m, vertex_t ib, vertex_t jb, vertex_t kb) {
+    size_t stride = (size_t)m->stride;
+
+    for (vertex_t k = kb; k < kb + APSP_TILE; k++) {
+        const int *row = m->distance + (size_t)k * stride + jb;
+        for (vertex_t i = ib; i < ib + APSP_TILE; i++) {
+            size_t base = (size_t)i * stride;
+            int dik = m->distance[base + k];
+            if (dik == INF) continue;   /* No path to k: nothing to improve */
+
+            const simd_vec a = vec_set1(dik);
+            const simd_vec h = vec_set1(m->next[base + k]);
+            int *dist = m->distance + base + jb;
+            int32_t *next = m->next + base + jb;
+            for (int j = 0; j < APSP_TILE; j += SIMD_LANES) {
+                simd_vec cur = vec_load(dist + j);
+                simd_vec hops = vec_load(next + j);
+                relax_step(cur, hops, a, vec_load(row + j), h);
+                vec_store(dist + j, cur);
+                vec_store(next + j, hops);
+            }
+        }
+    }
+}
+
+/*====================================================================
+ * PARALLEL PHASES
+ *====================================================================*/
+
+static void *apsp_worker(void *arg) {
+    ApspTask *task = (ApspTask *)arg;
+    vertex_t kt = task->kb / APSP_TILE;
+    vertex_t others = task->tiles - 1;
+
+    for (vertex_t t = task->first; t < task->last; t++) {
+        if (task->phase == APSP_PHASE_CROSS) {
+            /* 0 .. others-1: tile row kb, then others .. 2*others-1: tile column kb */
+            vertex_t x = t % others;
+            if (x >= kt) x++;
+            x *= APSP_TILE;
+            if (t < others) {
+                relax_tile(task->m, task->kb, x, task->kb);
+            } else {
+                relax_tile(task->m, x, task->kb, task->kb);
+            }
+        } else {
+            vertex_t i = t / others, j = t % others;
+            if (i >= kt) i++;
+            if (j >= kt) j++;
+            relax_tile(task->m, i * APSP_TILE, j * APSP_TILE, task->kb);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * run_phase - Splits @count tiles of one phase into contiguous ranges
+ */
+static void run_phase(ApspTask *tasks, int num_threads,
+                      ApspPhase phase, vertex_t kb, vertex_t count) {
+    int used = (count < num_threads) ? (int)count : num_threads;
+
+    for (int t = 0; t < used; t++) {
+        tasks[t].phase = phase;
+        tasks[t].kb = kb;
+        tasks[t].first = (vertex_t)((int64_t)count * t / used);
+        tasks[t].last = (vertex_t)((int64_t)count * (t + 1) / used);
+    }
+    run_tasks(apsp_worker, tasks, sizeof(ApspTask), used);
+}
+
+/*====================================================================
+ * PUBLIC INTERFACE
+ *====================================================================*/
+
+/*
+ * floyd_warshall - Computes all-pairs distances and next hops of @g
+ *
+ * @g:           Graph with non-negative weights (parallel edges allowed)
+ * @num_threads: Threads for the tile phases (see thread_count())
+ *
+ * Meant for dense graphs of up to a few thousand vertices, where it
+ * beats V runs of dijkstra_heap_csr(): memory is Θ(V²) (8 bytes per
+ * pair) and work Θ(V³) regardless of the number of edges.
+ *
+ * Time Complexity: O(V³ / (lanes · threads))
+ *
+ * Return: Matrix, or NULL on invalid input / allocation failure
+ *         Caller must call free_distance_matrix()!
+ */
+DistanceMatrix *floyd_warshall(const CSRGraph *g, int num_threads) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph in floyd_warshall()\n");
+        return NULL;
+    }
+    if (g->num_vertices > APSP_MAX_VERTICES) {
+        fprintf(stderr, "Error: %" PRIdVERTEX " vertices is too many for a distance matrix"
+                " (limit %d)\n", g->num_vertices, APSP_MAX_VERTICES);
+        return NULL;
+    }
+    num_threads = thread_count(num_threads, TASK_MAX_THREADS);
+
+    DistanceMatrix *m = (DistanceMatrix *)calloc(1, sizeof(DistanceMatrix));
+    if (m == NULL) return NULL;
+
+    vertex_t n = g->num_vertices;
+    vertex_t tiles = (n + APSP_TILE - 1) / APSP_TILE;
+    m->num_vertices = n;
+    /*
+     * One extra cache line per row: with a power-of-two stride the 64 rows
+     * of a tile would all map to the same few L1 sets and evict each other.
+     */
+    m->stride = tiles * APSP_TILE + 16;
+    size_t cells = (size_t)tiles * APSP_TILE * (size_t)m->stride;
+
+    /* Cache-line aligned rows (the stride is a multiple of 64 bytes) */
+    void *dist = NULL, *next = NULL;
+    if (cells > 0 && (posix_memalign(&dist, 64, cells * sizeof(int)) != 0 ||
+                      posix_memalign(&next, 64, cells * sizeof(int32_t)) != 0)) {
+        fprintf(stderr, "Error: Failed to allocate a %" PRIdVERTEX " x %" PRIdVERTEX
+                " distance matrix\n", n, n);
+        free(dist);
+        free(m);
+        return NULL;
+    }
+    m->distance = (int *)dist;
+    m->next = (int32_t *)next;
+
+    /* Direct edges; padding rows and columns stay unreachable */
+    for (size_t c = 0; c < cells; c++) {
+        m->distance[c] = INF;
+        m->next[c] = -1;
+    }
+    for (vertex_t u = 0; u < n; u++) {
+        size_t base = (size_t)u * (size_t)m->stride;
+        m->distance[base + u] = 0;
+        m->next[base + u] = (int32_t)u;
+        for (edge_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            vertex_t v = g->destinations[e];
+            int w = g->weights[e];
+            if (w < m->distance[base + v]) {
+                m->distance[base + v] = w;
+                m->next[base + v] = (int32_t)v;
+            }
+        }
+    }
+
+    ApspTask tasks[TASK_MAX_THREADS];
+    for (int t = 0; t < num_threads; t++) {
+        tasks[t].m = m;
+        tasks[t].tiles = tiles;
+    }
+
+    for (vertex_t kt = 0; kt < tiles; kt++) {
+        vertex_t kb = kt * APSP_TILE;
+        relax_tile(m, kb, kb, kb);
+        if (tiles > 1) {
+            run_phase(tasks, num_threads, APSP_PHASE_CROSS, kb, 2 * (tiles - 1));
+            run_phase(tasks, num_threads, APSP_PHASE_REST, kb,
+                      (tiles - 1) * (tiles - 1));
+        }
+    }
+    return m;
+}
+
+/*
+ * apsp_distance - Distance @source → @target from the matrix
+ *
+ * Return: Shortest distance, INF if unreachable or out of range
+ */
+int apsp_distance(const DistanceMatrix *m, vertex_t source, vertex_t target) {
+    if (m == NULL || source < 0 || source >= m->num_vertices ||
+        target < 0 || target >= m->num_vertices) {
+        return INF;
+    }
+    return m->distance[(size_t)source * (size_t)m->stride + (size_t)target];
+}
+
+/*
+ * apsp_path - Recovers the shortest path @source → @target by following
+ *             next hops
+ *
+ * Time Complexity: O(path length)
+ *
+ * Return: Path (vertices NULL and distance INF if unreachable),
+ *         or NULL on invalid input. Caller must call free_shortest_path()!
+ */
+ShortestPath *apsp_path(const DistanceMatrix *m, vertex_t source, vertex_t target) {
+    if (m == NULL || source < 0 || source >= m->num_vertices ||
+        target < 0 || target >= m->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to apsp_path()\n");
+        return NULL;
+    }
+
+    ShortestPath *sp = (ShortestPath *)calloc(1, sizeof(ShortestPath));
+    if (sp == NULL) return NULL;
+    sp->source = source;
+    sp->target = target;
+    sp->distance = apsp_distance(m, source, target);
+    if (sp->distance == INF) return sp;
+
+    size_t stride = (size_t)m->stride;
+    for (vertex_t v = source; ; v = m->next[(size_t)v * stride + (size_t)target]) {
+        sp->length++;
+        if (v == target) break;
+    }
+
+    sp->vertices = (vertex_t *)malloc((size_t)sp->length * sizeof(vertex_t));
+    if (sp->vertices == NULL) {
+        free(sp);
+        return NULL;
+    }
+
+    vertex_t v = source;
+    for (vertex_t i = 0; i < sp->length; i++) {
+        sp->vertices[i] = v;
+        v = m->next[(size_t)v * stride + (size_t)target];
+    }
+    return sp;
+}
+
+/*
+ * free_distance_matrix - Releases a matrix from floyd_warshall()
+ */
+void free_distance_matrix(DistanceMatrix *m) {
+    if (m == NULL) return;
+    free(m->distance);
+    free(m->next);
+    free(m);
+}
@@ -0,0 +1,298 @@
+/*
+ * astar.c - A* Search (goal-directed Dijkstra)
+ *
+ * Dijkstra grows a ball around the source in every direction. A* orders
+ * the heap by
+ *
+ *     f(v) = d(v) + h(v)
+ *
+ * where h(v) is a lower bound on the remaining distance v → target, so
+ * vertices "behind" the source are pushed back and the search heads for
+ * the target. With h = 0 it is exactly Dijkstra.
+ *
+ *   Dijkstra:   ●●●●●●●            A*:        ●●
+ *              ●●●●●●●●●                     ●●●●●
+ *              ●●●●s●●●●→ t                  ●s●●●●●→ t
+ *              ●●●●●●●●●                     ●●●●●
+ *               ●●●●●●●                       ●●
+ *
+ * Correctness needs h admissible (never larger than the true remaining
+ * distance). If h is also consistent, h(u) <= w(u, v) + h(v), every
+ * vertex is settled at most once; otherwise a vertex may be reopened,
+ * which the lazy-insertion heap handles by pushing it again.
+ *
+ * Heuristics:
+ *   Built-in ones compute scale * (straight-line or great-circle
+ *   distance) from the graph's coordinates. heuristic_scale() returns
+ *   the largest scale for which no edge is shorter than its heuristic
+ *   drop, which makes the heuristic consistent. Graphs without geometry
+ *   use landmark bounds instead (HEURISTIC_LANDMARKS, see landmarks.c).
+ *
+ * Specialization:
+ *   The search loop is written once as an always-inline function taking
+ *   the heuristic kind as a parameter. astar_search() calls it with a
+ *   compile-time constant for each built-in kind, so the compiler emits
+ *   one loop per heuristic with the formula inlined; only
+ *   HEURISTIC_CUSTOM pays an indirect call per relaxation.
+ */
+
+#include "workspace.h"
+#include "landmarks.h"
+#include <math.h>
+
+#if defined(__GNUC__)
+#define ASTAR_INLINE static inline __attribute__((always_inline))
+#else
+#define ASTAR_INLINE static inline
+#endif
+
+#define EARTH_RADIUS_METERS 6371008.8
+#define DEGREES_TO_RADIANS  (3.14159265358979323846 / 180.0)
+
+/*
+ * AStarTarget - Per-query constants of the built-in heuristics
+ */
+typedef struct AStarTarget {
+    double x;
+    double y;
+    double cos_lat;     /* Haversine only: cos(latitude of target) */
+    const int *to;      /* Landmarks only: the target's table rows */
+    const int *from;
+} AStarTarget;
+
+static inline double euclidean_distance(VertexCoord a, double x, double y) {
+    double dx = a.x - x;
+    double dy = a.y - y;
+    return sqrt(dx * dx + dy * dy);
+}
+
+/*
+ * haversine_meters - Great-circle distance; coordinates in degrees
+ */
+static inline double haversine_meters(VertexCoord a, double lon, double lat, double cos_lat) {
+    double dlat = (lat - a.y) * DEGREES_TO_RADIANS;
+    double dlon = (lon - a.x) * DEGREES_TO_RADIANS;
+    double s_lat = sin(dlat * 0.5);
+    double s_lon = sin(dlon * 0.5);
+    double h = s_lat * s_lat + cos(a.y * DEGREES_TO_RADIANS) * cos_lat * s_lon * s_lon;
+    if (h > 1.0) h = 1.0;
+    return 2.0 * EARTH_RADIUS_METERS * asin(sqrt(h));
+}
+
+/*
+ * heuristic_value - h(v) for the given kind, rounded down to an int
+ *
+ * Rounding down keeps an admissible (consistent) heuristic admissible
+ * (consistent) because edge weights are integers.
+ */
+ASTAR_INLINE int heuristic_value(HeuristicKind kind, const Heuristic *h,
+                                 const VertexCoord *coords, const AStarTarget *t,
+                                 vertex_t v, vertex_t target) {
+    double estimate;
+
+    switch (kind) {
+    case HEURISTIC_EUCLIDEAN:
+        estimate = h->scale * euclidean_distance(coords[v], t->x, t->y);
+        break;
+    case HEURISTIC_HAVERSINE:
+        estimate = h->scale * haversine_meters(coords[v], t->x, t->y, t->cos_lat);
+        break;
+    case HEURISTIC_CUSTOM:
+        return h->function(v, target, h->context);
+    case HEURISTIC_LANDMARKS: {
+        const LandmarkTable *table = (const LandmarkTable *)h->context;
+        size_t row = (size_t)v * (size_t)table->num_landmarks;
+        return landmark_bound(table, table->to + row, table->from + row, t->to, t->from);
+    }
+    default:
+        return 0;
+    }
+    return (estimate < (double)INT_MAX) ? (int)estimate : INT_MAX;
+}
+
+/*
+ * astar_key - f = d + h, saturated so it fits the heap's int keys
+ */
+static inline int astar_key(int distance, int estimate) {
+    int64_t f = (int64_t)distance + estimate;
+    return (f < INF) ? (int)f : INF;
+}
+
+/*
+ * astar_core - The A* loop, specialized per heuristic kind by inlining
+ */
+ASTAR_INLINE void astar_core(DijkstraWorkspace *ws, const CSRGraph *g,
+                             vertex_t source, vertex_t target,
+                             const Heuristic *h, HeuristicKind kind) {
+    const edge_t *offsets = g->offsets;
+    const vertex_t *destinations = g->destinations;
+    const int *weights = g->weights;
+    const VertexCoord *coords = g->coords;
+    DaryHeap *heap = &ws->heap;
+    DijkstraStats stats = {0};
+
+    AStarTarget t = { 0.0, 0.0, 0.0, NULL, NULL };
+    if (coords != NULL) {
+        t.x = coords[target].x;
+        t.y = coords[target].y;
+        t.cos_lat = cos(t.y * DEGREES_TO_RADIANS);
+    }
+    if (kind == HEURISTIC_LANDMARKS) {
+        const LandmarkTable *table = (const LandmarkTable *)h->context;
+        size_t row = (size_t)target * (size_t)table->num_landmarks;
+        t.to = table->to + row;
+        t.from = table->from + row;
+    }
+
+    ws_set(ws, source, 0, -1);
+    heap_push(heap, source, heuristic_value(kind, h, coords, &t, source, target));
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
+
+    while (!heap_empty(heap)) {
+        vertex_t u = heap_pop(heap).vertex;
+        stats.heap_pops++;
+        stats.vertices_settled++;
+        if (u == target) break;
+
+        int du = ws->distance[u];
+        edge_t end = offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - offsets[u]);
+        for (edge_t i = offsets[u]; i < end; i++) {
+            vertex_t v = destinations[i];
+            int candidate = dist_add(du, weights[i]);
+            if (candidate >= ws_distance(ws, v)) continue;
+
+            /* h = INF proves the target is unreachable from v: prune */
+            int estimate = heuristic_value(kind, h, coords, &t, v, target);
+            if (estimate == INF) continue;
+
+            ws_set(ws, v, candidate, u);
+            stats.relaxations++;
+            int key = astar_key(candidate, estimate);
+
+            if (heap_contains(heap, v)) {
+                heap_decrease_key(heap, v, key);
+                stats.heap_decrease_keys++;
+            } else {
+                /* First visit, or a settled vertex reopened (inconsistent h) */
+                heap_push(heap, v, key);
+                stats.heap_pushes++;
+                if ((uint64_t)heap->size > stats.max_heap_size) {
+                    stats.max_heap_size = (uint64_t)heap->size;
+                }
+            }
+        }
+    }
+
+    ws->stats = stats;
+}
+
+/*
+ * astar_search - A* point-to-point search into a reusable workspace
+ *
+ * @ws:     Workspace with capacity >= g->num_vertices
+ * @g:      Pointer to the CSR graph (with coords for built-in heuristics)
+ * @source: Starting vertex
+ * @target: Destination vertex; the search stops once it is settled
+ * @h:      Heuristic (NULL means HEURISTIC_ZERO)
+ *
+ * Time Complexity: O((T + E_T) log T) for the T vertices whose f value
+ *                  is below d(source, target); with a good heuristic T
+ *                  is a narrow corridor instead of a full ball
+ *
+ * Return: true on success; use workspace_distance(ws, target) and
+ *         workspace_path(ws, target) as with dijkstra_workspace_to()
+ */
+bool astar_search(DijkstraWorkspace *ws, const CSRGraph *g, vertex_t source,
+                  vertex_t target, const Heuristic *h) {
+    static const Heuristic zero = { HEURISTIC_ZERO, 0.0, NULL, NULL };
+
+    if (ws == NULL || g == NULL || source < 0 || source >= g->num_vertices ||
+        target < 0 || target >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to astar_search()\n");
+        return false;
+    }
+    if (g->num_vertices > ws->capacity) {
+        fprintf(stderr, "Error: Graph has %" PRIdVERTEX " vertices, workspace holds %"
+                PRIdVERTEX "\n", g->num_vertices, ws->capacity);
+        return false;
+    }
+    if (h == NULL) h = &zero;
+    if ((h->kind == HEURISTIC_EUCLIDEAN || h->kind == HEURISTIC_HAVERSINE) &&
+        g->coords == NULL) {
+        fprintf(stderr, "Error: astar_search() heuristic needs vertex coordinates\n");
+        return false;
+    }
+    if (h->kind == HEURISTIC_CUSTOM && h->function == NULL) {
+        fprintf(stderr, "Error: astar_search() custom heuristic has no function\n");
+        return false;
+    }
+    if (h->kind == HEURISTIC_LANDMARKS &&
+        (h->context == NULL ||
+         ((const LandmarkTable *)h->context)->num_vertices != g->num_vertices)) {
+        fprintf(stderr, "Error: astar_search() landmark table does not match the graph\n");
+        return false;
+    }
+
+    ws_begin_query(ws, source);
+
+    /* One specialized copy of the loop per heuristic */
+    switch (h->kind) {
+    case HEURISTIC_EUCLIDEAN:
+        astar_core(ws, g, source, target, h, HEURISTIC_EUCLIDEAN);
+        break;
+    case HEURISTIC_HAVERSINE:
+        astar_core(ws, g, source, target, h, HEURISTIC_HAVERSINE);
+        break;
+    case HEURISTIC_CUSTOM:
+        astar_core(ws, g, source, target, h, HEURISTIC_CUSTOM);
+        break;
+    case HEURISTIC_LANDMARKS:
+        astar_core(ws, g, source, target, h, HEURISTIC_LANDMARKS);
+        break;
+    default:
+        astar_core(ws, g, source, target, h, HEURISTIC_ZERO);
+        break;
+    }
+    return true;
+}
+
+/*
+ * heuristic_scale - Largest consistent scale for a built-in heuristic
+ *
+ * @g:    Graph with coordinates
+ * @kind: HEURISTIC_EUCLIDEAN or HEURISTIC_HAVERSINE
+ *
+ * scale = min over edges (u, v) of w(u, v) / dist(u, v), so that
+ * scale * dist(u, v) <= w(u, v) on every edge; with the triangle
+ * inequality of the metric this makes h consistent. A tiny safety
+ * margin absorbs floating-point rounding.
+ *
+ * Time Complexity: O(E)
+ *
+ * Return: Scale to put in Heuristic.scale (0 if there are no coordinates)
+ */
+double heuristic_scale(const CSRGraph *g, HeuristicKind kind) {
+    if (g == NULL || g->coords == NULL ||
+        (kind != HEURISTIC_EUCLIDEAN && kind != HEURISTIC_HAVERSINE)) {
+        return 0.0;
+    }
+
+    double scale = HUGE_VAL;
+    for (vertex_t u = 0; u < g->num_vertices; u++) {
+        VertexCoord a = g->coords[u];
+        for (edge_t i = g->offsets[u]; i < g->offsets[u + 1]; i++) {
+            VertexCoord b = g->coords[g->destinations[i]];
+            double d = (kind == HEURISTIC_EUCLIDEAN)
+                     ? euclidean_distance(a, b.x, b.y)
+                     : haversine_meters(a, b.x, b.y, cos(b.y * DEGREES_TO_RADIANS));
+            if (d > 0.0 && g->weights[i] / d < scale) {
+                scale = g->weights[i] / d;
+            }
+        }
+    }
+
+    if (scale == HUGE_VAL) return 0.0;
+    return scale * (1.0 - 1e-9);
+}
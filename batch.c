@@ -0,0 +1,353 @@
+/*
+ * batch.c - Batch Queries on a Work-Stealing Thread Pool
+ *
+ * Offline jobs (all-pairs tables, nightly reachability reports) run
+ * hundreds of thousands of independent queries on one graph. A
+ * QueryPool starts its worker threads once; each owns a reusable
+ * DijkstraWorkspace, and all of them read the same immutable CSRGraph,
+ * so nothing is shared for writing during a query.
+ *
+ * Work Stealing:
+ *   Query costs vary by orders of magnitude (a target next door vs. one
+ *   across the map), so a static split leaves threads idle. Instead each
+ *   worker gets a contiguous range of query indices:
+ *
+ *     worker 0: [begin ......... end)    takes small chunks from the front
+ *     worker 1: [begin .... end)
+ *                       ↑
+ *     an idle worker steals the back half of a busy worker's range
+ *
+ *   Owners and thieves touch opposite ends, and each range has its own
+ *   lock, so contention only happens when a range is nearly empty.
+ *   Stolen work becomes the thief's own range and can be stolen again.
+ *
+ * Scaling:
+ *   Queries never write shared memory, so throughput grows with the
+ *   number of cores until memory bandwidth saturates.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "workspace.h"
+#include "threads.h"
+#include <pthread.h>
+
+#define POOL_MAX_THREADS 256
+#define POOL_GRAIN       4     /* Queries an owner takes per lock */
+
+/*
+ * PoolWorker - One thread, its range of the current batch, its scratch memory
+ */
+typedef struct PoolWorker {
+    struct QueryPool *pool;
+    int id;
+    pthread_t thread;
+    pthread_mutex_t lock;     /* Guards begin / end */
+    size_t begin;
+    size_t end;
+    DijkstraWorkspace *ws;
+    BatchStats stats;
+} PoolWorker;
+
+/*
+ * QueryPool - Worker threads plus the batch they are working on
+ *
+ * Members:
+ *   graph:       Shared read-only graph
+ *   workers:     One entry per thread
+ *   lock:        Guards generation, active, shutdown
+ *   work_ready:  Signalled when a new batch (or shutdown) is posted
+ *   work_done:   Signalled when the last worker finishes a batch
+ *   generation:  Incremented per batch so workers can tell it is new
+ *   active:      Workers still running the current batch
+ *   queries ...: The current batch, read-only while it runs
+ */
+struct QueryPool {
+    const CSRGraph *graph;
+    int num_threads;
+    PoolWorker *workers;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    uint64_t generation;
+    int active;
+    bool shutdown;
+
+    const BatchQuery *queries;
+    int *distances;
+    BatchCallback callback;
+    void *context;
+};
+
+/*
+ * take_own - Takes up to POOL_GRAIN queries from the front of our range
+ */
+static bool take_own(PoolWorker *w, size_t *begin, size_t *end) {
+    bool found = false;
+    pthread_mutex_lock(&w->lock);
+    if (w->begin < w->end) {
+        *begin = w->begin;
+        *end = (w->end - w->begin > POOL_GRAIN) ? w->begin + POOL_GRAIN : w->end;
+        w->begin = *end;
+        found = true;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+/*
+ * steal - Moves the back half of some other worker's range into ours
+ *
+ * Return: false once every range is empty
+ */
+static bool steal(PoolWorker *self) {
+    QueryPool *pool = self->pool;
+
+    for (int k = 1; k < pool->num_threads; k++) {
+        PoolWorker *victim = &pool->workers[(self->id + k) % pool->num_threads];
+        size_t begin = 0, end = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->begin < victim->end) {
+            size_t half = (victim->end - victim->begin + 1) / 2;
+            end = victim->end;
+            begin = end - half;
+            victim->end = begin;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (begin < end) {
+            pthread_mutex_lock(&self->lock);
+            self->begin = begin;
+            self->end = end;
+            pthread_mutex_unlock(&self->lock);
+            self->stats.steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void add_stats(DijkstraStats *sum, const DijkstraStats *s) {
+    sum->vertices_settled += s->vertices_settled;
+    sum->edges_scanned += s->edges_scanned;
+    sum->relaxations += s->relaxations;
+    sum->heap_pushes += s->heap_pushes;
+    sum->heap_decrease_keys += s->heap_decrease_keys;
+    sum->heap_pops += s->heap_pops;
+    if (s->max_heap_size > sum->max_heap_size) sum->max_heap_size = s->max_heap_size;
+}
+
+/*
+ * run_queries - Answers queries until no worker has any left
+ */
+static void run_queries(PoolWorker *w) {
+    QueryPool *pool = w->pool;
+    size_t begin, end;
+
+    for (;;) {
+        if (!take_own(w, &begin, &end)) {
+            if (!steal(w)) return;
+            continue;
+        }
+
+        for (size_t i = begin; i < end; i++) {
+            const BatchQuery *q = &pool->queries[i];
+            if (q->target >= 0) {
+                dijkstra_workspace_to(w->ws, pool->graph, q->source, q->target);
+            } else {
+                dijkstra_workspace(w->ws, pool->graph, q->source);
+            }
+
+            if (pool->distances != NULL) {
+                pool->distances[i] = (q->target >= 0) ? ws_distance(w->ws, q->target) : INF;
+            }
+            if (pool->callback != NULL) {
+                pool->callback(q, i, w->id, w->ws, pool->context);
+            }
+            w->stats.queries++;
+            add_stats(&w->stats.work, &w->ws->stats);
+        }
+    }
+}
+
+/*
+ * pool_worker - Thread body: sleep until a batch is posted, run it, repeat
+ */
+static void *pool_worker(void *arg) {
+    PoolWorker *w = (PoolWorker *)arg;
+    QueryPool *pool = w->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_queries(w);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/*
+ * create_query_pool - Starts worker threads for batch queries on @g
+ *
+ * @g:           Graph shared by all workers; must not change while the
+ *               pool exists
+ * @num_threads: Worker threads (see thread_count())
+ *
+ * Each worker allocates one workspace of g->num_vertices entries, once.
+ *
+ * Return: Pool, or NULL on failure
+ *         Caller must call free_query_pool()!
+ */
+QueryPool *create_query_pool(const CSRGraph *g, int num_threads) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph in create_query_pool()\n");
+        return NULL;
+    }
+    num_threads = thread_count(num_threads, POOL_MAX_THREADS);
+
+    QueryPool *pool = (QueryPool *)calloc(1, sizeof(QueryPool));
+    if (pool == NULL) return NULL;
+    pool->workers = (PoolWorker *)calloc((size_t)num_threads, sizeof(PoolWorker));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->graph = g;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    /* num_threads counts the workers started so far, for cleanup on failure */
+    for (int t = 0; t < num_threads; t++) {
+        PoolWorker *w = &pool->workers[t];
+        w->pool = pool;
+        w->id = t;
+        w->ws = create_workspace(g->num_vertices);
+        pthread_mutex_init(&w->lock, NULL);
+        if (w->ws == NULL || pthread_create(&w->thread, NULL, pool_worker, w) != 0) {
+            fprintf(stderr, "Error: Failed to start query pool worker %d\n", t);
+            free_workspace(w->ws);
+            pthread_mutex_destroy(&w->lock);
+            free_query_pool(pool);
+            return NULL;
+        }
+        pool->num_threads = t + 1;
+    }
+    return pool;
+}
+
+/*
+ * run_batch - Answers a batch of queries on the pool's threads
+ *
+ * @pool:      Pool from create_query_pool()
+ * @queries:   Queries to answer
+ * @count:     Number of queries
+ * @distances: If non-NULL, distances[i] receives query i's distance to
+ *             its target (INF if unreachable or for a full search)
+ * @callback:  If non-NULL, called for every answered query (see
+ *             BatchCallback), e.g. to extract paths or full trees
+ * @context:   Passed to @callback
+ * @stats:     If non-NULL, receives the batch totals
+ *
+ * Blocks until the whole batch is done. Queries are answered in no
+ * particular order, but distances[i] always belongs to queries[i].
+ * One batch at a time per pool.
+ *
+ * Time Complexity: (sum of query costs) / threads, plus a few steals
+ *
+ * Return: true on success, false on invalid input (nothing is run)
+ */
+bool run_batch(QueryPool *pool, const BatchQuery *queries, size_t count, int *distances,
+               BatchCallback callback, void *context, BatchStats *stats) {
+    if (pool == NULL || (queries == NULL && count > 0)) {
+        fprintf(stderr, "Error: Invalid input to run_batch()\n");
+        return false;
+    }
+    vertex_t n = pool->graph->num_vertices;
+    for (size_t i = 0; i < count; i++) {
+        if (queries[i].source < 0 || queries[i].source >= n ||
+            queries[i].target < -1 || queries[i].target >= n) {
+            fprintf(stderr, "Error: Query %zu (%" PRIdVERTEX " → %" PRIdVERTEX
+                    ") is out of range\n", i, queries[i].source, queries[i].target);
+            return false;
+        }
+    }
+
+    /* Contiguous initial ranges; stealing evens out the costs */
+    int threads = pool->num_threads;
+    for (int t = 0; t < threads; t++) {
+        PoolWorker *w = &pool->workers[t];
+        pthread_mutex_lock(&w->lock);
+        w->begin = count * (size_t)t / (size_t)threads;
+        w->end = count * (size_t)(t + 1) / (size_t)threads;
+        pthread_mutex_unlock(&w->lock);
+        w->stats = (BatchStats){0};
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->queries = queries;
+    pool->distances = distances;
+    pool->callback = callback;
+    pool->context = context;
+    pool->active = threads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    while (pool->active > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (stats != NULL) {
+        *stats = (BatchStats){0};
+        for (int t = 0; t < threads; t++) {
+            stats->queries += pool->workers[t].stats.queries;
+            stats->steals += pool->workers[t].stats.steals;
+            add_stats(&stats->work, &pool->workers[t].stats.work);
+        }
+    }
+    return true;
+}
+
+/*
+ * query_pool_threads - Number of worker threads in @pool
+ */
+int query_pool_threads(const QueryPool *pool) {
+    return (pool != NULL) ? pool->num_threads : 0;
+}
+
+/*
+ * free_query_pool - Stops the workers and releases the pool
+ */
+void free_query_pool(QueryPool *pool) {
+    if (pool == NULL) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int t = 0; t < pool->num_threads; t++) {
+        pthread_join(pool->workers[t].thread, NULL);
+        pthread_mutex_destroy(&pool->workers[t].lock);
+        free_workspace(pool->workers[t].ws);
+    }
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
@@ -0,0 +1,1977 @@
+/*
+ * bench.c - Benchmarks for the Dijkstra Engines
+ *
+ * Build and run with:  make bench
+ *
+ * Heap benchmark:
+ *   Compares dijkstra_heap_csr() (indexed d-ary heap, see heap.h) against
+ *   the original pointer-based binary heap on random sparse graphs, where
+ *   heap operations dominate the running time. Both run on the same CSR
+ *   graph so that only the priority queue differs.
+ *
+ *   The arity is a compile-time choice; compare with e.g.
+ *     make clean && make bench HEAP_ARITY=8
+ *
+ * Integer queue benchmark:
+ *   dijkstra_heap_csr() vs dijkstra_dial() vs dijkstra_radix() on the
+ *   same graphs with small integer weights (travel-time-like).
+ *
+ * Workspace benchmark:
+ *   Local queries on a large graph: dijkstra_heap_csr() (O(V) setup per
+ *   query) vs dijkstra_workspace() (O(touched) per query).
+
+ *
+ * Bidirectional benchmark:
+ *   Random point-to-point queries on a road-like grid:
+ *   dijkstra_workspace_to() vs dijkstra_bidirectional().
+
+ *
+ * A* benchmark:
+ *   Random point-to-point queries on a geometric graph with coordinates:
+ *   dijkstra_workspace_to() vs astar_search() with the Euclidean bound.
+ *
+ * Generator benchmark:
+ *   generate_graph() and generate_graph_file() on every family at
+ *   ~2^24 edges, against building the same edges via an EdgeList.
+ *
+ * Hardware counter benchmark:
+ *   Cycles, instructions, branch / cache / TLB misses and page faults
+ *   per scanned edge for the single-threaded engines (perf_event_open;
+ *   n/a where the system has no counters).
+ *
+ * Engine suite (last; alone with --suite, see ENGINE SUITE below):
+ *   Every single-source engine on grid, G(n, m), R-MAT and road-like
+ *   graphs of growing size: wall time, settled vertices / s, scanned
+ *   edges / s and peak RSS, optionally written as CSV and JSON.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+/*============================================================================
+ * HELPERS
+ *===========================================================================*/
+
+/*
+ * now_ms - Monotonic clock in milliseconds
+ */
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/*
+ * rng_next - xorshift64* pseudo-random generator (deterministic per seed)
+ */
+static uint64_t rng_next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 2685821657736338717ULL;
+}
+
+/*
+ * random_sparse_graph - Random directed graph with n * degree edges
+ *
+ * A Hamiltonian cycle 0 → 1 → ... → n-1 → 0 is included so that every
+ * vertex is reachable and each query does the full amount of work.
+ */
+static CSRGraph *random_sparse_graph(vertex_t n, int degree, int max_weight, uint64_t seed) {
+    EdgeList edges;
+    edge_list_init(&edges);
+    uint64_t state = seed;
+
+    for (vertex_t u = 0; u < n; u++) {
+        bool ok = edge_list_append(&edges, u, (u + 1) % n,
+                                   1 + (int)(rng_next(&state) % (uint64_t)max_weight));
+        for (int k = 1; k < degree && ok; k++) {
+            vertex_t v = (vertex_t)(rng_next(&state) % (uint64_t)n);
+            ok = edge_list_append(&edges, u, v,
+                                  1 + (int)(rng_next(&state) % (uint64_t)max_weight));
+        }
+        if (!ok) {
+            edge_list_free(&edges);
+            return NULL;
+        }
+    }
+
+    CSRGraph *g = build_csr_graph(n, &edges, 1);
+    edge_list_free(&edges);
+    return g;
+}
+
+/*
+ * clustered_graph - n vertices in isolated clusters of @cluster vertices
+ *
+ * Each cluster is a random sparse graph of its own, so a query from any
+ * source touches exactly @cluster vertices no matter how large n is.
+ */
+static CSRGraph *clustered_graph(vertex_t n, vertex_t cluster, int degree, uint64_t seed) {
+    EdgeList edges;
+    edge_list_init(&edges);
+    uint64_t state = seed;
+
+    for (vertex_t u = 0; u < n; u++) {
+        vertex_t base = u - u % cluster;
+        vertex_t size = (base + cluster <= n) ? cluster : n - base;
+        bool ok = edge_list_append(&edges, u, base + (u - base + 1) % size,
+                                   1 + (int)(rng_next(&state) % 1000));
+        for (int k = 1; k < degree && ok; k++) {
+            vertex_t v = base + (vertex_t)(rng_next(&state) % (uint64_t)size);
+            ok = edge_list_append(&edges, u, v, 1 + (int)(rng_next(&state) % 1000));
+        }
+        if (!ok) {
+            edge_list_free(&edges);
+            return NULL;
+        }
+    }
+
+    CSRGraph *g = build_csr_graph(n, &edges, 1);
+    edge_list_free(&edges);
+    return g;
+}
+
+/*
+ * grid_graph - side x side grid, both directions, random weights 1..100
+ *
+ * A crude stand-in for a road network: planar, low degree, and long
+ * shortest paths.
+ */
+static CSRGraph *grid_graph(vertex_t side, uint64_t seed) {
+    EdgeList edges;
+    edge_list_init(&edges);
+    uint64_t state = seed;
+    bool ok = true;
+
+    for (vertex_t y = 0; y < side && ok; y++) {
+        for (vertex_t x = 0; x < side && ok; x++) {
+            vertex_t u = y * side + x;
+            if (x + 1 < side) {
+                int w = 1 + (int)(rng_next(&state) % 100);
+                ok = edge_list_append(&edges, u, u + 1, w) &&
+                     edge_list_append(&edges, u + 1, u, w);
+            }
+            if (ok && y + 1 < side) {
+                int w = 1 + (int)(rng_next(&state) % 100);
+                ok = edge_list_append(&edges, u, u + side, w) &&
+                     edge_list_append(&edges, u + side, u, w);
+            }
+        }
+    }
+
+    CSRGraph *g = ok ? build_csr_graph(side * side, &edges, 1) : NULL;
+    edge_list_free(&edges);
+    return g;
+}
+
+/*
+ * geometric_graph - Jittered side x side grid with diagonals and coordinates
+ *
+ * Weights are the Euclidean edge length times 10..13, like travel times
+ * on roads of varying speed, so the straight-line distance is a good
+ * lower bound.
+ */
+static CSRGraph *geometric_graph(vertex_t side, uint64_t seed) {
+    static const int dx[] = { 1, 0, 1, 1 };
+    static const int dy[] = { 0, 1, 1, -1 };
+    vertex_t n = side * side;
+    VertexCoord *coords = (VertexCoord *)malloc(((size_t)n + 1) * sizeof(VertexCoord));
+    EdgeList edges;
+    edge_list_init(&edges);
+    uint64_t state = seed;
+    bool ok = (coords != NULL);
+
+    for (vertex_t v = 0; v < n && ok; v++) {
+        coords[v].x = (double)(v % side) + (double)(rng_next(&state) % 600) / 1000.0;
+        coords[v].y = (double)(v / side) + (double)(rng_next(&state) % 600) / 1000.0;
+    }
+
+    for (vertex_t v = 0; v < n && ok; v++) {
+        vertex_t x = v % side, y = v / side;
+        for (int k = 0; k < 4 && ok; k++) {
+            vertex_t nx = x + dx[k], ny = y + dy[k];
+            if (nx >= side || ny < 0 || ny >= side) continue;
+            vertex_t u = ny * side + nx;
+            double ex = coords[u].x - coords[v].x, ey = coords[u].y - coords[v].y;
+            double slowdown = 10.0 + (double)(rng_next(&state) % 4);
+            int w = (int)ceil(sqrt(ex * ex + ey * ey) * slowdown);
+            ok = edge_list_append(&edges, v, u, w) && edge_list_append(&edges, u, v, w);
+        }
+    }
+
+    CSRGraph *g = ok ? build_csr_graph(n, &edges, 1) : NULL;
+    edge_list_free(&edges);
+    if (g == NULL) {
+        free(coords);
+        return NULL;
+    }
+    g->coords = coords;
+    return g;
+}
+
+/*============================================================================
+ * BASELINE: ORIGINAL POINTER-BASED BINARY HEAP
+ *
+ * Kept verbatim in spirit: one malloc'd node per vertex, all V vertices
+ * inserted up front, recursive heapify, swap-based sift-up.
+ *===========================================================================*/
+
+typedef struct LegacyHeapNode {
+    vertex_t vertex;
+    int distance;
+} LegacyHeapNode;
+
+typedef struct LegacyHeap {
+    vertex_t size;
+    vertex_t *position;
+    LegacyHeapNode **nodes;
+} LegacyHeap;
+
+static void legacy_swap(LegacyHeap *heap, vertex_t a, vertex_t b) {
+    LegacyHeapNode *temp = heap->nodes[a];
+    heap->nodes[a] = heap->nodes[b];
+    heap->nodes[b] = temp;
+    heap->position[heap->nodes[a]->vertex] = a;
+    heap->position[heap->nodes[b]->vertex] = b;
+}
+
+static void legacy_heapify(LegacyHeap *heap, vertex_t idx) {
+    vertex_t smallest = idx;
+    vertex_t left = 2 * idx + 1;
+    vertex_t right = 2 * idx + 2;
+
+    if (left < heap->size &&
+        heap->nodes[left]->distance < heap->nodes[smallest]->distance) {
+        smallest = left;
+    }
+    if (right < heap->size &&
+        heap->nodes[right]->distance < heap->nodes[smallest]->distance) {
+        smallest = right;
+    }
+    if (smallest != idx) {
+        legacy_swap(heap, smallest, idx);
+        legacy_heapify(heap, smallest);
+    }
+}
+
+static LegacyHeapNode *legacy_extract_min(LegacyHeap *heap) {
+    LegacyHeapNode *root = heap->nodes[0];
+    LegacyHeapNode *last = heap->nodes[heap->size - 1];
+
+    heap->nodes[0] = last;
+    heap->position[root->vertex] = heap->size - 1;
+    heap->position[last->vertex] = 0;
+    heap->size--;
+    legacy_heapify(heap, 0);
+    return root;
+}
+
+static void legacy_decrease_key(LegacyHeap *heap, vertex_t v, int dist) {
+    vertex_t i = heap->position[v];
+    heap->nodes[i]->distance = dist;
+    while (i > 0 && heap->nodes[i]->distance < heap->nodes[(i - 1) / 2]->distance) {
+        legacy_swap(heap, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/*
+ * legacy_dijkstra - dijkstra_heap() as it was before heap.h, on a CSR graph
+ *
+ * Return: Malloc'd distance array (caller frees), or NULL on failure
+ */
+static int *legacy_dijkstra(const CSRGraph *g, vertex_t source) {
+    vertex_t n = g->num_vertices;
+    int *distance = (int *)malloc((size_t)n * sizeof(int));
+    vertex_t *parent = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+    LegacyHeap heap;
+    heap.position = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+    heap.nodes = (LegacyHeapNode **)malloc((size_t)n * sizeof(LegacyHeapNode *));
+    LegacyHeapNode **extracted = (LegacyHeapNode **)malloc((size_t)n * sizeof(LegacyHeapNode *));
+    vertex_t num_extracted = 0;
+
+    if (distance == NULL || parent == NULL || heap.position == NULL ||
+        heap.nodes == NULL || extracted == NULL) {
+        free(distance);
+        free(parent);
+        free(heap.position);
+        free(heap.nodes);
+        free(extracted);
+        return NULL;
+    }
+
+    for (vertex_t v = 0; v < n; v++) {
+        distance[v] = INF;
+        parent[v] = -1;
+        heap.nodes[v] = (LegacyHeapNode *)malloc(sizeof(LegacyHeapNode));
+        heap.nodes[v]->vertex = v;
+        heap.nodes[v]->distance = INF;
+        heap.position[v] = v;
+    }
+    distance[source] = 0;
+    legacy_decrease_key(&heap, source, 0);
+    heap.size = n;
+
+    while (heap.size > 0) {
+        LegacyHeapNode *min_node = legacy_extract_min(&heap);
+        extracted[num_extracted++] = min_node;
+        vertex_t u = min_node->vertex;
+        if (distance[u] == INF) break;
+
+        for (edge_t i = g->offsets[u]; i < g->offsets[u + 1]; i++) {
+            vertex_t v = g->destinations[i];
+            if (heap.position[v] < heap.size &&
+                distance[u] + g->weights[i] < distance[v]) {
+                distance[v] = distance[u] + g->weights[i];
+                parent[v] = u;
+                legacy_decrease_key(&heap, v, distance[v]);
+            }
+        }
+    }
+
+    for (vertex_t i = 0; i < heap.size; i++) free(heap.nodes[i]);
+    for (vertex_t i = 0; i < num_extracted; i++) free(extracted[i]);
+    free(heap.nodes);
+    free(heap.position);
+    free(extracted);
+    free(parent);
+    return distance;
+}
+
+/*============================================================================
+ * BENCHMARKS
+ *===========================================================================*/
+
+/*
+ * bench_heap - Legacy binary heap vs indexed d-ary heap on sparse graphs
+ */
+static void bench_heap(void) {
+    static const vertex_t sizes[] = { 10000, 100000, 1000000 };
+    const int degree = 4;
+    const int queries = 5;
+
+    printf("\n");
+    printf("Heap benchmark: random sparse graphs, out-degree %d, %d queries each\n",
+           degree, queries);
+    printf("d-ary heap arity: %d\n\n", DIJKSTRA_HEAP_ARITY);
+    printf("  %10s  %10s  %14s  %14s  %8s\n",
+           "vertices", "edges", "binary (ms/q)", "d-ary (ms/q)", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        CSRGraph *g = random_sparse_graph(sizes[s], degree, 1000, 42 + s);
+        if (g == NULL) {
+            fprintf(stderr, "Error: Failed to generate benchmark graph\n");
+            return;
+        }
+
+        double legacy_ms = 0, dary_ms = 0;
+        bool match = true;
+        uint64_t state = 7;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t0 = now_ms();
+            int *expected = legacy_dijkstra(g, source);
+            double t1 = now_ms();
+            DijkstraResult *result = dijkstra_heap_csr(g, source);
+            double t2 = now_ms();
+
+            legacy_ms += t1 - t0;
+            dary_ms += t2 - t1;
+
+            if (expected == NULL || result == NULL) {
+                match = false;
+            } else {
+                for (vertex_t v = 0; v < g->num_vertices; v++) {
+                    if (expected[v] != result->distance[v]) match = false;
+                }
+            }
+            free(expected);
+            free_result(result);
+        }
+
+        printf("  %10" PRIdVERTEX "  %10" PRIdEDGE "  %14.2f  %14.2f  %7.2fx%s\n",
+               g->num_vertices, g->num_edges, legacy_ms / queries, dary_ms / queries,
+               legacy_ms / dary_ms, match ? "" : "  (MISMATCH!)");
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * time_engine - Runs one engine from several sources
+ *
+ * Return: Average milliseconds per query; *checksum gets the distance sum
+ */
+static double time_engine(DijkstraResult *(*engine)(const CSRGraph *, vertex_t),
+                          const CSRGraph *g, int queries, int64_t *checksum) {
+    uint64_t state = 11;
+    double total = 0;
+    *checksum = 0;
+
+    for (int q = 0; q < queries; q++) {
+        vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+        double t0 = now_ms();
+        DijkstraResult *result = engine(g, source);
+        total += now_ms() - t0;
+
+        if (result == NULL) {
+            *checksum = -1;
+            return 0;
+        }
+        for (vertex_t v = 0; v < result->num_vertices; v++) {
+            if (result->distance[v] != INF) *checksum += result->distance[v];
+        }
+        free_result(result);
+    }
+    return total / queries;
+}
+
+/*
+ * bench_integer_queues - d-ary heap vs Dial vs radix heap, small weights
+ */
+static void bench_integer_queues(void) {
+    static const int max_weights[] = { 10, 100, 10000 };
+    const vertex_t n = 1000000;
+    const int degree = 4;
+    const int queries = 3;
+
+    printf("\n");
+    printf("Integer queue benchmark: %" PRIdVERTEX " vertices, out-degree %d, %d queries each\n\n",
+           n, degree, queries);
+    printf("  %10s  %14s  %14s  %14s\n",
+           "max weight", "d-ary (ms/q)", "Dial (ms/q)", "radix (ms/q)");
+
+    for (size_t w = 0; w < sizeof(max_weights) / sizeof(max_weights[0]); w++) {
+        CSRGraph *g = random_sparse_graph(n, degree, max_weights[w], 99 + w);
+        if (g == NULL) {
+            fprintf(stderr, "Error: Failed to generate benchmark graph\n");
+            return;
+        }
+
+        int64_t sum_heap, sum_dial, sum_radix;
+        double heap_ms = time_engine(dijkstra_heap_csr, g, queries, &sum_heap);
+        double dial_ms = time_engine(dijkstra_dial, g, queries, &sum_dial);
+        double radix_ms = time_engine(dijkstra_radix, g, queries, &sum_radix);
+
+        printf("  %10d  %14.2f  %14.2f  %14.2f%s\n",
+               max_weights[w], heap_ms, dial_ms, radix_ms,
+               (sum_heap == sum_dial && sum_heap == sum_radix) ? "" : "  (MISMATCH!)");
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_workspace - Fresh result per query vs one reused workspace
+ */
+static void bench_workspace(void) {
+    static const vertex_t sizes[] = { 100000, 1000000, 10000000 };
+    const vertex_t cluster = 1000;
+    const int queries = 200;
+
+    printf("\n");
+    printf("Workspace benchmark: clusters of %" PRIdVERTEX " vertices, %d queries each\n\n",
+           cluster, queries);
+    printf("  %10s  %14s  %14s  %8s\n",
+           "vertices", "fresh (ms/q)", "reused (ms/q)", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        CSRGraph *g = clustered_graph(sizes[s], cluster, 4, 5 + s);
+        DijkstraWorkspace *ws = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        if (ws == NULL) {
+            fprintf(stderr, "Error: Failed to set up workspace benchmark\n");
+            free_csr_graph(g);
+            return;
+        }
+
+        double fresh_ms = 0, reused_ms = 0;
+        bool match = true;
+        uint64_t state = 3;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t0 = now_ms();
+            DijkstraResult *result = dijkstra_heap_csr(g, source);
+            double t1 = now_ms();
+            bool ok = dijkstra_workspace(ws, g, source);
+            double t2 = now_ms();
+
+            fresh_ms += t1 - t0;
+            reused_ms += t2 - t1;
+
+            if (result == NULL || !ok) {
+                match = false;
+            } else {
+                vertex_t base = source - source % cluster;
+                for (vertex_t v = base; v < base + cluster && v < g->num_vertices; v++) {
+                    if (result->distance[v] != workspace_distance(ws, v)) match = false;
+                }
+            }
+            free_result(result);
+        }
+
+        printf("  %10" PRIdVERTEX "  %14.3f  %14.3f  %7.1fx%s\n",
+               g->num_vertices, fresh_ms / queries, reused_ms / queries,
+               fresh_ms / reused_ms, match ? "" : "  (MISMATCH!)");
+        free_workspace(ws);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_bidirectional - Unidirectional vs bidirectional point-to-point
+ */
+static void bench_bidirectional(void) {
+    static const vertex_t sides[] = { 300, 1000 };
+    const int queries = 100;
+
+    printf("\n");
+    printf("Bidirectional benchmark: grid graphs, %d random s-t queries each\n\n", queries);
+    printf("  %10s  %12s  %12s  %12s  %12s  %8s\n", "vertices",
+           "uni settled", "bi settled", "uni (ms/q)", "bi (ms/q)", "speedup");
+
+    for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+        CSRGraph *g = grid_graph(sides[s], 17 + s);
+        DijkstraWorkspace *uni = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        DijkstraWorkspace *forward = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        DijkstraWorkspace *backward = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        if (uni == NULL || forward == NULL || backward == NULL || !build_reverse_graph(g)) {
+            fprintf(stderr, "Error: Failed to set up bidirectional benchmark\n");
+            free_workspace(uni);
+            free_workspace(forward);
+            free_workspace(backward);
+            free_csr_graph(g);
+            return;
+        }
+
+        double uni_ms = 0, bi_ms = 0;
+        uint64_t uni_settled = 0, bi_settled = 0;
+        bool match = true;
+        uint64_t state = 23;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+            vertex_t target = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t0 = now_ms();
+            bool ok = dijkstra_workspace_to(uni, g, source, target);
+            double t1 = now_ms();
+            ShortestPath *sp = dijkstra_bidirectional(forward, backward, g, source, target);
+            double t2 = now_ms();
+
+            uni_ms += t1 - t0;
+            bi_ms += t2 - t1;
+            if (!ok || sp == NULL || sp->distance != workspace_distance(uni, target)) {
+                match = false;
+            } else {
+                uni_settled += workspace_stats(uni)->vertices_settled;
+                bi_settled += sp->stats.vertices_settled;
+            }
+            free_shortest_path(sp);
+        }
+
+        printf("  %10" PRIdVERTEX "  %12.0f  %12.0f  %12.3f  %12.3f  %7.2fx%s\n",
+               g->num_vertices, (double)uni_settled / queries, (double)bi_settled / queries,
+               uni_ms / queries, bi_ms / queries, uni_ms / bi_ms,
+               match ? "" : "  (MISMATCH!)");
+        free_workspace(uni);
+        free_workspace(forward);
+        free_workspace(backward);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_astar - Dijkstra vs A* (Euclidean) on geometric graphs
+ */
+static void bench_astar(void) {
+    static const vertex_t sides[] = { 300, 1000 };
+    const int queries = 100;
+
+    printf("\n");
+    printf("A* benchmark: geometric graphs, %d random s-t queries each\n\n", queries);
+    printf("  %10s  %12s  %12s  %12s  %12s  %8s\n", "vertices",
+           "dij settled", "A* settled", "dij (ms/q)", "A* (ms/q)", "speedup");
+
+    for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+        CSRGraph *g = geometric_graph(sides[s], 31 + s);
+        DijkstraWorkspace *plain = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        DijkstraWorkspace *goal = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        if (plain == NULL || goal == NULL) {
+            fprintf(stderr, "Error: Failed to set up A* benchmark\n");
+            free_workspace(plain);
+            free_workspace(goal);
+            free_csr_graph(g);
+            return;
+        }
+
+        Heuristic h = { HEURISTIC_EUCLIDEAN, heuristic_scale(g, HEURISTIC_EUCLIDEAN), NULL, NULL };
+        double plain_ms = 0, goal_ms = 0;
+        uint64_t plain_settled = 0, goal_settled = 0;
+        bool match = true;
+        uint64_t state = 29;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+            vertex_t target = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t0 = now_ms();
+            bool ok = dijkstra_workspace_to(plain, g, source, target);
+            double t1 = now_ms();
+            ok = astar_search(goal, g, source, target, &h) && ok;
+            double t2 = now_ms();
+
+            plain_ms += t1 - t0;
+            goal_ms += t2 - t1;
+            if (!ok || workspace_distance(plain, target) != workspace_distance(goal, target)) {
+                match = false;
+            }
+            plain_settled += workspace_stats(plain)->vertices_settled;
+            goal_settled += workspace_stats(goal)->vertices_settled;
+        }
+
+        printf("  %10" PRIdVERTEX "  %12.0f  %12.0f  %12.3f  %12.3f  %7.2fx%s\n",
+               g->num_vertices, (double)plain_settled / queries, (double)goal_settled / queries,
+               plain_ms / queries, goal_ms / queries, plain_ms / goal_ms,
+               match ? "" : "  (MISMATCH!)");
+        free_workspace(plain);
+        free_workspace(goal);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_alt - Dijkstra vs ALT (16 landmarks, both strategies) on road-like grids
+ */
+static void bench_alt(void) {
+    static const LandmarkStrategy strategies[] = { LANDMARKS_FARTHEST, LANDMARKS_AVOID };
+    static const char *names[] = { "farthest", "avoid" };
+    const vertex_t side = 1000;
+    const int num_landmarks = 16;
+    const int queries = 100;
+
+    printf("\n");
+    printf("ALT benchmark: %" PRIdVERTEX " x %" PRIdVERTEX " grid, %d landmarks, "
+           "%d random s-t queries\n\n", side, side, num_landmarks, queries);
+    printf("  %10s  %10s  %12s  %12s  %12s  %12s  %8s\n", "strategy", "prep (ms)",
+           "dij settled", "ALT settled", "dij (ms/q)", "ALT (ms/q)", "speedup");
+
+    CSRGraph *g = grid_graph(side, 37);
+    DijkstraWorkspace *plain = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+    DijkstraWorkspace *goal = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+    if (plain == NULL || goal == NULL) {
+        fprintf(stderr, "Error: Failed to set up ALT benchmark\n");
+        free_workspace(plain);
+        free_workspace(goal);
+        free_csr_graph(g);
+        return;
+    }
+
+    for (size_t k = 0; k < sizeof(strategies) / sizeof(strategies[0]); k++) {
+        double t0 = now_ms();
+        LandmarkTable *table = build_landmarks(g, num_landmarks, strategies[k], 5);
+        double prep_ms = now_ms() - t0;
+        if (table == NULL) break;
+
+        double plain_ms = 0, goal_ms = 0;
+        uint64_t plain_settled = 0, goal_settled = 0;
+        bool match = true;
+        uint64_t state = 41;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+            vertex_t target = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t1 = now_ms();
+            bool ok = dijkstra_workspace_to(plain, g, source, target);
+            double t2 = now_ms();
+            ok = alt_search(goal, g, table, source, target) && ok;
+            double t3 = now_ms();
+
+            plain_ms += t2 - t1;
+            goal_ms += t3 - t2;
+            if (!ok || workspace_distance(plain, target) != workspace_distance(goal, target)) {
+                match = false;
+            }
+            plain_settled += workspace_stats(plain)->vertices_settled;
+            goal_settled += workspace_stats(goal)->vertices_settled;
+        }
+
+        printf("  %10s  %10.0f  %12.0f  %12.0f  %12.3f  %12.3f  %7.2fx%s\n", names[k],
+               prep_ms, (double)plain_settled / queries, (double)goal_settled / queries,
+               plain_ms / queries, goal_ms / queries, plain_ms / goal_ms,
+               match ? "" : "  (MISMATCH!)");
+        free_landmarks(table);
+    }
+
+    free_workspace(plain);
+    free_workspace(goal);
+    free_csr_graph(g);
+}
+
+/*
+ * bench_ch - Contraction Hierarchy preprocessing and query time on grids
+ */
+static void bench_ch(void) {
+    static const vertex_t sides[] = { 200, 400 };
+    const int queries = 1000;
+
+    printf("\n");
+    printf("Contraction Hierarchies: grids, %d random s-t queries each\n\n", queries);
+    printf("  %10s  %10s  %10s  %12s  %12s  %12s  %12s  %10s\n", "vertices", "prep (ms)",
+           "shortcuts", "bidi settled", "CH settled", "bidi (us/q)", "CH (us/q)", "speedup");
+
+    for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+        CSRGraph *g = grid_graph(sides[s], 43 + s);
+        DijkstraWorkspace *forward = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        DijkstraWorkspace *backward = (g != NULL) ? create_workspace(g->num_vertices) : NULL;
+        double t0 = now_ms();
+        ContractionHierarchy *ch = (backward != NULL) ? build_contraction_hierarchy(g, 0) : NULL;
+        double prep_ms = now_ms() - t0;
+        if (forward == NULL || ch == NULL || !build_reverse_graph(g)) {
+            fprintf(stderr, "Error: Failed to set up CH benchmark\n");
+            free_contraction_hierarchy(ch);
+            free_workspace(forward);
+            free_workspace(backward);
+            free_csr_graph(g);
+            return;
+        }
+
+        double bidi_ms = 0, ch_ms = 0;
+        uint64_t bidi_settled = 0, ch_settled = 0;
+        bool match = true;
+        uint64_t state = 47;
+
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+            vertex_t target = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+
+            double t1 = now_ms();
+            ShortestPath *expected = dijkstra_bidirectional(forward, backward, g, source, target);
+            double t2 = now_ms();
+            int distance = ch_distance(forward, backward, ch, source, target);
+            double t3 = now_ms();
+
+            bidi_ms += t2 - t1;
+            ch_ms += t3 - t2;
+            if (expected == NULL || expected->distance != distance) match = false;
+            if (expected != NULL) bidi_settled += expected->stats.vertices_settled;
+            ch_settled += workspace_stats(forward)->vertices_settled +
+                          workspace_stats(backward)->vertices_settled;
+            free_shortest_path(expected);
+        }
+
+        printf("  %10" PRIdVERTEX "  %10.0f  %10" PRIdEDGE "  %12.0f  %12.0f  %12.1f  %12.1f  "
+               "%9.0fx%s\n", g->num_vertices, prep_ms, ch->num_shortcuts,
+               (double)bidi_settled / queries, (double)ch_settled / queries,
+               1000.0 * bidi_ms / queries, 1000.0 * ch_ms / queries, bidi_ms / ch_ms,
+               match ? "" : "  (MISMATCH!)");
+        free_contraction_hierarchy(ch);
+        free_workspace(forward);
+        free_workspace(backward);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_multi - k dijkstra_heap() runs vs one dijkstra_multi() pass
+ */
+static void bench_multi(void) {
+    static const vertex_t counts[] = { 4, 32, 256 };
+    const vertex_t side = 300;
+
+    printf("\n");
+    printf("Multi-source benchmark: %" PRIdVERTEX " x %" PRIdVERTEX " grid (adjacency list)\n\n",
+           side, side);
+    printf("  %10s  %14s  %14s  %8s\n", "sources", "k runs (ms)", "multi (ms)", "speedup");
+
+    CSRGraph *csr = grid_graph(side, 53);
+    Graph *g = (csr != NULL) ? create_graph(csr->num_vertices) : NULL;
+    if (g == NULL) {
+        fprintf(stderr, "Error: Failed to set up multi-source benchmark\n");
+        free_csr_graph(csr);
+        return;
+    }
+    for (vertex_t u = 0; u < csr->num_vertices; u++) {
+        for (edge_t i = csr->offsets[u]; i < csr->offsets[u + 1]; i++) {
+            add_edge(g, u, csr->destinations[i], csr->weights[i]);
+        }
+    }
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        vertex_t k = counts[c];
+        vertex_t *sources = (vertex_t *)malloc((size_t)k * sizeof(vertex_t));
+        int *nearest = (int *)malloc((size_t)g->num_vertices * sizeof(int));
+        if (sources == NULL || nearest == NULL) {
+            free(sources);
+            free(nearest);
+            break;
+        }
+        uint64_t state = 59;
+        for (vertex_t i = 0; i < k; i++) {
+            sources[i] = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+        }
+        for (vertex_t v = 0; v < g->num_vertices; v++) nearest[v] = INF;
+
+        double t0 = now_ms();
+        for (vertex_t i = 0; i < k; i++) {
+            DijkstraResult *r = dijkstra_heap(g, sources[i]);
+            if (r == NULL) continue;
+            for (vertex_t v = 0; v < g->num_vertices; v++) {
+                if (r->distance[v] < nearest[v]) nearest[v] = r->distance[v];
+            }
+            free_result(r);
+        }
+        double t1 = now_ms();
+        DijkstraResult *multi = dijkstra_multi(g, sources, k);
+        double t2 = now_ms();
+
+        bool match = (multi != NULL);
+        for (vertex_t v = 0; match && v < g->num_vertices; v++) {
+            if (multi->distance[v] != nearest[v]) match = false;
+        }
+        printf("  %10" PRIdVERTEX "  %14.1f  %14.1f  %7.1fx%s\n", k, t1 - t0, t2 - t1,
+               (t1 - t0) / (t2 - t1), match ? "" : "  (MISMATCH!)");
+        free_result(multi);
+        free(sources);
+        free(nearest);
+    }
+
+    free_graph(g);
+    free_csr_graph(csr);
+}
+
+/*
+ * bench_batch - Query pool throughput for 1, 2, 4, ... threads
+ *
+ * Mixed batch: mostly s-t queries of random length plus some full
+ * searches, so costs are uneven and stealing has work to do.
+ */
+static void bench_batch(void) {
+    const vertex_t side = 200;
+    const size_t count = 1000;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    printf("\n");
+    printf("Batch query benchmark: %" PRIdVERTEX " x %" PRIdVERTEX " grid, %zu mixed queries, "
+           "%ld online CPU(s)\n\n", side, side, count, cpus);
+    printf("  %10s  %12s  %12s  %10s  %8s\n", "threads", "time (ms)", "queries/s",
+           "steals", "speedup");
+
+    CSRGraph *g = grid_graph(side, 61);
+    BatchQuery *queries = (BatchQuery *)malloc(count * sizeof(BatchQuery));
+    int *distances = (int *)malloc(count * sizeof(int));
+    int *reference = (int *)malloc(count * sizeof(int));
+    if (g == NULL || queries == NULL || distances == NULL || reference == NULL) {
+        fprintf(stderr, "Error: Failed to set up batch benchmark\n");
+        free(queries);
+        free(distances);
+        free(reference);
+        free_csr_graph(g);
+        return;
+    }
+
+    uint64_t state = 67;
+    for (size_t i = 0; i < count; i++) {
+        queries[i].source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+        queries[i].target = (i % 50 == 0) ? -1
+                          : (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+    }
+
+    double base_ms = 0;
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        QueryPool *pool = create_query_pool(g, threads);
+        if (pool == NULL) break;
+
+        BatchStats stats;
+        double t0 = now_ms();
+        bool ok = run_batch(pool, queries, count, distances, NULL, NULL, &stats);
+        double ms = now_ms() - t0;
+        free_query_pool(pool);
+        if (!ok) break;
+
+        bool match = true;
+        if (threads == 1) {
+            base_ms = ms;
+            for (size_t i = 0; i < count; i++) reference[i] = distances[i];
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                if (distances[i] != reference[i]) match = false;
+            }
+        }
+        printf("  %10d  %12.1f  %12.0f  %10" PRIu64 "  %7.2fx%s\n", threads, ms,
+               1000.0 * (double)count / ms, stats.steals, base_ms / ms,
+               match ? "" : "  (MISMATCH!)");
+    }
+
+    free(queries);
+    free(distances);
+    free(reference);
+    free_csr_graph(g);
+}
+
+/*
+ * bench_apsp - All-pairs tables on dense graphs: V heap runs vs Floyd–Warshall
+ *
+ * Every vertex has n / 4 out-edges. Floyd–Warshall runs once on one
+ * thread and once on every online CPU.
+ */
+static void bench_apsp(void) {
+    static const vertex_t sizes[] = { 256, 512, 1024 };
+
+    printf("\n");
+    printf("All-pairs benchmark: dense random graphs (degree V/4)\n\n");
+    printf("  %10s  %14s  %14s  %14s  %8s\n", "vertices", "V x heap (ms)", "FW 1 thr (ms)",
+           "FW all (ms)", "speedup");
+
+    for (size_t c = 0; c < sizeof(sizes) / sizeof(sizes[0]); c++) {
+        vertex_t n = sizes[c];
+        CSRGraph *g = random_sparse_graph(n, (int)(n / 4), 1000, 71 + (uint64_t)n);
+        if (g == NULL) break;
+
+        double t0 = now_ms();
+        DistanceMatrix *serial = floyd_warshall(g, 1);
+        double t1 = now_ms();
+        DistanceMatrix *m = floyd_warshall(g, 0);
+        double t2 = now_ms();
+
+        bool match = (serial != NULL && m != NULL);
+        double t3 = now_ms();
+        for (vertex_t s = 0; s < n; s++) {
+            DijkstraResult *r = dijkstra_heap_csr(g, s);
+            if (r == NULL) {
+                match = false;
+                continue;
+            }
+            for (vertex_t t = 0; match && t < n; t++) {
+                if (r->distance[t] != apsp_distance(m, s, t) ||
+                    r->distance[t] != apsp_distance(serial, s, t)) {
+                    match = false;
+                }
+            }
+            free_result(r);
+        }
+        double t4 = now_ms();
+
+        printf("  %10" PRIdVERTEX "  %14.1f  %14.1f  %14.1f  %7.1fx%s\n", n, t4 - t3, t1 - t0,
+               t2 - t1, (t4 - t3) / (t2 - t1), match ? "" : "  (MISMATCH!)");
+        free_distance_matrix(serial);
+        free_distance_matrix(m);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_delta - One large single-source search: dijkstra_heap_csr() vs
+ *               dijkstra_delta() on 1, 2, 4, 8 threads
+ *
+ * A road-like grid (long paths, many small buckets) and a random graph
+ * (short paths, few big buckets), both with 10^6 vertices.
+ */
+static void bench_delta(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    printf("\n");
+    printf("Delta-stepping benchmark: 10^6 vertices, full single-source search, "
+           "%ld online CPU(s)\n\n", cpus);
+    printf("  %-8s  %10s  %8s  %12s  %14s  %8s\n", "graph", "engine", "threads",
+           "time (ms)", "relaxations", "speedup");
+
+    for (int kind = 0; kind < 2; kind++) {
+        const char *name = (kind == 0) ? "grid" : "random";
+        CSRGraph *g = (kind == 0) ? grid_graph(1000, 73)
+                                  : random_sparse_graph(1000000, 8, 100, 79);
+        if (g == NULL) break;
+
+        double t0 = now_ms();
+        DijkstraResult *expected = dijkstra_heap_csr(g, 0);
+        double heap_ms = now_ms() - t0;
+        if (expected == NULL) {
+            free_csr_graph(g);
+            break;
+        }
+        printf("  %-8s  %10s  %8d  %12.1f  %14" PRIu64 "  %7.2fx\n", name, "heap", 1,
+               heap_ms, expected->stats.relaxations, 1.0);
+
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            t0 = now_ms();
+            DijkstraResult *r = dijkstra_delta(g, 0, 0, threads);
+            double ms = now_ms() - t0;
+            if (r == NULL) break;
+
+            bool match = true;
+            for (vertex_t v = 0; v < g->num_vertices; v++) {
+                if (r->distance[v] != expected->distance[v]) match = false;
+            }
+            printf("  %-8s  %10s  %8d  %12.1f  %14" PRIu64 "  %7.2fx%s\n", name, "delta",
+                   threads, ms, r->stats.relaxations, heap_ms / ms,
+                   match ? "" : "  (MISMATCH!)");
+            free_result(r);
+        }
+        free_result(expected);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_dense - O(V²) engines on dense graphs: linked lists vs heap vs
+ *               dense weight matrix
+ *
+ * Every vertex has V/2 random out-edges. Times are per query, averaged
+ * over 20 sources; the matrix is built once, outside the timing.
+ */
+static void bench_dense(void) {
+    static const vertex_t sizes[] = { 500, 1000, 2000 };
+    const int queries = 20;
+
+    printf("\n");
+    printf("Dense graph benchmark: degree V/2, ms per single-source query\n\n");
+    printf("  %10s  %12s  %12s  %12s  %12s  %10s\n", "vertices", "matrix (ms)", "dijkstra",
+           "heap", "dense", "vs best");
+
+    for (size_t c = 0; c < sizeof(sizes) / sizeof(sizes[0]); c++) {
+        vertex_t n = sizes[c];
+        Graph *g = create_graph(n);
+        uint64_t state = 83 + (uint64_t)n;
+        for (vertex_t u = 0; g != NULL && u < n; u++) {
+            for (vertex_t k = 0; k < n / 2; k++) {
+                add_edge(g, u, (vertex_t)(rng_next(&state) % (uint64_t)n),
+                         1 + (int)(rng_next(&state) % 1000));
+            }
+        }
+        if (g == NULL) break;
+
+        double t0 = now_ms();
+        bool ok = build_weight_matrix(g);
+        double build_ms = now_ms() - t0;
+        if (!ok) {
+            free_graph(g);
+            break;
+        }
+
+        DijkstraResult *(*engines[3])(Graph *, vertex_t) = {
+            dijkstra, dijkstra_heap, dijkstra_dense
+        };
+        double ms[3] = { 0, 0, 0 };
+        bool match = true;
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)n);
+            DijkstraResult *r[3];
+            for (int e = 0; e < 3; e++) {
+                t0 = now_ms();
+                r[e] = engines[e](g, source);
+                ms[e] += now_ms() - t0;
+            }
+            for (vertex_t v = 0; v < n; v++) {
+                if (r[0] == NULL || r[1] == NULL || r[2] == NULL ||
+                    r[2]->distance[v] != r[0]->distance[v] ||
+                    r[1]->distance[v] != r[0]->distance[v]) {
+                    match = false;
+                    break;
+                }
+            }
+            for (int e = 0; e < 3; e++) free_result(r[e]);
+        }
+
+        double best = (ms[0] < ms[1]) ? ms[0] : ms[1];
+        printf("  %10" PRIdVERTEX "  %12.1f  %12.3f  %12.3f  %12.3f  %9.1fx%s\n", n, build_ms,
+               ms[0] / queries, ms[1] / queries, ms[2] / queries, best / ms[2],
+               match ? "" : "  (MISMATCH!)");
+        free_graph(g);
+    }
+}
+
+/*
+ * bench_typed - The heap engine across weight / distance types
+ *
+ * Same graphs and sources for every type; weights are 1..100 so all
+ * types hold them. "weights" is the size of the weight array each
+ * engine streams through.
+ */
+static void bench_typed(void) {
+    const int queries = 5;
+
+    printf("\n");
+    printf("Typed engine benchmark: ms per single-source query\n\n");
+    printf("  %-8s  %-22s  %12s  %10s  %10s\n", "graph", "weight / distance", "weights (MB)",
+           "ms", "vs int");
+
+    for (int c = 0; c < 2; c++) {
+        CSRGraph *g = (c == 0) ? grid_graph(1000, 5) : random_sparse_graph(1000000, 4, 100, 5);
+        const char *name = (c == 0) ? "grid" : "random";
+        if (g == NULL) break;
+        CSRGraph_u16 *g16 = typed_graph_u16(g, NULL);
+        CSRGraph_u32 *g32 = typed_graph_u32(g, NULL);
+        CSRGraph_f32 *gf = typed_graph_f32(g, NULL);
+        if (g16 == NULL || g32 == NULL || gf == NULL) {
+            free_typed_graph_u16(g16);
+            free_typed_graph_u32(g32);
+            free_typed_graph_f32(gf);
+            free_csr_graph(g);
+            break;
+        }
+
+        double ms[4] = { 0, 0, 0, 0 };
+        bool match[4] = { true, true, true, true };
+        uint64_t state = 29;
+        for (int q = 0; q < queries; q++) {
+            vertex_t source = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+            double t0 = now_ms();
+            DijkstraResult *r = dijkstra_heap_csr(g, source);
+            ms[0] += now_ms() - t0;
+            t0 = now_ms();
+            DijkstraResult_u16 *r16 = dijkstra_heap_u16(g16, source);
+            ms[1] += now_ms() - t0;
+            t0 = now_ms();
+            DijkstraResult_u32 *r32 = dijkstra_heap_u32(g32, source);
+            ms[2] += now_ms() - t0;
+            t0 = now_ms();
+            DijkstraResult_f32 *rf = dijkstra_heap_f32(gf, source);
+            ms[3] += now_ms() - t0;
+
+            for (vertex_t v = 0; v < g->num_vertices; v++) {
+                if (r == NULL || r->distance[v] == INF) continue;
+                if (r16 == NULL || r16->distance[v] != (uint32_t)r->distance[v]) match[1] = false;
+                if (r32 == NULL || r32->distance[v] != (uint64_t)r->distance[v]) match[2] = false;
+                if (rf == NULL || rf->distance[v] != (double)r->distance[v]) match[3] = false;
+            }
+            free_result(r);
+            free_result_u16(r16);
+            free_result_u32(r32);
+            free_result_f32(rf);
+        }
+
+        static const char *const labels[4] = {
+            "int / int", "uint16_t / uint32_t", "uint32_t / uint64_t", "float / double"
+        };
+        static const size_t weight_bytes[4] = { sizeof(int), 2, 4, 4 };
+        for (int e = 0; e < 4; e++) {
+            printf("  %-8s  %-22s  %12.1f  %10.1f  %9.2fx%s\n", name, labels[e],
+                   (double)g->num_edges * (double)weight_bytes[e] / 1e6, ms[e] / queries,
+                   ms[0] / ms[e], match[e] ? "" : "  (MISMATCH!)");
+        }
+        free_typed_graph_u16(g16);
+        free_typed_graph_u32(g32);
+        free_typed_graph_f32(gf);
+        free_csr_graph(g);
+    }
+}
+
+/*
+ * bench_graph_build - Building and freeing an adjacency-list Graph
+ *
+ * "malloc per edge" replays the allocator pattern of the old add_edge()
+ * / free_graph() (one malloc and one free per Edge node) as a baseline
+ * for the arena-backed add_edge() and the bulk add_edges().
+ */
+static void bench_graph_build(void) {
+    const vertex_t n = 1000000;
+    const edge_t m = 10000000;
+
+    vertex_t *src = (vertex_t *)malloc((size_t)m * sizeof(vertex_t));
+    vertex_t *dst = (vertex_t *)malloc((size_t)m * sizeof(vertex_t));
+    int *w = (int *)malloc((size_t)m * sizeof(int));
+    if (src == NULL || dst == NULL || w == NULL) {
+        free(src);
+        free(dst);
+        free(w);
+        return;
+    }
+    uint64_t state = 47;
+    for (edge_t i = 0; i < m; i++) {
+        src[i] = (vertex_t)(rng_next(&state) % (uint64_t)n);
+        dst[i] = (vertex_t)(rng_next(&state) % (uint64_t)n);
+        w[i] = 1 + (int)(rng_next(&state) % 1000);
+    }
+
+    printf("\n");
+    printf("Graph build benchmark: %" PRIdVERTEX " vertices, %" PRIdEDGE " edges\n\n", n, m);
+    printf("  %-16s  %10s  %10s  %10s\n", "method", "build (ms)", "free (ms)", "vs malloc");
+
+    /* Arena first: freeing 10M small chunks leaves work for the next malloc() */
+    double build[2] = { 0, 0 }, teardown[2] = { 0, 0 };
+    bool match[2] = { false, false };
+    for (int method = 0; method < 2; method++) {
+        double t0 = now_ms();
+        Graph *g = create_graph(n);
+        if (g == NULL) break;
+        if (method == 0) {
+            for (edge_t i = 0; i < m; i++) add_edge(g, src[i], dst[i], w[i]);
+        } else {
+            add_edges(g, src, dst, w, m);
+        }
+        build[method] = now_ms() - t0;
+        match[method] = (g->num_edges == m);
+        t0 = now_ms();
+        free_graph(g);
+        teardown[method] = now_ms() - t0;
+    }
+
+    /* Baseline: one malloc / free per edge node */
+    double t0 = now_ms();
+    Edge **lists = (Edge **)calloc((size_t)n, sizeof(Edge *));
+    for (edge_t i = 0; lists != NULL && i < m; i++) {
+        Edge *e = (Edge *)malloc(sizeof(Edge));
+        if (e == NULL) break;
+        e->destination = dst[i];
+        e->weight = w[i];
+        e->next = lists[src[i]];
+        lists[src[i]] = e;
+    }
+    double base_build = now_ms() - t0;
+    t0 = now_ms();
+    for (vertex_t v = 0; lists != NULL && v < n; v++) {
+        for (Edge *e = lists[v]; e != NULL;) {
+            Edge *next = e->next;
+            free(e);
+            e = next;
+        }
+    }
+    free(lists);
+    double base_free = now_ms() - t0;
+
+    printf("  %-16s  %10.1f  %10.1f  %9.2fx\n", "malloc per edge", base_build, base_free, 1.0);
+    for (int method = 0; method < 2; method++) {
+        printf("  %-16s  %10.1f  %10.1f  %9.2fx%s\n", (method == 0) ? "add_edge" : "add_edges",
+               build[method], teardown[method],
+               (base_build + base_free) / (build[method] + teardown[method]),
+               match[method] ? "" : "  (MISMATCH!)");
+    }
+
+    free(src);
+    free(dst);
+    free(w);
+}
+
+/*
+ * bench_dynamic - Repairing a cached result vs rerunning dijkstra_heap()
+ *
+ * A 500x500 grid road network (Graph, both directions) gets batches of
+ * random weight changes, each edge made up to 2x lighter or heavier,
+ * at 0.01%, 0.1% and 1% of the edges per batch.
+ */
+static void bench_dynamic(void) {
+    const vertex_t side = 500;
+    const vertex_t n = side * side;
+    const int batches = 10;
+
+    Graph *g = create_graph(n);
+    if (g == NULL) return;
+    uint64_t state = 61;
+    for (vertex_t v = 0; v < n; v++) {
+        vertex_t x = v % side, y = v / side;
+        int w = 1 + (int)(rng_next(&state) % 100);
+        if (x + 1 < side) add_undirected_edge(g, v, v + 1, w);
+        w = 1 + (int)(rng_next(&state) % 100);
+        if (y + 1 < side) add_undirected_edge(g, v, v + side, w);
+    }
+
+    /* Edge handles, found by walking the lists */
+    EdgeChange *edges = (EdgeChange *)malloc((size_t)g->num_edges * sizeof(EdgeChange));
+    EdgeChange *changes = (EdgeChange *)malloc((size_t)g->num_edges * sizeof(EdgeChange));
+    TreeRepair *repair = create_tree_repair(g);
+    DijkstraResult *cached = dijkstra_heap(g, 0);
+    if (edges == NULL || changes == NULL || repair == NULL || cached == NULL) {
+        free(edges);
+        free(changes);
+        free_tree_repair(repair);
+        free_result(cached);
+        free_graph(g);
+        return;
+    }
+    edge_t m = 0;
+    for (vertex_t u = 0; u < n; u++) {
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            edges[m].source = u;
+            edges[m].edge = edge;
+            m++;
+        }
+    }
+
+    printf("\n");
+    printf("Dynamic update benchmark: %" PRIdVERTEX "x%" PRIdVERTEX " grid, %" PRIdEDGE
+           " edges, ms per batch\n\n", side, side, m);
+    printf("  %10s  %12s  %12s  %14s  %10s\n", "changed", "rerun (ms)", "repair (ms)",
+           "repair settled", "speedup");
+
+    static const double fractions[] = { 0.0001, 0.001, 0.01 };
+    for (size_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); f++) {
+        size_t k = (size_t)((double)m * fractions[f]);
+        double rerun_ms = 0, repair_ms = 0;
+        uint64_t settled = 0;
+        bool match = true;
+        for (int b = 0; b < batches; b++) {
+            for (size_t i = 0; i < k; i++) {
+                changes[i] = edges[rng_next(&state) % (uint64_t)m];
+                int w = changes[i].edge->weight;
+                int new_w = (rng_next(&state) & 1) ? w * 2 : w / 2 + 1;
+                update_edge_weight(g, changes[i].source, changes[i].edge, new_w);
+            }
+
+            double t0 = now_ms();
+            DijkstraResult *fresh = dijkstra_heap(g, 0);
+            rerun_ms += now_ms() - t0;
+            t0 = now_ms();
+            if (!repair_result(repair, cached, changes, k)) match = false;
+            repair_ms += now_ms() - t0;
+            settled += cached->stats.vertices_settled;
+
+            for (vertex_t v = 0; fresh != NULL && v < n; v++) {
+                if (fresh->distance[v] != cached->distance[v]) match = false;
+            }
+            if (fresh == NULL) match = false;
+            free_result(fresh);
+        }
+        printf("  %9.2f%%  %12.2f  %12.2f  %14" PRIu64 "  %9.1fx%s\n", fractions[f] * 100,
+               rerun_ms / batches, repair_ms / batches, settled / (uint64_t)batches,
+               rerun_ms / repair_ms, match ? "" : "  (MISMATCH!)");
+    }
+
+    free(edges);
+    free(changes);
+    free_tree_repair(repair);
+    free_result(cached);
+    free_graph(g);
+}
+
+/*
+ * bench_paths - 10k paths out of one shortest-path tree
+ *
+ * get_path() per destination (a malloc and two walks each) against
+ * measure_paths() + extract_paths() into preallocated buffers, with a
+ * cold depth memo and again with the memo kept from the first batch.
+ */
+static void bench_paths(void) {
+    const size_t count = 10000;
+
+    CSRGraph *g = grid_graph(1000, 9);
+    DijkstraResult *r = (g != NULL) ? dijkstra_heap_csr(g, 0) : NULL;
+    vertex_t *targets = (vertex_t *)malloc(count * sizeof(vertex_t));
+    vertex_t *depth = (g != NULL) ? (vertex_t *)malloc((size_t)g->num_vertices * sizeof(vertex_t)) : NULL;
+    edge_t *offsets = (edge_t *)malloc((count + 1) * sizeof(edge_t));
+    if (r == NULL || targets == NULL || depth == NULL || offsets == NULL) {
+        free(targets);
+        free(depth);
+        free(offsets);
+        free_result(r);
+        free_csr_graph(g);
+        return;
+    }
+    uint64_t state = 71;
+    for (size_t i = 0; i < count; i++) {
+        targets[i] = (vertex_t)(rng_next(&state) % (uint64_t)g->num_vertices);
+    }
+
+    printf("\n");
+    printf("Path extraction benchmark: 1000x1000 grid, %zu destinations\n\n", count);
+    printf("  %-24s  %10s  %12s  %8s\n", "method", "ms", "entries", "mallocs");
+
+    double t0 = now_ms();
+    edge_t entries = 0;
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < count; i++) {
+        vertex_t length;
+        vertex_t *path = get_path(r, targets[i], &length);
+        entries += length;
+        if (length > 0) checksum += (uint64_t)path[length / 2];
+        free(path);
+    }
+    printf("  %-24s  %10.2f  %12" PRIdEDGE "  %8zu\n", "get_path() each", now_ms() - t0,
+           entries, count);
+
+    vertex_t *vertices = (vertex_t *)malloc(((size_t)entries + 1) * sizeof(vertex_t));
+    for (int pass = 0; vertices != NULL && pass < 2; pass++) {
+        if (pass == 0) {
+            for (vertex_t v = 0; v < g->num_vertices; v++) depth[v] = -1;
+        }
+        t0 = now_ms();
+        edge_t total = measure_paths(r, targets, count, depth, offsets);
+        bool ok = (total == entries) &&
+                  extract_paths(r, g, targets, count, depth, offsets, vertices, NULL, NULL);
+        double ms = now_ms() - t0;
+
+        uint64_t sum = 0;
+        for (size_t i = 0; ok && i < count; i++) {
+            edge_t length = offsets[i + 1] - offsets[i];
+            if (length > 0) sum += (uint64_t)vertices[offsets[i] + length / 2];
+        }
+        printf("  %-24s  %10.2f  %12" PRIdEDGE "  %8d%s\n",
+               (pass == 0) ? "batch, cold depth memo" : "batch, warm depth memo", ms, total, 0,
+               (ok && sum == checksum) ? "" : "  (MISMATCH!)");
+    }
+
+    free(vertices);
+    free(targets);
+    free(depth);
+    free(offsets);
+    free_result(r);
+    free_csr_graph(g);
+}
+
+/*============================================================================
+ * ENGINE SUITE
+ *
+ * Every single-source engine on four graph families at three sizes,
+ * with throughput and memory figures, optionally saved as CSV / JSON so
+ * that runs can be compared over time:
+ *
+ *   make bench-suite   (= ./dijkstra_bench --suite --csv bench_suite.csv
+ *                                           --json bench_suite.json)
+ *
+ * Families (n = 2^14, 2^17, 2^20 vertices; --quick: 2^12, 2^15):
+ *   grid   sqrt(n) x sqrt(n) grid, both directions, weights 1..100
+ *   gnm    erdos_renyi_spec(): G(n, m), m = 4n edges, weights 1..100
+ *   rmat   rmat_spec(): R-MAT power-law graph, m = 4n, weights 1..100
+ *   road   geometric_graph(): jittered grid with diagonals
+ *
+ * Each engine answers the same sources and is checked against
+ * dijkstra_heap_csr(); if that reference fails, the rest of the graph is
+ * skipped, and a failed engine's timings are left empty (CSV) or null
+ * (JSON). Peak RSS is reset before each engine, so it is the high-water
+ * mark during that engine's queries (graphs included).
+ *===========================================================================*/
+
+#define SUITE_QUERIES 3
+
+/*
+ * reset_peak_rss / peak_rss_mb - High-water mark of the resident set
+ *
+ * Writing "5" to /proc/self/clear_refs resets VmHWM (Linux 4.0+). Where
+ * that is unavailable, the process-wide peak from getrusage() is used.
+ */
+static void reset_peak_rss(void) {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f == NULL) return;
+    fputs("5", f);
+    fclose(f);
+}
+
+static double peak_rss_mb(void) {
+    char line[256];
+    long kb = -1;
+    FILE *f = fopen("/proc/self/status", "r");
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+    }
+    if (f != NULL) fclose(f);
+
+    if (kb < 0) {
+        struct rusage usage;
+        kb = (getrusage(RUSAGE_SELF, &usage) == 0) ? usage.ru_maxrss : 0;
+    }
+    return (double)kb / 1024.0;
+}
+
+typedef enum SuiteEngine {
+    ENGINE_HEAP_CSR,
+    ENGINE_HEAP_LISTS,
+    ENGINE_ARRAY_CSR,
+    ENGINE_DIAL,
+    ENGINE_RADIX,
+    ENGINE_WORKSPACE,
+    ENGINE_HEAP_U32,
+    ENGINE_DELTA,
+    NUM_SUITE_ENGINES
+} SuiteEngine;
+
+static const char *const suite_engine_names[NUM_SUITE_ENGINES] = {
+    "heap_csr", "heap_lists", "array_csr", "dial", "radix", "workspace", "heap_u32", "delta"
+};
+
+/*
+ * SuiteGraph - One test graph in every representation the engines need
+ */
+typedef struct SuiteGraph {
+    CSRGraph *csr;
+    Graph *lists;
+    CSRGraph_u32 *typed;
+    DijkstraWorkspace *ws;
+} SuiteGraph;
+
+static void free_suite_graph(SuiteGraph *sg) {
+    free_workspace(sg->ws);
+    free_typed_graph_u32(sg->typed);
+    free_graph(sg->lists);
+    free_csr_graph(sg->csr);
+}
+
+/*
+ * suite_graph - Wraps @csr with an adjacency-list copy, typed weights
+ *               and a workspace
+ */
+static bool suite_graph(SuiteGraph *sg, CSRGraph *csr) {
+    sg->csr = csr;
+    sg->lists = NULL;
+    sg->typed = NULL;
+    sg->ws = NULL;
+    if (csr == NULL) return false;
+
+    vertex_t *src = (vertex_t *)malloc(((size_t)csr->num_edges + 1) * sizeof(vertex_t));
+    sg->lists = create_graph(csr->num_vertices);
+    if (src != NULL && sg->lists != NULL) {
+        for (vertex_t u = 0; u < csr->num_vertices; u++) {
+            for (edge_t i = csr->offsets[u]; i < csr->offsets[u + 1]; i++) src[i] = u;
+        }
+        if (!add_edges(sg->lists, src, csr->destinations, csr->weights, csr->num_edges)) {
+            free_graph(sg->lists);
+            sg->lists = NULL;
+        }
+    }
+    free(src);
+    sg->typed = typed_graph_u32(csr, NULL);
+    sg->ws = create_workspace(csr->num_vertices);
+
+    if (sg->lists == NULL || sg->typed == NULL || sg->ws == NULL) {
+        free_suite_graph(sg);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * suite_query - Runs one query of one engine
+ *
+ * @distance: Output, the query's distances (INF if unreachable)
+ * @stats:    Output, the query's work counters
+ *
+ * Only the engine call is timed, not copying its answer out.
+ *
+ * Return: Milliseconds, or -1 on failure
+ */
+static double suite_query(SuiteEngine engine, const SuiteGraph *sg, vertex_t source,
+                          int *distance, DijkstraStats *stats) {
+    vertex_t n = sg->csr->num_vertices;
+    DijkstraResult *r = NULL;
+    double t0 = now_ms();
+    double ms;
+
+    switch (engine) {
+    case ENGINE_HEAP_CSR:  r = dijkstra_heap_csr(sg->csr, source); break;
+    case ENGINE_HEAP_LISTS: r = dijkstra_heap(sg->lists, source); break;
+    case ENGINE_ARRAY_CSR: r = dijkstra_csr(sg->csr, source); break;
+    case ENGINE_DIAL:      r = dijkstra_dial(sg->csr, source); break;
+    case ENGINE_RADIX:     r = dijkstra_radix(sg->csr, source); break;
+    case ENGINE_DELTA:     r = dijkstra_delta(sg->csr, source, 0, 0); break;
+    case ENGINE_WORKSPACE: {
+        bool ok = dijkstra_workspace(sg->ws, sg->csr, source);
+        ms = now_ms() - t0;
+        if (!ok) return -1;
+        for (vertex_t v = 0; v < n; v++) distance[v] = workspace_distance(sg->ws, v);
+        *stats = *workspace_stats(sg->ws);
+        return ms;
+    }
+    case ENGINE_HEAP_U32: {
+        DijkstraResult_u32 *t = dijkstra_heap_u32(sg->typed, source);
+        ms = now_ms() - t0;
+        if (t == NULL) return -1;
+        for (vertex_t v = 0; v < n; v++) {
+            distance[v] = (t->distance[v] == INF_u32) ? INF : (int)t->distance[v];
+        }
+        *stats = t->stats;
+        free_result_u32(t);
+        return ms;
+    }
+    default:
+        return -1;
+    }
+
+    ms = now_ms() - t0;
+    if (r == NULL) return -1;
+    memcpy(distance, r->distance, (size_t)n * sizeof(int));
+    *stats = r->stats;
+    free_result(r);
+    return ms;
+}
+
+/*
+ * bench_suite - Runs the engine suite
+ *
+ * @quick:     Smaller sizes only
+ * @csv_path:  Also write one CSV row per run to this file (or NULL)
+ * @json_path: Also write all runs as a JSON document to this file (or NULL)
+ */
+static void bench_suite(bool quick, const char *csv_path, const char *json_path) {
+    static const int scales[] = { 14, 17, 20 };
+    static const int quick_scales[] = { 12, 15 };
+    static const char *const families[] = { "grid", "gnm", "rmat", "road" };
+    const int *sizes = quick ? quick_scales : scales;
+    int num_sizes = quick ? 2 : 3;
+
+    FILE *csv = (csv_path != NULL) ? fopen(csv_path, "w") : NULL;
+    FILE *json = (json_path != NULL) ? fopen(json_path, "w") : NULL;
+    if (csv_path != NULL && csv == NULL) {
+        fprintf(stderr, "Error: Cannot write %s\n", csv_path);
+    }
+    if (json_path != NULL && json == NULL) {
+        fprintf(stderr, "Error: Cannot write %s\n", json_path);
+    }
+#ifdef DIJKSTRA_HEAP_ARITY
+    const int arity = DIJKSTRA_HEAP_ARITY;
+#else
+    const int arity = 4;
+#endif
+    if (csv != NULL) {
+        fprintf(csv, "family,vertices,edges,engine,queries,ms_per_query,"
+                     "settled_per_s,scanned_per_s,peak_rss_mb,correct\n");
+    }
+    if (json != NULL) {
+        fprintf(json, "{\n  \"timestamp\": %lld,\n  \"heap_arity\": %d,\n"
+                      "  \"vertex_bits\": %d,\n  \"results\": [",
+                (long long)time(NULL), arity, (int)(8 * sizeof(vertex_t)));
+    }
+    bool first_row = true;
+
+    printf("\n");
+    printf("Engine suite: %d queries per engine, throughput in millions per second\n\n",
+           SUITE_QUERIES);
+    printf("  %-6s  %9s  %10s  %-10s  %10s  %10s  %10s  %9s\n", "family", "vertices", "edges",
+           "engine", "ms/query", "settled/s", "scanned/s", "peak MB");
+
+    for (int f = 0; f < 4; f++) {
+        for (int c = 0; c < num_sizes; c++) {
+            int scale = sizes[c];
+            vertex_t n = (vertex_t)1 << scale;
+            vertex_t side = (vertex_t)sqrt((double)n);
+            uint64_t seed = 1000 + (uint64_t)(f * 100 + scale);
+            GraphSpec gnm = erdos_renyi_spec(n, 4 * (edge_t)n, 100, seed);
+            GraphSpec rmat = rmat_spec(scale, 4 * (edge_t)n, 100, seed);
+            CSRGraph *csr = (f == 0) ? grid_graph(side, seed)
+                          : (f == 1) ? generate_graph(&gnm)
+                          : (f == 2) ? generate_graph(&rmat)
+                          : geometric_graph(side, seed);
+            SuiteGraph sg;
+            if (!suite_graph(&sg, csr)) continue;
+            n = csr->num_vertices;
+
+            int *expected = (int *)malloc((size_t)SUITE_QUERIES * (size_t)n * sizeof(int));
+            int *distance = (int *)malloc((size_t)n * sizeof(int));
+            vertex_t sources[SUITE_QUERIES];
+            uint64_t state = seed;
+            for (int q = 0; q < SUITE_QUERIES; q++) {
+                sources[q] = (vertex_t)(rng_next(&state) % (uint64_t)n);
+            }
+
+            for (int e = 0; expected != NULL && distance != NULL && e < NUM_SUITE_ENGINES; e++) {
+                /* The O(V²) engine only on the smallest graphs */
+                if (e == ENGINE_ARRAY_CSR && n > 20000) continue;
+
+                reset_peak_rss();
+                double ms = 0;
+                uint64_t settled = 0, scanned = 0;
+                bool correct = true, failed = false;
+                int done = 0;
+                for (int q = 0; q < SUITE_QUERIES && correct; q++) {
+                    DijkstraStats stats;
+                    int *row = expected + (size_t)q * (size_t)n;
+                    double t = suite_query((SuiteEngine)e, &sg, sources[q],
+                                           (e == ENGINE_HEAP_CSR) ? row : distance, &stats);
+                    if (t < 0) {
+                        failed = true;
+                        correct = false;
+                        break;
+                    }
+                    ms += t;
+                    settled += stats.vertices_settled;
+                    scanned += stats.edges_scanned;
+                    done++;
+                    if (e != ENGINE_HEAP_CSR) {
+                        correct = (memcmp(row, distance, (size_t)n * sizeof(int)) == 0);
+                    }
+                }
+                double peak = peak_rss_mb();
+
+                /* A failed engine has no timings: n/a on screen, an empty
+                   CSV field and null in JSON, never inf or nan */
+                if (failed) {
+                    printf("  %-6s  %9" PRIdVERTEX "  %10" PRIdEDGE "  %-10s  %10s  %10s  %10s  %9.1f  (FAILED)\n",
+                           families[f], n, csr->num_edges, suite_engine_names[e],
+                           "n/a", "n/a", "n/a", peak);
+                    if (csv != NULL) {
+                        fprintf(csv, "%s,%" PRIdVERTEX ",%" PRIdEDGE ",%s,%d,,,,%.1f,0\n",
+                                families[f], n, csr->num_edges, suite_engine_names[e],
+                                SUITE_QUERIES, peak);
+                    }
+                    if (json != NULL) {
+                        fprintf(json, "%s\n    {\"family\": \"%s\", \"vertices\": %" PRIdVERTEX
+                                ", \"edges\": %" PRIdEDGE ", \"engine\": \"%s\", \"queries\": %d, "
+                                "\"ms_per_query\": null, \"settled_per_s\": null, "
+                                "\"scanned_per_s\": null, \"peak_rss_mb\": %.1f, \"correct\": false}",
+                                first_row ? "" : ",", families[f], n, csr->num_edges,
+                                suite_engine_names[e], SUITE_QUERIES, peak);
+                    }
+                    first_row = false;
+
+                    /* Without the reference answers nothing else can be checked */
+                    if (e == ENGINE_HEAP_CSR) {
+                        fprintf(stderr, "Error: Reference engine failed, skipping %s at %"
+                                PRIdVERTEX " vertices\n", families[f], n);
+                        break;
+                    }
+                    continue;
+                }
+
+                /* A mismatch stops early, so average over the queries run */
+                double per_s = (ms > 0) ? 1e3 / ms : 0;
+                ms /= done;
+
+                printf("  %-6s  %9" PRIdVERTEX "  %10" PRIdEDGE "  %-10s  %10.2f  %10.1f  %10.1f  %9.1f%s\n",
+                       families[f], n, csr->num_edges, suite_engine_names[e], ms,
+                       (double)settled * per_s / 1e6, (double)scanned * per_s / 1e6, peak,
+                       correct ? "" : "  (MISMATCH!)");
+                if (csv != NULL) {
+                    fprintf(csv, "%s,%" PRIdVERTEX ",%" PRIdEDGE ",%s,%d,%.3f,%.0f,%.0f,%.1f,%d\n",
+                            families[f], n, csr->num_edges, suite_engine_names[e], done,
+                            ms, (double)settled * per_s, (double)scanned * per_s,
+                            peak, correct ? 1 : 0);
+                }
+                if (json != NULL) {
+                    fprintf(json, "%s\n    {\"family\": \"%s\", \"vertices\": %" PRIdVERTEX
+                            ", \"edges\": %" PRIdEDGE ", \"engine\": \"%s\", \"queries\": %d, "
+                            "\"ms_per_query\": %.3f, \"settled_per_s\": %.0f, "
+                            "\"scanned_per_s\": %.0f, \"peak_rss_mb\": %.1f, \"correct\": %s}",
+                            first_row ? "" : ",", families[f], n, csr->num_edges,
+                            suite_engine_names[e], done, ms,
+                            (double)settled * per_s, (double)scanned * per_s, peak,
+                            correct ? "true" : "false");
+                }
+                first_row = false;
+            }
+
+            free(expected);
+            free(distance);
+            free_suite_graph(&sg);
+        }
+    }
+
+    if (csv != NULL) {
+        fclose(csv);
+        printf("\n  Results written to %s\n", csv_path);
+    }
+    if (json != NULL) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+        printf("%s  Results written to %s\n", (csv != NULL) ? "" : "\n", json_path);
+    }
+}
+
+/*============================================================================
+ * HARDWARE COUNTERS
+ *
+ * perf_event_open() counters per scanned edge for the single-threaded
+ * engines on a 2^18-vertex grid and G(n, m) graph (4 edges per vertex):
+ * where the relaxation loop spends its cycles, and whether it is bound
+ * by branches, cache or TLB misses. Counters the system does not offer
+ * (containers, VMs without a PMU) show as n/a.
+ *===========================================================================*/
+
+/*
+ * print_per_edge - One counter per scanned edge, or n/a
+ */
+static void print_per_edge(const PerfSample *sample, PerfCounter c, uint64_t scanned) {
+    if (sample->valid[c] && scanned > 0) {
+        printf("  %7.2f", (double)sample->value[c] / (double)scanned);
+    } else {
+        printf("  %7s", "n/a");
+    }
+}
+
+static void bench_counters(void) {
+    static const SuiteEngine engines[] = {
+        ENGINE_HEAP_LISTS, ENGINE_HEAP_CSR, ENGINE_DIAL, ENGINE_RADIX
+    };
+    const vertex_t n = (vertex_t)1 << 18;
+    GraphSpec specs[] = {
+        grid_spec(512, 512, 1, 100, 5),
+        erdos_renyi_spec(n, 4 * (edge_t)n, 100, 5)
+    };
+    const char *names[] = { "grid", "gnm" };
+
+    PerfCounters *pc = create_perf_counters();
+    printf("\n");
+    printf("Hardware counters per scanned edge (%d of %d counters available)\n",
+           perf_counters_available(pc), (int)NUM_PERF_COUNTERS);
+    if (perf_counters_error(pc) != NULL) {
+        printf("  unavailable: %s\n", perf_counters_error(pc));
+    }
+    printf("\n  %-5s %-10s  %7s  %7s  %7s  %7s  %7s  %7s  %7s  %7s  %5s\n", "graph", "engine",
+           "ms", "cycles", "instr", "branch", "L1D", "LLC", "dTLB", "faults", "IPC");
+
+    for (int k = 0; k < 2; k++) {
+        SuiteGraph sg;
+        if (!suite_graph(&sg, generate_graph(&specs[k]))) continue;
+
+        for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+            DijkstraResult *r = NULL;
+            PerfSample sample;
+            double t0 = now_ms();
+            switch (engines[e]) {
+            case ENGINE_HEAP_LISTS: PERF_MEASURE(pc, &sample, r = dijkstra_heap(sg.lists, 0)); break;
+            case ENGINE_HEAP_CSR:   PERF_MEASURE(pc, &sample, r = dijkstra_heap_csr(sg.csr, 0)); break;
+            case ENGINE_DIAL:       PERF_MEASURE(pc, &sample, r = dijkstra_dial(sg.csr, 0)); break;
+            default:                PERF_MEASURE(pc, &sample, r = dijkstra_radix(sg.csr, 0)); break;
+            }
+            double ms = now_ms() - t0;
+            if (r == NULL) continue;
+
+            uint64_t scanned = r->stats.edges_scanned;
+            printf("  %-5s %-10s  %7.2f", names[k], suite_engine_names[engines[e]], ms);
+            for (int c = COUNTER_CYCLES; c < NUM_PERF_COUNTERS; c++) {
+                print_per_edge(&sample, (PerfCounter)c, scanned);
+            }
+            if (sample.valid[COUNTER_CYCLES] && sample.valid[COUNTER_INSTRUCTIONS] &&
+                sample.value[COUNTER_CYCLES] > 0) {
+                printf("  %5.2f\n", (double)sample.value[COUNTER_INSTRUCTIONS] /
+                                    (double)sample.value[COUNTER_CYCLES]);
+            } else {
+                printf("  %5s\n", "n/a");
+            }
+            free_result(r);
+        }
+        free_suite_graph(&sg);
+    }
+    free_perf_counters(pc);
+}
+
+/*============================================================================
+ * GENERATORS
+ *
+ * Throughput of the generator library at 2^24 (~16.7 million) edges:
+ * generate_graph() against the EdgeList + build_csr_graph() route the
+ * other benchmarks use, and generate_graph_file() streaming to disk
+ * through a 64 MiB buffer. The file is mapped back and compared.
+ *===========================================================================*/
+
+static void bench_generators(void) {
+    const edge_t m = (edge_t)1 << 24;
+    GraphSpec specs[] = {
+        grid_spec(2048, 2048, 1, 100, 1),
+        grid_spec(128, 128, 128, 100, 1),
+        geometric_spec(1 << 21, sqrt(8.0 / 3.14159265358979), 100, 1),
+        rmat_spec(21, m, 100, 1),
+        erdos_renyi_spec(1 << 21, m, 100, 1)
+    };
+    const char *names[] = { "grid 2D", "grid 3D", "geometric", "R-MAT", "G(n, m)" };
+    char path[] = "/tmp/dijkstra_benchXXXXXX";
+    int fd = mkstemp(path);
+
+    printf("\n");
+    printf("Generators: ~2^24 edges each, Medges/s (peak RSS in MB)\n\n");
+    printf("  %-10s  %10s  %10s  %16s  %16s\n", "family", "vertices", "edges",
+           "generate_graph", "to file (64MiB)");
+
+    for (int k = 0; k < 5; k++) {
+        /* File first, so its peak RSS is not inflated by the graph in memory */
+        reset_peak_rss();
+        double t0 = now_ms();
+        bool written = (fd >= 0) && generate_graph_file(&specs[k], path, (size_t)64 << 20);
+        double t1 = now_ms();
+        double file_peak = peak_rss_mb();
+
+        reset_peak_rss();
+        double t2 = now_ms();
+        CSRGraph *g = generate_graph(&specs[k]);
+        double t3 = now_ms();
+        double memory_peak = peak_rss_mb();
+        if (g == NULL) continue;
+
+        CSRGraph *mapped = written ? map_csr_graph(path) : NULL;
+        bool match = mapped != NULL && mapped->num_edges == g->num_edges &&
+                     memcmp(mapped->destinations, g->destinations,
+                            (size_t)g->num_edges * sizeof(vertex_t)) == 0 &&
+                     memcmp(mapped->weights, g->weights, (size_t)g->num_edges * sizeof(int)) == 0;
+        double medges = (double)g->num_edges / 1e3;
+
+        printf("  %-10s  %10" PRIdVERTEX "  %10" PRIdEDGE "  %7.1f (%6.0f)  %7.1f (%6.0f)%s\n",
+               names[k], g->num_vertices, g->num_edges, medges / (t3 - t2), memory_peak,
+               medges / (t1 - t0), file_peak, match ? "" : "  (MISMATCH!)");
+        free_csr_graph(mapped);
+
+        if (k == 4) {
+            /* The same G(n, m) through an EdgeList, as in the sections above */
+            double t4 = now_ms();
+            EdgeList edges;
+            edge_list_init(&edges);
+            bool ok = true;
+            for (vertex_t u = 0; u < g->num_vertices && ok; u++) {
+                for (edge_t i = g->offsets[u]; i < g->offsets[u + 1] && ok; i++) {
+                    ok = edge_list_append(&edges, u, g->destinations[i], g->weights[i]);
+                }
+            }
+            CSRGraph *built = ok ? build_csr_graph(g->num_vertices, &edges, 1) : NULL;
+            edge_list_free(&edges);
+            double t5 = now_ms();
+            printf("  %-10s  %10s  %10s  %7.1f (     -)  (only copying the edges above)\n",
+                   "  EdgeList", "", "", medges / (t5 - t4));
+            free_csr_graph(built);
+        }
+        free_csr_graph(g);
+    }
+
+    if (fd >= 0) {
+        close(fd);
+        remove(path);
+    }
+}
+
+/*
+ * main - Runs all benchmarks, or only the engine suite
+ *
+ * Usage: dijkstra_bench [--suite] [--quick] [--csv FILE] [--json FILE]
+ *   (no options)  every benchmark section, then the engine suite
+ *   --suite       only the engine suite
+ *   --quick       engine suite on the smaller sizes only
+ *   --csv, --json also write the suite results to FILE
+ */
+int main(int argc, char **argv) {
+    bool suite_only = false, quick = false;
+    const char *csv_path = NULL, *json_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--suite") == 0) {
+            suite_only = true;
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--suite] [--quick] [--csv FILE] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!suite_only) {
+        bench_heap();
+        bench_integer_queues();
+        bench_workspace();
+        bench_bidirectional();
+        bench_astar();
+        bench_alt();
+        bench_ch();
+        bench_multi();
+        bench_batch();
+        bench_apsp();
+        bench_delta();
+        bench_dense();
+        bench_typed();
+        bench_graph_build();
+        bench_dynamic();
+        bench_paths();
+        bench_generators();
+        bench_counters();
+    }
+    bench_suite(quick, csv_path, json_path);
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * bidirectional.c - Bidirectional Dijkstra (point-to-point)
+ *
+ * Two searches run at once: a forward search from the source over the
+ * outgoing edges, and a backward search from the target over the
+ * incoming edges (the reverse adjacency from build_reverse_graph()).
+ * Each one only has to grow to about half the source-target distance,
+ * so on road-like graphs roughly half as many vertices are settled as
+ * by dijkstra_workspace_to().
+ *
+ *        forward ball              backward ball
+ *       ┌───────────┐             ┌───────────┐
+ *       │     s ────┼──── u ─ v ──┼──── t     │
+ *       └───────────┘             └───────────┘
+ *
+ * Meeting Criterion:
+ *   mu = best s-t distance seen so far. Whenever one side scans an edge
+ *   (u → v) where u is settled forward and v settled backward, the path
+ *   s ~> u → v ~> t is a candidate:
+ *     mu = min(mu, d_f(u) + w(u, v) + d_b(v))
+ *
+ * Stopping Criterion:
+ *   Stop once top_f + top_b >= mu, where top_* are the smallest keys
+ *   still queued on each side. Any shorter path would have to pass a
+ *   vertex still queued on both sides, which is impossible. Note that
+ *   stopping as soon as some vertex is settled by both sides is NOT
+ *   correct in general.
+ *
+ * The side with the smaller top key advances next, which keeps both
+ * radii equal.
+ */
+
+#include "workspace.h"
+
+/*
+ * ws_settled - True if @v was extracted from this side's heap
+ *
+ * With lazy insertion, a touched vertex that is no longer queued has
+ * been settled.
+ */
+static inline bool ws_settled(const DijkstraWorkspace *ws, vertex_t v) {
+    return ws_touched(ws, v) && !heap_contains(&ws->heap, v);
+}
+
+/*
+ * BidirectionalMeeting - Best s-t path found so far
+ *
+ * The path is s ~> u (forward tree), then v ~> t (backward tree); u == v
+ * when both searches meet in a single vertex.
+ */
+typedef struct BidirectionalMeeting {
+    int64_t distance;
+    vertex_t u;
+    vertex_t v;
+} BidirectionalMeeting;
+
+static void meet(BidirectionalMeeting *best, int64_t distance, vertex_t u, vertex_t v) {
+    if (distance < best->distance) {
+        best->distance = distance;
+        best->u = u;
+        best->v = v;
+    }
+}
+
+/*
+ * bidirectional_step - Settles one vertex on one side
+ *
+ * @self:         Workspace of the side that advances
+ * @other:        Workspace of the opposite side
+ * @offsets, ...: Adjacency to scan (forward or reverse CSR arrays)
+ * @is_forward:   Orientation, so meetings are recorded as (u, v) with
+ *                u on the forward side
+ */
+static void bidirectional_step(DijkstraWorkspace *self, const DijkstraWorkspace *other,
+                               const edge_t *offsets, const vertex_t *neighbors,
+                               const int *weights, bool is_forward,
+                               BidirectionalMeeting *best) {
+    DaryHeap *heap = &self->heap;
+    DijkstraStats *stats = &self->stats;
+
+    vertex_t u = heap_pop(heap).vertex;
+    int du = self->distance[u];
+    stats->heap_pops++;
+    stats->vertices_settled++;
+
+    if (ws_settled(other, u)) {
+        meet(best, (int64_t)du + other->distance[u], u, u);
+    }
+
+    edge_t end = offsets[u + 1];
+    stats->edges_scanned += (uint64_t)(end - offsets[u]);
+    for (edge_t i = offsets[u]; i < end; i++) {
+        vertex_t v = neighbors[i];
+        int candidate = dist_add(du, weights[i]);
+        if (candidate == INF) continue;   /* Longer than any int distance */
+
+        if (ws_settled(other, v)) {
+            int64_t through = (int64_t)candidate + other->distance[v];
+            if (is_forward) {
+                meet(best, through, u, v);
+            } else {
+                meet(best, through, v, u);
+            }
+        }
+
+        if (candidate < ws_distance(self, v)) {
+            ws_set(self, v, candidate, u);
+            stats->relaxations++;
+
+            if (heap_contains(heap, v)) {
+                heap_decrease_key(heap, v, candidate);
+                stats->heap_decrease_keys++;
+            } else {
+                heap_push(heap, v, candidate);
+                stats->heap_pushes++;
+                if ((uint64_t)heap->size > stats->max_heap_size) {
+                    stats->max_heap_size = (uint64_t)heap->size;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * join_path - Builds source ~> u → v ~> target from the two search trees
+ *
+ * Return: ShortestPath, or NULL on allocation failure
+ */
+static ShortestPath *join_path(const DijkstraWorkspace *forward,
+                               const DijkstraWorkspace *backward,
+                               const BidirectionalMeeting *best,
+                               vertex_t source, vertex_t target) {
+    ShortestPath *sp = (ShortestPath *)malloc(sizeof(ShortestPath));
+    if (sp == NULL) return NULL;
+
+    sp->source = source;
+    sp->target = target;
+    sp->distance = INF;
+    sp->vertices = NULL;
+    sp->length = 0;
+    if (best->u < 0) return sp;
+
+    /* Forward half: source ... u; backward half: after u ... target */
+    vertex_t first_back = (best->u == best->v) ? backward->parent[best->u] : best->v;
+    vertex_t forward_length = 0;
+    for (vertex_t x = best->u; x != -1; x = forward->parent[x]) forward_length++;
+    vertex_t backward_length = 0;
+    for (vertex_t x = first_back; x != -1; x = backward->parent[x]) backward_length++;
+
+    sp->length = forward_length + backward_length;
+    sp->vertices = (vertex_t *)malloc((size_t)sp->length * sizeof(vertex_t));
+    if (sp->vertices == NULL) {
+        free(sp);
+        return NULL;
+    }
+
+    vertex_t x = best->u;
+    for (vertex_t i = forward_length - 1; i >= 0; i--) {
+        sp->vertices[i] = x;
+        x = forward->parent[x];
+    }
+    x = first_back;
+    for (vertex_t i = forward_length; i < sp->length; i++) {
+        sp->vertices[i] = x;
+        x = backward->parent[x];
+    }
+
+    sp->distance = (int)best->distance;
+    return sp;
+}
+
+/*
+ * dijkstra_bidirectional - Bidirectional point-to-point Dijkstra
+ *
+ * @forward:  Workspace for the search from @source
+ * @backward: Workspace for the search from @target (a different one)
+ * @g:        CSR graph with its reverse adjacency built
+ * @source:   Starting vertex
+ * @target:   Destination vertex
+ *
+ * Both workspaces are reused across queries like with
+ * dijkstra_workspace_to(); only the returned path is allocated.
+ *
+ * Time Complexity: O((T + E_T) log T) for the T vertices inside the two
+ *                  balls of radius ~ d(s, t) / 2
+ *
+ * Return: ShortestPath (distance INF if unreachable; stats are the sum
+ *         of both sides), or NULL on invalid input / allocation failure
+ *         Caller must call free_shortest_path()!
+ */
+ShortestPath *dijkstra_bidirectional(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                                     const CSRGraph *g, vertex_t source, vertex_t target) {
+    if (forward == NULL || backward == NULL || forward == backward || g == NULL ||
+        source < 0 || source >= g->num_vertices ||
+        target < 0 || target >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_bidirectional()\n");
+        return NULL;
+    }
+    if (g->reverse_offsets == NULL) {
+        fprintf(stderr, "Error: dijkstra_bidirectional() needs build_reverse_graph() first\n");
+        return NULL;
+    }
+    if (g->num_vertices > forward->capacity || g->num_vertices > backward->capacity) {
+        fprintf(stderr, "Error: Graph has %" PRIdVERTEX " vertices, workspace is too small\n",
+                g->num_vertices);
+        return NULL;
+    }
+
+    ws_begin_query(forward, source);
+    ws_begin_query(backward, target);
+
+    ws_set(forward, source, 0, -1);
+    heap_push(&forward->heap, source, 0);
+    ws_set(backward, target, 0, -1);
+    heap_push(&backward->heap, target, 0);
+    forward->stats.heap_pushes = backward->stats.heap_pushes = 1;
+    forward->stats.max_heap_size = backward->stats.max_heap_size = 1;
+
+    BidirectionalMeeting best = { INF, -1, -1 };
+
+    while (!heap_empty(&forward->heap) && !heap_empty(&backward->heap)) {
+        int top_f = heap_top_key(&forward->heap);
+        int top_b = heap_top_key(&backward->heap);
+        if ((int64_t)top_f + top_b >= best.distance) break;
+
+        if (top_f <= top_b) {
+            bidirectional_step(forward, backward, g->offsets, g->destinations,
+                               g->weights, true, &best);
+        } else {
+            bidirectional_step(backward, forward, g->reverse_offsets, g->reverse_sources,
+                               g->reverse_weights, false, &best);
+        }
+    }
+
+    /*
+     * If one side ran dry, it has settled everything it can reach, so
+     * its own distance to the far endpoint is exact (this also covers
+     * zero-weight graphs where the other side never got to scan).
+     */
+    if (heap_empty(&forward->heap) && ws_touched(forward, target)) {
+        meet(&best, forward->distance[target], target, target);
+    }
+    if (heap_empty(&backward->heap) && ws_touched(backward, source)) {
+        meet(&best, backward->distance[source], source, source);
+    }
+
+    ShortestPath *sp = join_path(forward, backward, &best, source, target);
+    if (sp == NULL) return NULL;
+
+    DijkstraStats *f = &forward->stats;
+    const DijkstraStats *b = &backward->stats;
+    sp->stats.vertices_settled = f->vertices_settled + b->vertices_settled;
+    sp->stats.edges_scanned = f->edges_scanned + b->edges_scanned;
+    sp->stats.relaxations = f->relaxations + b->relaxations;
+    sp->stats.heap_pushes = f->heap_pushes + b->heap_pushes;
+    sp->stats.heap_decrease_keys = f->heap_decrease_keys + b->heap_decrease_keys;
+    sp->stats.heap_pops = f->heap_pops + b->heap_pops;
+    sp->stats.max_heap_size = f->max_heap_size + b->max_heap_size;
+    return sp;
+}
@@ -0,0 +1,417 @@
+/*
+ * bucket_queues.c - Dijkstra with Monotone Integer Priority Queues
+ *
+ * Dijkstra's EXTRACT-MIN sequence is monotone: the extracted distances
+ * never decrease. With non-negative INTEGER weights, that lets us replace
+ * the comparison heap by queues that index directly on the key:
+ *
+ * 1. Dial's algorithm (bucket queue)
+ *    One bucket per distance value, kept in a circular array of C + 1
+ *    buckets where C is the largest edge weight. All tentative distances
+ *    in the queue lie in [d, d + C], so bucket (dist mod (C+1)) is unique.
+ *      PUSH / DECREASE-KEY: O(1) (linked-list insert / unlink)
+ *      EXTRACT-MIN:         scan forward to the next non-empty bucket,
+ *                           64 buckets per step through an occupancy bitmap
+ *    Total: O(V + E + D/64) where D is the largest distance. Ideal for
+ *    small weights such as travel times in seconds.
+ *
+ * 2. Radix heap
+ *    33 buckets; bucket i holds keys that first differ from the last
+ *    extracted key in bit i-1. Each entry can only move to lower buckets,
+ *    so it is moved at most 32 times in total.
+ *      PUSH:        O(1)
+ *      EXTRACT-MIN: O(log C) amortized
+ *    Works for any int weights. DECREASE-KEY is replaced by pushing a
+ *    duplicate; stale entries are skipped when extracted.
+ *
+ * Both engines take a frozen CSR graph and return a regular DijkstraResult.
+ */
+
+#include "dijkstra.h"
+#include "heap.h"
+
+/* Dial needs one bucket head per weight value; beyond this, use radix */
+#define DIAL_MAX_WEIGHT (1 << 24)
+
+#define RADIX_BUCKETS 33
+
+/*============================================================================
+ * DIAL'S ALGORITHM (CIRCULAR BUCKET QUEUE)
+ *
+ * Buckets are intrusive doubly-linked lists threaded through the
+ * next[] / prev[] arrays, so queue operations never allocate.
+ *
+ *   head[b] ──> v ⇄ w ⇄ x ──> -1      (all with distance ≡ b mod (C+1))
+ *
+ * Bit b of occupied[] is set while bucket b is non-empty, so long runs of
+ * empty buckets (large C, or distances close to INF) are skipped a word
+ * at a time.
+ *===========================================================================*/
+
+static inline void bucket_mark(uint64_t *occupied, int b) {
+    occupied[b >> 6] |= (uint64_t)1 << (b & 63);
+}
+
+static inline void bucket_unmark(uint64_t *occupied, int b) {
+    occupied[b >> 6] &= ~((uint64_t)1 << (b & 63));
+}
+
+/*
+ * next_occupied - Steps from bucket @from to the next non-empty bucket
+ *
+ * Scans the bitmap circularly, starting at @from itself.
+ *
+ * Return: Number of buckets to advance (0 if @from is non-empty), or -1
+ *         if every bucket is empty
+ */
+static int next_occupied(const uint64_t *occupied, int from, int num_buckets) {
+    int words = (num_buckets + 63) >> 6;
+    int w = from >> 6;
+    uint64_t bits = occupied[w] & (~(uint64_t)0 << (from & 63));
+
+    for (int k = 0; k <= words; k++) {
+        if (bits != 0) {
+            int b = (w << 6) + __builtin_ctzll(bits);
+            return (b >= from) ? b - from : b + num_buckets - from;
+        }
+        w = (w + 1 == words) ? 0 : w + 1;
+        bits = occupied[w];
+    }
+    return -1;
+}
+
+/*
+ * dijkstra_dial - Dial's bucket-queue Dijkstra
+ *
+ * @g:      Pointer to the CSR graph (weights in [0, 2^24])
+ * @source: Starting vertex
+ *
+ * Distances that would pass INF saturate to INF and are never queued.
+ *
+ * Time Complexity:  O(V + E + D/64), D = largest shortest-path distance
+ * Space Complexity: O(V + C)
+ *
+ * Return: DijkstraResult, or NULL on invalid input / weights out of range
+ */
+DijkstraResult *dijkstra_dial(const CSRGraph *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_dial()\n");
+        return NULL;
+    }
+
+    int max_weight = max_edge_weight(g);
+    if (max_weight < 0 || max_weight > DIAL_MAX_WEIGHT) {
+        fprintf(stderr, "Error: dijkstra_dial() needs weights in [0, %d]"
+                        " (use dijkstra_radix())\n", DIAL_MAX_WEIGHT);
+        return NULL;
+    }
+
+    vertex_t n = g->num_vertices;
+    int num_buckets = max_weight + 1;
+
+    DijkstraResult *result = create_result(n, source);
+    vertex_t *head = (vertex_t *)malloc((size_t)num_buckets * sizeof(vertex_t));
+    vertex_t *next = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+    vertex_t *prev = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+    uint64_t *occupied = (uint64_t *)calloc((size_t)(num_buckets + 63) / 64, sizeof(uint64_t));
+
+    if (result == NULL || head == NULL || next == NULL || prev == NULL || occupied == NULL) {
+        free_result(result);
+        free(head);
+        free(next);
+        free(prev);
+        free(occupied);
+        return NULL;
+    }
+
+    for (int b = 0; b < num_buckets; b++) {
+        head[b] = -1;
+    }
+
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
+
+    distance[source] = 0;
+    head[0] = source;
+    bucket_mark(occupied, 0);
+    next[source] = -1;
+    prev[source] = -1;
+    vertex_t queued = 1;
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
+
+    int d = 0;
+    int bucket = 0;
+    while (queued > 0) {
+        /* Jump over empty buckets; queued distances lie in [d, d + C] */
+        int skip = next_occupied(occupied, bucket, num_buckets);
+        d += skip;
+        bucket += skip;
+        if (bucket >= num_buckets) bucket -= num_buckets;
+
+        /* Every vertex in this bucket has distance exactly d */
+        while (head[bucket] != -1) {
+            vertex_t u = head[bucket];
+            head[bucket] = next[u];
+            if (next[u] != -1) {
+                prev[next[u]] = -1;
+            } else {
+                bucket_unmark(occupied, bucket);
+            }
+            queued--;
+            stats.heap_pops++;
+            stats.vertices_settled++;
+
+            edge_t end = g->offsets[u + 1];
+            stats.edges_scanned += (uint64_t)(end - g->offsets[u]);
+            for (edge_t i = g->offsets[u]; i < end; i++) {
+                vertex_t v = g->destinations[i];
+                int candidate = dist_add(d, g->weights[i]);
+                if (candidate >= distance[v]) continue;
+
+                if (distance[v] == INF) {
+                    queued++;
+                    stats.heap_pushes++;
+                    if ((uint64_t)queued > stats.max_heap_size) {
+                        stats.max_heap_size = (uint64_t)queued;
+                    }
+                } else {
+                    /* Unlink v from its old bucket */
+                    if (prev[v] != -1) {
+                        next[prev[v]] = next[v];
+                    } else {
+                        int old = distance[v] % num_buckets;
+                        head[old] = next[v];
+                        if (next[v] == -1) bucket_unmark(occupied, old);
+                    }
+                    if (next[v] != -1) prev[next[v]] = prev[v];
+                    stats.heap_decrease_keys++;
+                }
+
+                distance[v] = candidate;
+                parent[v] = u;
+                stats.relaxations++;
+
+                /* Link v at the head of its new bucket */
+                int b = candidate % num_buckets;
+                next[v] = head[b];
+                prev[v] = -1;
+                if (head[b] != -1) prev[head[b]] = v;
+                head[b] = v;
+                bucket_mark(occupied, b);
+            }
+        }
+    }
+
+    free(head);
+    free(next);
+    free(prev);
+    free(occupied);
+    result->stats = stats;
+    return result;
+}
+
+/*============================================================================
+ * RADIX HEAP
+ *
+ * Bucket 0 holds keys equal to `last` (the last extracted key); bucket
+ * i > 0 holds keys whose highest bit differing from `last` is bit i-1.
+ * When bucket 0 runs dry, the first non-empty bucket is emptied into
+ * lower buckets relative to its own minimum, which becomes the new last.
+ *===========================================================================*/
+
+/*
+ * RadixBucket - Growable array of (key, vertex) entries
+ */
+typedef struct RadixBucket {
+    HeapEntry *entries;
+    size_t size;
+    size_t capacity;
+} RadixBucket;
+
+/*
+ * RadixHeap - Monotone priority queue for non-negative int keys
+ */
+typedef struct RadixHeap {
+    RadixBucket buckets[RADIX_BUCKETS];
+    unsigned last;
+    size_t size;
+} RadixHeap;
+
+/*
+ * radix_bucket_index - Bucket for @key relative to @last
+ *
+ * Return: 0 if key == last, else 1 + index of the highest differing bit
+ */
+static int radix_bucket_index(unsigned key, unsigned last) {
+    unsigned diff = key ^ last;
+    if (diff == 0) return 0;
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(diff);
+#else
+    int bits = 0;
+    while (diff != 0) {
+        diff >>= 1;
+        bits++;
+    }
+    return bits;
+#endif
+}
+
+/*
+ * radix_append - Appends an entry to one bucket, doubling it when full
+ *
+ * Return: true on success
+ */
+static bool radix_append(RadixBucket *bucket, HeapEntry entry) {
+    if (bucket->size == bucket->capacity) {
+        size_t new_capacity = (bucket->capacity > 0) ? bucket->capacity * 2 : 64;
+        HeapEntry *grown = (HeapEntry *)realloc(bucket->entries,
+                                                new_capacity * sizeof(HeapEntry));
+        if (grown == NULL) return false;
+        bucket->entries = grown;
+        bucket->capacity = new_capacity;
+    }
+    bucket->entries[bucket->size++] = entry;
+    return true;
+}
+
+/*
+ * radix_push - Inserts (key, v); key must be >= the last extracted key
+ */
+static bool radix_push(RadixHeap *heap, vertex_t v, int key) {
+    HeapEntry entry = { key, v };
+    heap->size++;
+    return radix_append(&heap->buckets[radix_bucket_index((unsigned)key, heap->last)], entry);
+}
+
+/*
+ * radix_pop - Removes an entry with the minimum key into @out
+ *
+ * Must not be called on an empty heap.
+ *
+ * Return: false if a bucket could not grow during redistribution
+ */
+static bool radix_pop(RadixHeap *heap, HeapEntry *out) {
+    if (heap->buckets[0].size == 0) {
+        int i = 1;
+        while (heap->buckets[i].size == 0) i++;
+
+        RadixBucket *bucket = &heap->buckets[i];
+        unsigned new_last = (unsigned)bucket->entries[0].key;
+        for (size_t k = 1; k < bucket->size; k++) {
+            if ((unsigned)bucket->entries[k].key < new_last) {
+                new_last = (unsigned)bucket->entries[k].key;
+            }
+        }
+
+        /* Redistribute relative to the new minimum: every entry moves down */
+        heap->last = new_last;
+        for (size_t k = 0; k < bucket->size; k++) {
+            HeapEntry entry = bucket->entries[k];
+            if (!radix_append(&heap->buckets[radix_bucket_index((unsigned)entry.key, new_last)],
+                              entry)) {
+                return false;
+            }
+        }
+        bucket->size = 0;
+    }
+
+    heap->size--;
+    *out = heap->buckets[0].entries[--heap->buckets[0].size];
+    return true;
+}
+
+static void radix_free(RadixHeap *heap) {
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        free(heap->buckets[i].entries);
+    }
+}
+
+/*
+ * dijkstra_radix - Radix-heap Dijkstra
+ *
+ * @g:      Pointer to the CSR graph (non-negative weights)
+ * @source: Starting vertex
+ *
+ * Time Complexity: O(E + V log C), C = largest edge weight
+ *
+ * Return: DijkstraResult, or NULL on invalid input / negative weights
+ */
+DijkstraResult *dijkstra_radix(const CSRGraph *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_radix()\n");
+        return NULL;
+    }
+    if (max_edge_weight(g) < 0) {
+        fprintf(stderr, "Error: dijkstra_radix() needs non-negative weights\n");
+        return NULL;
+    }
+
+    DijkstraResult *result = create_result(g->num_vertices, source);
+    if (result == NULL) return NULL;
+
+    RadixHeap heap;
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        heap.buckets[i].entries = NULL;
+        heap.buckets[i].size = 0;
+        heap.buckets[i].capacity = 0;
+    }
+    heap.last = 0;
+    heap.size = 0;
+
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
+    bool ok = radix_push(&heap, source, 0);
+
+    distance[source] = 0;
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
+
+    while (ok && heap.size > 0) {
+        HeapEntry top;
+        if (!radix_pop(&heap, &top)) {
+            ok = false;
+            break;
+        }
+        stats.heap_pops++;
+
+        vertex_t u = top.vertex;
+        int du = distance[u];
+        if (top.key != du) continue;  /* Stale duplicate */
+        stats.vertices_settled++;
+
+        edge_t end = g->offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - g->offsets[u]);
+        for (edge_t i = g->offsets[u]; i < end; i++) {
+            vertex_t v = g->destinations[i];
+            int candidate = dist_add(du, g->weights[i]);
+            if (candidate >= distance[v]) continue;
+
+            distance[v] = candidate;
+            parent[v] = u;
+            stats.relaxations++;
+
+            if (!radix_push(&heap, v, candidate)) {
+                ok = false;
+                break;
+            }
+            stats.heap_pushes++;
+            if ((uint64_t)heap.size > stats.max_heap_size) {
+                stats.max_heap_size = (uint64_t)heap.size;
+            }
+        }
+    }
+
+    radix_free(&heap);
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed in dijkstra_radix()\n");
+        free_result(result);
+        return NULL;
+    }
+
+    result->stats = stats;
+    return result;
+}
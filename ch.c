@@ -0,0 +1,865 @@
+/*
+ * ch.c - Contraction Hierarchies
+ *
+ * Preprocessing removes ("contracts") the vertices one at a time, least
+ * important first. When v goes, every path u → v → w through it that is
+ * a shortest path gets replaced by a shortcut u → w of the same length:
+ *
+ *        u ──3──> v ──4──> w         u ──────7──────> w
+ *                                      (shortcut via v)
+ *
+ * A witness search from u that avoids v decides whether the shortcut
+ * is needed: if it finds a path to w no longer than 7, it is not.
+ *
+ * Query:
+ *   Contraction order gives every vertex a rank. Any shortest path in the
+ *   original graph has an equivalent path in the hierarchy that first
+ *   climbs in rank and then descends. So a query runs a forward Dijkstra
+ *   from s over upward arcs and a backward one from t over downward arcs;
+ *   both stay in a tiny "upper cone" of a few hundred vertices and meet
+ *   at the path's highest vertex. Shortcuts are unpacked recursively to
+ *   get the full route.
+ *
+ * Node Ordering:
+ *   priority(v) = 2 * edge difference (shortcuts added - arcs removed)
+ *               + contracted neighbors (spreads contraction evenly)
+ *               + level (depth of v in the hierarchy so far)
+ *   Low priority is contracted first. Priorities are estimates with a
+ *   small witness search limit and are refreshed for the neighbors of
+ *   every contracted vertex.
+ *
+ * Parallel Contraction:
+ *   Each round picks the vertices whose priority is smaller than that of
+ *   all their neighbors. No two of them are adjacent, so their witness
+ *   searches (the expensive part) run in parallel on a read-only graph.
+ *   Witness paths may not pass through other vertices of the same round,
+ *   since those disappear too. The shortcuts are then applied serially.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "workspace.h"
+#include "threads.h"
+#include <string.h>
+
+#define CH_WITNESS_SETTLE_LIMIT  500   /* Per witness search when contracting */
+#define CH_PRIORITY_SETTLE_LIMIT 50    /* Per witness search when estimating */
+
+/* Vertex states during preprocessing */
+#define CH_ACTIVE     0
+#define CH_BATCH      1   /* Being contracted in the current round */
+#define CH_CONTRACTED 2
+
+/*
+ * CHArc - Arc of the remaining graph (or of the final hierarchy)
+ *
+ * middle is the contracted vertex a shortcut replaces, -1 for an
+ * original edge.
+ */
+typedef struct CHArc {
+    vertex_t vertex;
+    int weight;
+    vertex_t middle;
+} CHArc;
+
+typedef struct CHArcList {
+    CHArc *arcs;
+    vertex_t count;
+    vertex_t capacity;
+} CHArcList;
+
+/*
+ * CHShortcut - Shortcut u → w found while contracting a batch vertex
+ */
+typedef struct CHShortcut {
+    vertex_t from;
+    vertex_t to;
+    int weight;
+} CHShortcut;
+
+typedef struct CHShortcutList {
+    CHShortcut *items;
+    vertex_t count;
+    vertex_t capacity;
+} CHShortcutList;
+
+/*
+ * CHBuilder - Preprocessing state shared by all threads
+ *
+ * out/in hold the remaining graph; when v is contracted its two lists
+ * are kept as v's final upward / downward arcs (all remaining neighbors
+ * are contracted later, so they rank higher).
+ */
+typedef struct CHBuilder {
+    vertex_t num_vertices;
+    CHArcList *out;
+    CHArcList *in;
+    uint8_t *state;
+    int *priority;
+    int *deleted;
+    int *level;
+    CHShortcutList *pending;   /* One list per vertex of the current batch */
+} CHBuilder;
+
+/* What a worker thread does with its share of the items */
+typedef enum CHTaskKind {
+    CH_TASK_PRIORITY,
+    CH_TASK_CONTRACT
+} CHTaskKind;
+
+typedef struct CHTask {
+    CHBuilder *builder;
+    DijkstraWorkspace *ws;
+    CHTaskKind kind;
+    const vertex_t *items;
+    vertex_t count;
+    int first;
+    int stride;
+    bool out_of_memory;
+} CHTask;
+
+/*====================================================================
+ * ARC LISTS
+ *====================================================================*/
+
+static bool arc_list_push(CHArcList *list, vertex_t vertex, int weight, vertex_t middle) {
+    if (list->count == list->capacity) {
+        vertex_t capacity = (list->capacity == 0) ? 4 : list->capacity * 2;
+        CHArc *arcs = (CHArc *)realloc(list->arcs, (size_t)capacity * sizeof(CHArc));
+        if (arcs == NULL) return false;
+        list->arcs = arcs;
+        list->capacity = capacity;
+    }
+    list->arcs[list->count].vertex = vertex;
+    list->arcs[list->count].weight = weight;
+    list->arcs[list->count].middle = middle;
+    list->count++;
+    return true;
+}
+
+/*
+ * arc_list_upsert - Adds an arc, or lowers the weight of an existing one
+ *
+ * Return: false only on allocation failure
+ */
+static bool arc_list_upsert(CHArcList *list, vertex_t vertex, int weight, vertex_t middle) {
+    for (vertex_t i = 0; i < list->count; i++) {
+        if (list->arcs[i].vertex == vertex) {
+            if (weight < list->arcs[i].weight) {
+                list->arcs[i].weight = weight;
+                list->arcs[i].middle = middle;
+            }
+            return true;
+        }
+    }
+    return arc_list_push(list, vertex, weight, middle);
+}
+
+static void arc_list_remove(CHArcList *list, vertex_t vertex) {
+    for (vertex_t i = 0; i < list->count; i++) {
+        if (list->arcs[i].vertex == vertex) {
+            list->arcs[i] = list->arcs[--list->count];
+            return;
+        }
+    }
+}
+
+static bool shortcut_list_push(CHShortcutList *list, vertex_t from, vertex_t to, int weight) {
+    if (list->count == list->capacity) {
+        vertex_t capacity = (list->capacity == 0) ? 8 : list->capacity * 2;
+        CHShortcut *items = (CHShortcut *)realloc(list->items,
+                                                  (size_t)capacity * sizeof(CHShortcut));
+        if (items == NULL) return false;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count].from = from;
+    list->items[list->count].to = to;
+    list->items[list->count].weight = weight;
+    list->count++;
+    return true;
+}
+
+/*====================================================================
+ * WITNESS SEARCH AND PRIORITIES
+ *====================================================================*/
+
+/*
+ * witness_search - Bounded Dijkstra from @source in the remaining graph
+ *
+ * @avoid:        The vertex being contracted
+ * @limit:        Stop once the smallest key exceeds this distance
+ * @settle_limit: Stop after this many settled vertices
+ *
+ * Stopping early only means fewer witnesses are found, i.e. some
+ * unnecessary shortcuts get added; distances stay correct.
+ */
+static void witness_search(const CHBuilder *b, DijkstraWorkspace *ws, vertex_t source,
+                           vertex_t avoid, int limit, int settle_limit) {
+    DaryHeap *heap = &ws->heap;
+    int settled = 0;
+
+    ws_begin_query(ws, source);
+    ws_set(ws, source, 0, -1);
+    heap_push(heap, source, 0);
+
+    while (!heap_empty(heap)) {
+        HeapEntry top = heap_pop(heap);
+        if (top.key > limit || ++settled > settle_limit) break;
+
+        const CHArcList *arcs = &b->out[top.vertex];
+        for (vertex_t i = 0; i < arcs->count; i++) {
+            vertex_t x = arcs->arcs[i].vertex;
+            if (x == avoid || b->state[x] != CH_ACTIVE) continue;
+
+            int candidate = dist_add(top.key, arcs->arcs[i].weight);
+            if (candidate < ws_distance(ws, x)) {
+                ws_set(ws, x, candidate, top.vertex);
+                if (heap_contains(heap, x)) {
+                    heap_decrease_key(heap, x, candidate);
+                } else {
+                    heap_push(heap, x, candidate);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * simulate_contraction - Shortcuts needed if @v were contracted now
+ *
+ * @out: Receives the shortcuts, or NULL to only count them
+ *
+ * Return: Number of shortcuts, or -1 on allocation failure
+ */
+static vertex_t simulate_contraction(const CHBuilder *b, DijkstraWorkspace *ws, vertex_t v,
+                                     int settle_limit, CHShortcutList *out) {
+    const CHArcList *in = &b->in[v];
+    const CHArcList *outgoing = &b->out[v];
+    vertex_t count = 0;
+
+    for (vertex_t i = 0; i < in->count; i++) {
+        vertex_t u = in->arcs[i].vertex;
+        int to_v = in->arcs[i].weight;
+
+        /* Paths of INF or more are never shortest: no shortcut, no witness */
+        int limit = -1;
+        for (vertex_t j = 0; j < outgoing->count; j++) {
+            int via = dist_add(to_v, outgoing->arcs[j].weight);
+            if (outgoing->arcs[j].vertex != u && via != INF && via > limit) limit = via;
+        }
+        if (limit < 0) continue;
+
+        witness_search(b, ws, u, v, limit, settle_limit);
+
+        for (vertex_t j = 0; j < outgoing->count; j++) {
+            vertex_t w = outgoing->arcs[j].vertex;
+            int via = dist_add(to_v, outgoing->arcs[j].weight);
+            if (w == u || via == INF || ws_distance(ws, w) <= via) continue;
+
+            count++;
+            if (out != NULL && !shortcut_list_push(out, u, w, via)) return -1;
+        }
+    }
+    return count;
+}
+
+static void update_priority(CHBuilder *b, DijkstraWorkspace *ws, vertex_t v) {
+    vertex_t shortcuts = simulate_contraction(b, ws, v, CH_PRIORITY_SETTLE_LIMIT, NULL);
+    vertex_t removed = b->in[v].count + b->out[v].count;
+    b->priority[v] = 2 * (int)(shortcuts - removed) + b->deleted[v] + b->level[v];
+}
+
+/*
+ * contracts_before - Total order on (priority, scrambled id)
+ *
+ * Scrambling the id breaks ties without the row-by-row bias plain ids
+ * would give on grid-like graphs.
+ */
+static bool contracts_before(const CHBuilder *b, vertex_t v, vertex_t x) {
+    if (b->priority[v] != b->priority[x]) return b->priority[v] < b->priority[x];
+    uint64_t hv = (uint64_t)v * 0x9E3779B97F4A7C15ULL;
+    uint64_t hx = (uint64_t)x * 0x9E3779B97F4A7C15ULL;
+    return (hv != hx) ? hv < hx : v < x;
+}
+
+/*====================================================================
+ * PARALLEL ROUNDS
+ *====================================================================*/
+
+static void *ch_worker(void *arg) {
+    CHTask *task = (CHTask *)arg;
+    CHBuilder *b = task->builder;
+
+    for (vertex_t i = task->first; i < task->count; i += task->stride) {
+        vertex_t v = task->items[i];
+        if (task->kind == CH_TASK_PRIORITY) {
+            update_priority(b, task->ws, v);
+        } else if (simulate_contraction(b, task->ws, v, CH_WITNESS_SETTLE_LIMIT,
+                                        &b->pending[i]) < 0) {
+            task->out_of_memory = true;
+            break;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * run_parallel - Runs one kind of task over @items on all threads
+ *
+ * Return: false on allocation failure in a worker
+ */
+static bool run_parallel(CHTask *tasks, int num_threads,
+                         CHTaskKind kind, const vertex_t *items, vertex_t count) {
+    int used = (count < num_threads) ? (int)count : num_threads;
+    bool ok = true;
+
+    for (int t = 0; t < used; t++) {
+        tasks[t].kind = kind;
+        tasks[t].items = items;
+        tasks[t].count = count;
+        tasks[t].first = t;
+        tasks[t].stride = used;
+        tasks[t].out_of_memory = false;
+    }
+    run_tasks(ch_worker, tasks, sizeof(CHTask), used);
+    for (int t = 0; t < used; t++) {
+        if (tasks[t].out_of_memory) ok = false;
+    }
+    return ok;
+}
+
+/*
+ * contract_vertex - Removes @v from the remaining graph and adds its shortcuts
+ *
+ * @touched / @num_touched: Collects neighbors whose priority must be
+ *                          refreshed (marked in @mark)
+ *
+ * Return: false on allocation failure
+ */
+static bool contract_vertex(CHBuilder *b, vertex_t v, const CHShortcutList *shortcuts,
+                            vertex_t *touched, vertex_t *num_touched, bool *mark) {
+    CHArcList *lists[2] = { &b->out[v], &b->in[v] };
+
+    for (int side = 0; side < 2; side++) {
+        for (vertex_t i = 0; i < lists[side]->count; i++) {
+            vertex_t x = lists[side]->arcs[i].vertex;
+            arc_list_remove(side == 0 ? &b->in[x] : &b->out[x], v);
+            b->deleted[x]++;
+            if (b->level[v] + 1 > b->level[x]) b->level[x] = b->level[v] + 1;
+            if (!mark[x]) {
+                mark[x] = true;
+                touched[(*num_touched)++] = x;
+            }
+        }
+    }
+
+    for (vertex_t i = 0; i < shortcuts->count; i++) {
+        const CHShortcut *s = &shortcuts->items[i];
+        if (!arc_list_upsert(&b->out[s->from], s->to, s->weight, v) ||
+            !arc_list_upsert(&b->in[s->to], s->from, s->weight, v)) {
+            return false;
+        }
+    }
+
+    b->state[v] = CH_CONTRACTED;
+    return true;
+}
+
+/*====================================================================
+ * PREPROCESSING
+ *====================================================================*/
+
+/*
+ * flatten - Turns the per-vertex final arc lists into one CSR
+ */
+static bool flatten(const CHArcList *lists, vertex_t n, edge_t **offsets,
+                    vertex_t **vertices, int **weights, vertex_t **middles,
+                    edge_t *num_shortcuts) {
+    edge_t total = 0;
+    for (vertex_t v = 0; v < n; v++) total += lists[v].count;
+
+    *offsets = (edge_t *)malloc(((size_t)n + 1) * sizeof(edge_t));
+    *vertices = (vertex_t *)malloc(((size_t)total + 1) * sizeof(vertex_t));
+    *weights = (int *)malloc(((size_t)total + 1) * sizeof(int));
+    *middles = (vertex_t *)malloc(((size_t)total + 1) * sizeof(vertex_t));
+    if (*offsets == NULL || *vertices == NULL || *weights == NULL || *middles == NULL) {
+        return false;
+    }
+
+    edge_t k = 0;
+    for (vertex_t v = 0; v < n; v++) {
+        (*offsets)[v] = k;
+        for (vertex_t i = 0; i < lists[v].count; i++, k++) {
+            (*vertices)[k] = lists[v].arcs[i].vertex;
+            (*weights)[k] = lists[v].arcs[i].weight;
+            (*middles)[k] = lists[v].arcs[i].middle;
+            if (lists[v].arcs[i].middle >= 0) (*num_shortcuts)++;
+        }
+    }
+    (*offsets)[n] = k;
+    return true;
+}
+
+/*
+ * build_contraction_hierarchy - Contracts a graph for fast s-t queries
+ *
+ * @g:           Graph (parallel edges are merged, self-loops dropped)
+ * @num_threads: Witness-search threads (see thread_count())
+ *
+ * Time Complexity: Roughly O(V * witness search cost) on road-like
+ *                  graphs; dense or expander-like graphs can produce
+ *                  many shortcuts and take far longer
+ *
+ * Return: Hierarchy, or NULL on failure
+ *         Caller must call free_contraction_hierarchy()!
+ */
+ContractionHierarchy *build_contraction_hierarchy(const CSRGraph *g, int num_threads) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph in build_contraction_hierarchy()\n");
+        return NULL;
+    }
+    num_threads = thread_count(num_threads, TASK_MAX_THREADS);
+
+    vertex_t n = g->num_vertices;
+    size_t slots = (size_t)n + 1;
+    CHBuilder b;
+    b.num_vertices = n;
+    b.out = (CHArcList *)calloc(slots, sizeof(CHArcList));
+    b.in = (CHArcList *)calloc(slots, sizeof(CHArcList));
+    b.state = (uint8_t *)calloc(slots, sizeof(uint8_t));
+    b.priority = (int *)calloc(slots, sizeof(int));
+    b.deleted = (int *)calloc(slots, sizeof(int));
+    b.level = (int *)calloc(slots, sizeof(int));
+    b.pending = (CHShortcutList *)calloc(slots, sizeof(CHShortcutList));
+
+    vertex_t *order = (vertex_t *)malloc(slots * sizeof(vertex_t));
+    vertex_t *batch = (vertex_t *)malloc(slots * sizeof(vertex_t));
+    vertex_t *touched = (vertex_t *)malloc(slots * sizeof(vertex_t));
+    bool *mark = (bool *)calloc(slots, sizeof(bool));
+    CHTask *tasks = (CHTask *)calloc((size_t)num_threads, sizeof(CHTask));
+    ContractionHierarchy *ch = (ContractionHierarchy *)calloc(1, sizeof(ContractionHierarchy));
+
+    bool ok = b.out != NULL && b.in != NULL && b.state != NULL && b.priority != NULL &&
+              b.deleted != NULL && b.level != NULL && b.pending != NULL && order != NULL &&
+              batch != NULL && touched != NULL && mark != NULL && tasks != NULL &&
+              ch != NULL;
+
+    for (int t = 0; ok && t < num_threads; t++) {
+        tasks[t].builder = &b;
+        tasks[t].ws = create_workspace(n);
+        if (tasks[t].ws == NULL) ok = false;
+    }
+
+    /* Remaining graph = input without self-loops, parallel edges merged */
+    for (vertex_t u = 0; ok && u < n; u++) {
+        for (edge_t i = g->offsets[u]; i < g->offsets[u + 1]; i++) {
+            vertex_t v = g->destinations[i];
+            if (v == u) continue;
+            if (!arc_list_upsert(&b.out[u], v, g->weights[i], -1) ||
+                !arc_list_upsert(&b.in[v], u, g->weights[i], -1)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    /* Initial priorities */
+    vertex_t remaining = n;
+    for (vertex_t v = 0; v < n && ok; v++) order[v] = v;
+    ok = ok && run_parallel(tasks, num_threads, CH_TASK_PRIORITY, order, remaining);
+
+    vertex_t next_rank = 0;
+    if (ok) {
+        ch->rank = (vertex_t *)malloc(slots * sizeof(vertex_t));
+        ok = ch->rank != NULL;
+    }
+
+    while (ok && remaining > 0) {
+        /* Independent set: local priority minima among the remaining vertices */
+        vertex_t batch_size = 0;
+        for (vertex_t j = 0; j < remaining; j++) {
+            vertex_t v = order[j];
+            bool minimum = true;
+            for (int side = 0; side < 2 && minimum; side++) {
+                const CHArcList *arcs = (side == 0) ? &b.out[v] : &b.in[v];
+                for (vertex_t i = 0; i < arcs->count; i++) {
+                    if (!contracts_before(&b, v, arcs->arcs[i].vertex)) {
+                        minimum = false;
+                        break;
+                    }
+                }
+            }
+            if (minimum) {
+                batch[batch_size++] = v;
+                b.state[v] = CH_BATCH;
+            }
+        }
+
+        ok = run_parallel(tasks, num_threads, CH_TASK_CONTRACT, batch, batch_size);
+
+        vertex_t num_touched = 0;
+        for (vertex_t j = 0; ok && j < batch_size; j++) {
+            vertex_t v = batch[j];
+            ch->rank[v] = next_rank++;
+            ok = contract_vertex(&b, v, &b.pending[j], touched, &num_touched, mark);
+            b.pending[j].count = 0;
+        }
+
+        /* Compact the remaining vertices; refresh neighbor priorities */
+        vertex_t kept = 0;
+        for (vertex_t j = 0; j < remaining; j++) {
+            if (b.state[order[j]] == CH_ACTIVE) order[kept++] = order[j];
+        }
+        remaining = kept;
+
+        vertex_t active = 0;
+        for (vertex_t j = 0; j < num_touched; j++) {
+            mark[touched[j]] = false;
+            if (b.state[touched[j]] == CH_ACTIVE) touched[active++] = touched[j];
+        }
+        ok = ok && run_parallel(tasks, num_threads, CH_TASK_PRIORITY, touched, active);
+    }
+
+    if (ok) {
+        ch->num_vertices = n;
+        ok = flatten(b.out, n, &ch->up_offsets, &ch->up_heads, &ch->up_weights,
+                     &ch->up_middles, &ch->num_shortcuts) &&
+             flatten(b.in, n, &ch->down_offsets, &ch->down_tails, &ch->down_weights,
+                     &ch->down_middles, &ch->num_shortcuts);
+        if (ok) ch->num_arcs = ch->up_offsets[n] + ch->down_offsets[n];
+    }
+
+    for (vertex_t v = 0; v < n; v++) {
+        if (b.out != NULL) free(b.out[v].arcs);
+        if (b.in != NULL) free(b.in[v].arcs);
+        if (b.pending != NULL) free(b.pending[v].items);
+    }
+    for (int t = 0; tasks != NULL && t < num_threads; t++) {
+        free_workspace(tasks[t].ws);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.state);
+    free(b.priority);
+    free(b.deleted);
+    free(b.level);
+    free(b.pending);
+    free(order);
+    free(batch);
+    free(touched);
+    free(mark);
+    free(tasks);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed in build_contraction_hierarchy()\n");
+        free_contraction_hierarchy(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+/*
+ * free_contraction_hierarchy - Releases a hierarchy
+ */
+void free_contraction_hierarchy(ContractionHierarchy *ch) {
+    if (ch == NULL) return;
+    free(ch->rank);
+    free(ch->up_offsets);
+    free(ch->up_heads);
+    free(ch->up_weights);
+    free(ch->up_middles);
+    free(ch->down_offsets);
+    free(ch->down_tails);
+    free(ch->down_weights);
+    free(ch->down_middles);
+    free(ch);
+}
+
+/*====================================================================
+ * QUERIES
+ *====================================================================*/
+
+/*
+ * upward_step - Settles one vertex of the forward or backward search
+ *
+ * Stall-on-demand: if some higher neighbor x already reaches u more
+ * cheaply than u's own label (through an arc x → u for the forward
+ * search), u cannot be on a shortest up-down path and is not expanded.
+ */
+static void upward_step(DijkstraWorkspace *self, const DijkstraWorkspace *other,
+                        const edge_t *offsets, const vertex_t *neighbors, const int *weights,
+                        const edge_t *stall_offsets, const vertex_t *stall_neighbors,
+                        const int *stall_weights, int64_t *best, vertex_t *meeting) {
+    DaryHeap *heap = &self->heap;
+    DijkstraStats *stats = &self->stats;
+
+    vertex_t u = heap_pop(heap).vertex;
+    int du = self->distance[u];
+    stats->heap_pops++;
+    stats->vertices_settled++;
+
+    if (ws_touched(other, u) && (int64_t)du + other->distance[u] < *best) {
+        *best = (int64_t)du + other->distance[u];
+        *meeting = u;
+    }
+
+    for (edge_t i = stall_offsets[u]; i < stall_offsets[u + 1]; i++) {
+        vertex_t x = stall_neighbors[i];
+        if (ws_touched(self, x) && (int64_t)self->distance[x] + stall_weights[i] < du) {
+            return;
+        }
+    }
+
+    edge_t end = offsets[u + 1];
+    stats->edges_scanned += (uint64_t)(end - offsets[u]);
+    for (edge_t i = offsets[u]; i < end; i++) {
+        vertex_t v = neighbors[i];
+        int candidate = dist_add(du, weights[i]);
+        if (candidate < ws_distance(self, v)) {
+            ws_set(self, v, candidate, u);
+            stats->relaxations++;
+
+            if (heap_contains(heap, v)) {
+                heap_decrease_key(heap, v, candidate);
+                stats->heap_decrease_keys++;
+            } else {
+                heap_push(heap, v, candidate);
+                stats->heap_pushes++;
+                if ((uint64_t)heap->size > stats->max_heap_size) {
+                    stats->max_heap_size = (uint64_t)heap->size;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * ch_search - Bidirectional upward search
+ *
+ * The forward search scans up-arcs of u; the backward search scans
+ * down-arcs stored at u (tails rank higher). For stalling, each side
+ * looks at the arcs of the opposite kind at u.
+ *
+ * @distance: Receives the distance (INF if unreachable)
+ * @meeting:  Receives the highest vertex of the path (-1 if unreachable)
+ *
+ * Return: false on invalid input
+ */
+static bool ch_search(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                      const ContractionHierarchy *ch, vertex_t source, vertex_t target,
+                      int *distance, vertex_t *meeting, const char *caller) {
+    *distance = INF;
+    *meeting = -1;
+    if (forward == NULL || backward == NULL || forward == backward || ch == NULL ||
+        source < 0 || source >= ch->num_vertices ||
+        target < 0 || target >= ch->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to %s()\n", caller);
+        return false;
+    }
+    if (ch->num_vertices > forward->capacity || ch->num_vertices > backward->capacity) {
+        fprintf(stderr, "Error: Graph has %" PRIdVERTEX " vertices, workspace is too small\n",
+                ch->num_vertices);
+        return false;
+    }
+
+    ws_begin_query(forward, source);
+    ws_begin_query(backward, target);
+    ws_set(forward, source, 0, -1);
+    heap_push(&forward->heap, source, 0);
+    ws_set(backward, target, 0, -1);
+    heap_push(&backward->heap, target, 0);
+    forward->stats.heap_pushes = backward->stats.heap_pushes = 1;
+    forward->stats.max_heap_size = backward->stats.max_heap_size = 1;
+
+    int64_t best = INF;
+
+    /*
+     * Unlike plain bidirectional search, top_f + top_b >= best does not
+     * end the query: the upward searches do not grow balls of the
+     * original graph. Each side stops once its own top key reaches best.
+     */
+    for (;;) {
+        bool f_live = !heap_empty(&forward->heap) &&
+                      heap_top_key(&forward->heap) < best;
+        bool b_live = !heap_empty(&backward->heap) &&
+                      heap_top_key(&backward->heap) < best;
+        if (!f_live && !b_live) break;
+
+        if (f_live && (!b_live ||
+                       heap_top_key(&forward->heap) <= heap_top_key(&backward->heap))) {
+            upward_step(forward, backward, ch->up_offsets, ch->up_heads, ch->up_weights,
+                        ch->down_offsets, ch->down_tails, ch->down_weights, &best, meeting);
+        } else {
+            upward_step(backward, forward, ch->down_offsets, ch->down_tails, ch->down_weights,
+                        ch->up_offsets, ch->up_heads, ch->up_weights, &best, meeting);
+        }
+    }
+
+    if (*meeting >= 0) *distance = (int)best;
+    return true;
+}
+
+/*
+ * ch_distance - Shortest distance from a contraction hierarchy
+ *
+ * @forward:  Workspace for the upward search from @source
+ * @backward: Workspace for the upward search from @target (a different one)
+ * @ch:       Hierarchy from build_contraction_hierarchy()
+ *
+ * Time Complexity: O(C log C) for the C vertices of the two upper
+ *                  cones - typically hundreds, even for millions of V
+ *
+ * Return: Distance, or INF if unreachable (or on invalid input)
+ */
+int ch_distance(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                const ContractionHierarchy *ch, vertex_t source, vertex_t target) {
+    int distance;
+    vertex_t meeting;
+    ch_search(forward, backward, ch, source, target, &distance, &meeting, "ch_distance");
+    return distance;
+}
+
+/*
+ * find_arc - Index of the hierarchy arc a → b and whether it is an up-arc
+ *
+ * An arc is stored at its lower-ranked endpoint.
+ */
+static edge_t find_arc(const ContractionHierarchy *ch, vertex_t a, vertex_t b, bool *up) {
+    *up = ch->rank[a] < ch->rank[b];
+    edge_t best = -1;
+    if (*up) {
+        for (edge_t i = ch->up_offsets[a]; i < ch->up_offsets[a + 1]; i++) {
+            if (ch->up_heads[i] == b && (best < 0 || ch->up_weights[i] < ch->up_weights[best])) {
+                best = i;
+            }
+        }
+    } else {
+        for (edge_t i = ch->down_offsets[b]; i < ch->down_offsets[b + 1]; i++) {
+            if (ch->down_tails[i] == a &&
+                (best < 0 || ch->down_weights[i] < ch->down_weights[best])) {
+                best = i;
+            }
+        }
+    }
+    return best;
+}
+
+/*
+ * PathBuffer - Growable vertex array for unpacking
+ */
+typedef struct PathBuffer {
+    vertex_t *items;
+    vertex_t count;
+    vertex_t capacity;
+} PathBuffer;
+
+static bool path_push(PathBuffer *p, vertex_t v) {
+    if (p->count == p->capacity) {
+        vertex_t capacity = (p->capacity == 0) ? 64 : p->capacity * 2;
+        vertex_t *items = (vertex_t *)realloc(p->items, (size_t)capacity * sizeof(vertex_t));
+        if (items == NULL) return false;
+        p->items = items;
+        p->capacity = capacity;
+    }
+    p->items[p->count++] = v;
+    return true;
+}
+
+/*
+ * unpack_arc - Appends the original path of hierarchy arc a → b (minus a)
+ *
+ * A shortcut a → b via m expands to a → m and m → b; m ranks below both,
+ * so both are arcs stored at m. An explicit stack keeps deep hierarchies
+ * from overflowing the call stack.
+ */
+static bool unpack_arc(const ContractionHierarchy *ch, vertex_t a, vertex_t b,
+                       PathBuffer *out, PathBuffer *stack) {
+    stack->count = 0;
+    if (!path_push(stack, a) || !path_push(stack, b)) return false;
+
+    while (stack->count > 0) {
+        vertex_t to = stack->items[--stack->count];
+        vertex_t from = stack->items[--stack->count];
+        bool up;
+        edge_t i = find_arc(ch, from, to, &up);
+        vertex_t middle = (i < 0) ? -1 : (up ? ch->up_middles[i] : ch->down_middles[i]);
+
+        if (middle < 0) {
+            if (!path_push(out, to)) return false;
+        } else if (!path_push(stack, middle) || !path_push(stack, to) ||
+                   !path_push(stack, from) || !path_push(stack, middle)) {
+            return false;   /* (from, middle) is on top, so it is emitted first */
+        }
+    }
+    return true;
+}
+
+/*
+ * ch_shortest_path - Shortest path from a contraction hierarchy
+ *
+ * Same search as ch_distance(), then every shortcut on the up-down path
+ * is unpacked into original edges, so the result lists the same kind of
+ * vertex sequence get_path() returns for dijkstra().
+ *
+ * Time Complexity: O(C log C + path length * degree)
+ *
+ * Return: ShortestPath (distance INF if unreachable; stats are the sum
+ *         of both sides), or NULL on invalid input / allocation failure
+ *         Caller must call free_shortest_path()!
+ */
+ShortestPath *ch_shortest_path(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                               const ContractionHierarchy *ch, vertex_t source, vertex_t target) {
+    int distance;
+    vertex_t meeting;
+    if (!ch_search(forward, backward, ch, source, target, &distance, &meeting,
+                   "ch_shortest_path")) {
+        return NULL;
+    }
+
+    ShortestPath *sp = (ShortestPath *)malloc(sizeof(ShortestPath));
+    if (sp == NULL) return NULL;
+
+    sp->source = source;
+    sp->target = target;
+    sp->distance = distance;
+    sp->vertices = NULL;
+    sp->length = 0;
+
+    const DijkstraStats *f = &forward->stats;
+    const DijkstraStats *b = &backward->stats;
+    sp->stats.vertices_settled = f->vertices_settled + b->vertices_settled;
+    sp->stats.edges_scanned = f->edges_scanned + b->edges_scanned;
+    sp->stats.relaxations = f->relaxations + b->relaxations;
+    sp->stats.heap_pushes = f->heap_pushes + b->heap_pushes;
+    sp->stats.heap_decrease_keys = f->heap_decrease_keys + b->heap_decrease_keys;
+    sp->stats.heap_pops = f->heap_pops + b->heap_pops;
+    sp->stats.max_heap_size = f->max_heap_size + b->max_heap_size;
+    if (meeting < 0) return sp;
+
+    /* Hierarchy path: source ... meeting (forward tree), then down to target */
+    PathBuffer up = { NULL, 0, 0 };
+    PathBuffer out = { NULL, 0, 0 };
+    PathBuffer stack = { NULL, 0, 0 };
+    bool ok = true;
+
+    for (vertex_t x = meeting; x != -1 && ok; x = forward->parent[x]) ok = path_push(&up, x);
+    ok = ok && path_push(&out, source);
+    for (vertex_t i = up.count - 1; i > 0 && ok; i--) {
+        ok = unpack_arc(ch, up.items[i], up.items[i - 1], &out, &stack);
+    }
+    for (vertex_t x = meeting; x != target && ok; x = backward->parent[x]) {
+        ok = unpack_arc(ch, x, backward->parent[x], &out, &stack);
+    }
+
+    free(up.items);
+    free(stack.items);
+    if (!ok) {
+        free(out.items);
+        free(sp);
+        return NULL;
+    }
+    sp->vertices = out.items;
+    sp->length = out.count;
+    return sp;
+}
@@ -0,0 +1,390 @@
+/*
+ * csr.c - Frozen Compressed Sparse Row (CSR) Graph
+ *
+ * The adjacency-list Graph is convenient while a graph is being built,
+ * but every relaxation has to chase an Edge pointer to a random heap
+ * address. Once construction is finished we "freeze" the graph into
+ * three flat arrays:
+ *
+ *   offsets:      V+1 entries, edges of u live in [offsets[u], offsets[u+1])
+ *   destinations: E entries, target vertex of each edge
+ *   weights:      E entries, weight of each edge
+ *
+ * Memory Layout:
+ *
+ *   offsets       ┌───┬───┬───┬───┐
+ *                 │ 0 │ 2 │ 3 │ 3 │      (V = 3)
+ *                 └─┬─┴─┬─┴─┬─┴───┘
+ *                   │   │   └────────────┐
+ *                   v   v                v
+ *   destinations  ┌───┬───┬───┐
+ *                 │ 1 │ 2 │ 0 │          (E = 3)
+ *                 └───┴───┴───┘
+ *
+ * Scanning the neighbors of u becomes a sequential walk through two
+ * contiguous arrays, which the hardware prefetcher handles perfectly.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include <sys/mman.h>
+
+/*
+ * alloc_csr_graph - Allocates an empty CSR graph with room for n vertices
+ *                   and m edges
+ *
+ * Return: Pointer to CSR graph with uninitialized arrays, or NULL on failure
+ */
+static CSRGraph *alloc_csr_graph(vertex_t n, edge_t m) {
+    CSRGraph *csr = (CSRGraph *)malloc(sizeof(CSRGraph));
+    if (csr == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for CSR graph\n");
+        return NULL;
+    }
+
+    csr->num_vertices = n;
+    csr->num_edges = m;
+    csr->mapping = NULL;
+    csr->mapping_size = 0;
+    csr->reverse_offsets = NULL;
+    csr->reverse_sources = NULL;
+    csr->reverse_weights = NULL;
+    csr->coords = NULL;
+    csr->offsets = (edge_t *)malloc(((size_t)n + 1) * sizeof(edge_t));
+    /* +1 keeps malloc(0) from returning NULL on edgeless graphs */
+    csr->destinations = (vertex_t *)malloc(((size_t)m + 1) * sizeof(vertex_t));
+    csr->weights = (int *)malloc(((size_t)m + 1) * sizeof(int));
+
+    if (csr->offsets == NULL || csr->destinations == NULL || csr->weights == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for CSR arrays\n");
+        free_csr_graph(csr);
+        return NULL;
+    }
+    return csr;
+}
+
+/*
+ * freeze_graph - Builds an immutable CSR copy of an adjacency-list graph
+ *
+ * @g: Pointer to the graph (left unchanged, may be freed afterwards)
+ *
+ * Algorithm:
+ * 1. Count the out-degree of every vertex
+ * 2. Prefix-sum the degrees into the offsets array
+ * 3. Copy each adjacency list into its slot, preserving list order
+ * 4. Copy vertex coordinates, if the graph has any
+ *
+ * Edges keep the order of the linked list so that engines running on the
+ * CSR break ties exactly like the adjacency-list engines.
+ *
+ * Time Complexity:  O(V + E)
+ * Space Complexity: O(V + E)
+ *
+ * Return: Pointer to new CSR graph, or NULL on failure
+ *         Caller must call free_csr_graph()!
+ */
+CSRGraph *freeze_graph(Graph *g) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph in freeze_graph()\n");
+        return NULL;
+    }
+
+    vertex_t n = g->num_vertices;
+    CSRGraph *csr = alloc_csr_graph(n, g->num_edges);
+    if (csr == NULL) return NULL;
+
+    /* Pass 1 + 2: degrees and their prefix sum */
+    csr->offsets[0] = 0;
+    for (vertex_t u = 0; u < n; u++) {
+        edge_t degree = 0;
+        for (Edge *e = g->adj_list[u]; e != NULL; e = e->next) {
+            degree++;
+        }
+        csr->offsets[u + 1] = csr->offsets[u] + degree;
+    }
+
+    /* Pass 3: copy edges into their contiguous slots */
+    for (vertex_t u = 0; u < n; u++) {
+        edge_t i = csr->offsets[u];
+        for (Edge *e = g->adj_list[u]; e != NULL; e = e->next) {
+            csr->destinations[i] = e->destination;
+            csr->weights[i] = e->weight;
+            i++;
+        }
+    }
+
+    if (g->coords != NULL) {
+        csr->coords = (VertexCoord *)malloc(((size_t)n + 1) * sizeof(VertexCoord));
+        if (csr->coords == NULL) {
+            fprintf(stderr, "Error: Failed to allocate memory for CSR coordinates\n");
+            free_csr_graph(csr);
+            return NULL;
+        }
+        for (vertex_t u = 0; u < n; u++) {
+            csr->coords[u] = g->coords[u];
+        }
+    }
+
+    return csr;
+}
+
+/*
+ * build_csr_graph - Bulk-builds a CSR graph from edge buffers
+ *
+ * @num_vertices: |V|; every endpoint must lie in [0, num_vertices)
+ * @lists:        Array of edge buffers (e.g. one per parser thread)
+ * @num_lists:    Number of buffers
+ *
+ * Counting sort by source vertex:
+ * 1. offsets[u + 1] = out-degree of u
+ * 2. Prefix sum, so offsets[u] = first slot of u
+ * 3. Scatter each edge to offsets[u]++ (offsets[u] ends at start of u+1)
+ * 4. Shift offsets right by one to restore the starts
+ *
+ * Edges of the same source keep their buffer order (lists in order), and
+ * no temporary V- or E-sized array is needed beyond the CSR itself.
+ *
+ * Time Complexity:  O(V + E)
+ *
+ * Return: Pointer to new CSR graph, or NULL on failure
+ */
+CSRGraph *build_csr_graph(vertex_t num_vertices, const EdgeList *lists, int num_lists) {
+    if (num_vertices < 0 || (lists == NULL && num_lists > 0)) {
+        fprintf(stderr, "Error: Invalid input to build_csr_graph()\n");
+        return NULL;
+    }
+
+    /* Validate every endpoint once, up front */
+    edge_t m = 0;
+    for (int l = 0; l < num_lists; l++) {
+        const EdgeList *list = &lists[l];
+        for (edge_t i = 0; i < list->count; i++) {
+            if (list->sources[i] < 0 || list->sources[i] >= num_vertices ||
+                list->destinations[i] < 0 || list->destinations[i] >= num_vertices) {
+                fprintf(stderr, "Error: Edge (%" PRIdVERTEX ", %" PRIdVERTEX
+                        ") out of range [0, %" PRIdVERTEX ")\n",
+                        list->sources[i], list->destinations[i], num_vertices);
+                return NULL;
+            }
+        }
+        m += list->count;
+    }
+
+    CSRGraph *csr = alloc_csr_graph(num_vertices, m);
+    if (csr == NULL) return NULL;
+
+    edge_t *offsets = csr->offsets;
+    for (vertex_t u = 0; u <= num_vertices; u++) {
+        offsets[u] = 0;
+    }
+
+    /* Step 1: degrees */
+    for (int l = 0; l < num_lists; l++) {
+        for (edge_t i = 0; i < lists[l].count; i++) {
+            offsets[lists[l].sources[i] + 1]++;
+        }
+    }
+
+    /* Step 2: prefix sum */
+    for (vertex_t u = 0; u < num_vertices; u++) {
+        offsets[u + 1] += offsets[u];
+    }
+
+    /* Step 3: scatter */
+    for (int l = 0; l < num_lists; l++) {
+        const EdgeList *list = &lists[l];
+        for (edge_t i = 0; i < list->count; i++) {
+            edge_t slot = offsets[list->sources[i]]++;
+            csr->destinations[slot] = list->destinations[i];
+            csr->weights[slot] = list->weights[i];
+        }
+    }
+
+    /* Step 4: offsets[u] now holds the start of u+1 */
+    for (vertex_t u = num_vertices; u > 0; u--) {
+        offsets[u] = offsets[u - 1];
+    }
+    offsets[0] = 0;
+
+    return csr;
+}
+
+/*
+ * build_reverse_graph - Adds the transposed adjacency to a CSR graph
+ *
+ * @csr: Pointer to the CSR graph (heap-allocated or mapped)
+ *
+ * reverse_offsets / reverse_sources / reverse_weights list, for every
+ * vertex v, the edges (u → v) entering it, as a CSR over the transpose.
+ * Backward searches (e.g. dijkstra_bidirectional()) walk these exactly
+ * like forward searches walk offsets / destinations / weights.
+ *
+ * Same counting sort as build_csr_graph(), keyed by destination. Calling
+ * it again on a graph that already has a reverse adjacency is a no-op.
+ *
+ * Time Complexity:  O(V + E)
+ * Space Complexity: O(V + E) extra, freed by free_csr_graph()
+ *
+ * Return: true on success
+ */
+bool build_reverse_graph(CSRGraph *csr) {
+    if (csr == NULL) {
+        fprintf(stderr, "Error: NULL graph in build_reverse_graph()\n");
+        return false;
+    }
+    if (csr->reverse_offsets != NULL) return true;
+
+    vertex_t n = csr->num_vertices;
+    edge_t m = csr->num_edges;
+    edge_t *offsets = (edge_t *)calloc((size_t)n + 1, sizeof(edge_t));
+    vertex_t *sources = (vertex_t *)malloc(((size_t)m + 1) * sizeof(vertex_t));
+    int *weights = (int *)malloc(((size_t)m + 1) * sizeof(int));
+
+    if (offsets == NULL || sources == NULL || weights == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for reverse graph\n");
+        free(offsets);
+        free(sources);
+        free(weights);
+        return false;
+    }
+
+    /* Steps 1-2: in-degrees, prefix sum */
+    for (edge_t i = 0; i < m; i++) {
+        offsets[csr->destinations[i] + 1]++;
+    }
+    for (vertex_t v = 0; v < n; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    /* Step 3: scatter edges in source order */
+    for (vertex_t u = 0; u < n; u++) {
+        for (edge_t i = csr->offsets[u]; i < csr->offsets[u + 1]; i++) {
+            edge_t slot = offsets[csr->destinations[i]]++;
+            sources[slot] = u;
+            weights[slot] = csr->weights[i];
+        }
+    }
+
+    /* Step 4: restore the starts */
+    for (vertex_t v = n; v > 0; v--) {
+        offsets[v] = offsets[v - 1];
+    }
+    offsets[0] = 0;
+
+    csr->reverse_offsets = offsets;
+    csr->reverse_sources = sources;
+    csr->reverse_weights = weights;
+    return true;
+}
+
+/*
+ * max_edge_weight - Largest edge weight of a CSR graph
+ *
+ * @g: Pointer to the CSR graph
+ *
+ * The bucket engines (Dial, delta-stepping) size their buckets by it and
+ * need every weight to be >= 0, so both are answered in one pass.
+ *
+ * Time Complexity: O(E)
+ *
+ * Return: Largest weight (0 without edges), or -1 if any weight is negative
+ */
+int max_edge_weight(const CSRGraph *g) {
+    int max_weight = 0;
+    for (edge_t i = 0; i < g->num_edges; i++) {
+        if (g->weights[i] < 0) return -1;
+        if (g->weights[i] > max_weight) max_weight = g->weights[i];
+    }
+    return max_weight;
+}
+
+/*
+ * free_csr_graph - Deallocates a CSR graph
+ *
+ * Graphs loaded with map_csr_graph() are unmapped instead of freed; a
+ * reverse adjacency and coordinates are always heap-allocated and freed
+ * either way.
+ *
+ * Time Complexity: O(1) - a few flat arrays, no per-edge frees
+ */
+void free_csr_graph(CSRGraph *csr) {
+    if (csr == NULL) return;
+
+    free(csr->reverse_offsets);
+    free(csr->reverse_sources);
+    free(csr->reverse_weights);
+    free(csr->coords);
+
+    if (csr->mapping != NULL) {
+        munmap(csr->mapping, csr->mapping_size);
+        free(csr);
+        return;
+    }
+
+    free(csr->offsets);
+    free(csr->destinations);
+    free(csr->weights);
+    free(csr);
+}
+
+/*============================================================================
+ * EDGE LIST BUFFERS
+ *===========================================================================*/
+
+/*
+ * edge_list_init - Initializes an empty edge buffer (no allocation)
+ */
+void edge_list_init(EdgeList *list) {
+    list->sources = NULL;
+    list->destinations = NULL;
+    list->weights = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/*
+ * edge_list_append - Appends one edge, doubling the buffer when full
+ *
+ * Time Complexity: O(1) amortized
+ *
+ * Return: true on success, false if the buffer could not grow
+ */
+bool edge_list_append(EdgeList *list, vertex_t src, vertex_t dest, int weight) {
+    if (list->count == list->capacity) {
+        edge_t new_capacity = (list->capacity > 0) ? list->capacity * 2 : 1024;
+        vertex_t *sources = (vertex_t *)realloc(list->sources,
+                                                (size_t)new_capacity * sizeof(vertex_t));
+        if (sources == NULL) return false;
+        list->sources = sources;
+
+        vertex_t *destinations = (vertex_t *)realloc(list->destinations,
+                                                     (size_t)new_capacity * sizeof(vertex_t));
+        if (destinations == NULL) return false;
+        list->destinations = destinations;
+
+        int *weights = (int *)realloc(list->weights, (size_t)new_capacity * sizeof(int));
+        if (weights == NULL) return false;
+        list->weights = weights;
+
+        list->capacity = new_capacity;
+    }
+
+    list->sources[list->count] = src;
+    list->destinations[list->count] = dest;
+    list->weights[list->count] = weight;
+    list->count++;
+    return true;
+}
+
+/*
+ * edge_list_free - Releases the buffer's arrays and resets it to empty
+ */
+void edge_list_free(EdgeList *list) {
+    if (list == NULL) return;
+
+    free(list->sources);
+    free(list->destinations);
+    free(list->weights);
+    edge_list_init(list);
+}
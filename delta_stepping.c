@@ -0,0 +1,459 @@
+/*
+ * delta_stepping.c - Parallel Delta-Stepping (Meyer & Sanders)
+ *
+ * Dijkstra settles one vertex at a time, so a single query cannot use
+ * more than one core. Delta-stepping relaxes the order: vertices are
+ * grouped into buckets of width delta by tentative distance, and ALL
+ * vertices of the lowest bucket are processed at once, in parallel.
+ *
+ *   bucket:   0          1          2          3
+ *           [0, Δ)    [Δ, 2Δ)   [2Δ, 3Δ)   [3Δ, 4Δ)  ...
+ *
+ * Light and Heavy Edges:
+ *   A light edge (w < Δ) can move its head into the current bucket, so
+ *   the current bucket is relaxed over light edges repeatedly ("phases")
+ *   until it stays empty. A heavy edge (w >= Δ) always lands in a later
+ *   bucket, so heavy edges are relaxed once per vertex, after its bucket
+ *   has emptied and its distance is final.
+ *
+ *   Δ = 1 on integer weights is Dial's algorithm (one distance per
+ *   bucket); Δ = ∞ is parallel Bellman–Ford. In between, larger Δ means
+ *   more parallel work per phase but more re-relaxations.
+ *
+ * Parallel Relaxation:
+ *   A fixed team of threads works through each phase's frontier in
+ *   chunks and meets at a barrier between phases. Distance and parent
+ *   share one 64-bit word (distance high, parent low) that is lowered
+ *   with an atomic compare-and-swap, so the pair is always consistent.
+ *   Improved vertices go to per-thread buckets; thread 0 merges them into
+ *   the next frontier. As in dijkstra_dial(), buckets are a circular
+ *   array: all pending distances lie within max_weight of the current
+ *   bucket.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include "threads.h"
+#include <string.h>
+#include <pthread.h>
+
+#define DELTA_MAX_THREADS 64
+#define DELTA_CHUNK       64          /* Frontier entries a thread takes at a time */
+#define DELTA_MAX_BUCKETS (1 << 24)   /* Circular buckets: max_weight / delta + 2 */
+
+/* Distance in the high half, parent + 1 in the low half (0 = no parent) */
+#define DS_PACK(d, p) (((uint64_t)(uint32_t)(d) << 32) | (uint64_t)(uint32_t)((p) + 1))
+#define DS_DIST(s)    ((int)((s) >> 32))
+#define DS_PARENT(s)  ((vertex_t)((s) & 0xFFFFFFFFu) - 1)
+
+typedef struct VertexList {
+    vertex_t *items;
+    size_t count;
+    size_t capacity;
+} VertexList;
+
+/*
+ * DeltaWorker - Per-thread buckets, settled list and counters
+ */
+typedef struct DeltaWorker {
+    struct DeltaTeam *team;
+    int id;
+    pthread_t thread;
+    VertexList *buckets;   /* Circular, team->num_buckets entries */
+    VertexList settled;    /* Vertices whose heavy edges are still to relax */
+    DijkstraStats stats;
+} DeltaWorker;
+
+/*
+ * DeltaTeam - Shared search state
+ *
+ * Members:
+ *   state:       Packed (distance, parent) per vertex, updated atomically
+ *   light_done:  Distance at which a vertex's light edges were last
+ *                relaxed (-1 = never), so duplicates are skipped
+ *   frontier:    Vertices of the current phase; next_index hands out chunks
+ *   bucket:      Current bucket number
+ *   heavy:       Current phase relaxes heavy edges of settled vertices
+ *   lock, cond, size, arrived, generation: Barrier between phases
+ */
+typedef struct DeltaTeam {
+    const CSRGraph *graph;
+    int delta;
+    int num_buckets;
+    uint64_t *state;
+    int *light_done;
+
+    VertexList frontier;
+    size_t next_index;
+    int64_t bucket;
+    bool heavy;
+    bool done;
+    bool out_of_memory;
+
+    DeltaWorker *workers;
+    int num_workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int size;
+    int arrived;
+    uint64_t generation;
+} DeltaTeam;
+
+static bool vertex_list_push(VertexList *list, vertex_t v) {
+    if (list->count == list->capacity) {
+        size_t capacity = (list->capacity > 0) ? 2 * list->capacity : 64;
+        vertex_t *items = (vertex_t *)realloc(list->items, capacity * sizeof(vertex_t));
+        if (items == NULL) return false;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = v;
+    return true;
+}
+
+/*
+ * team_barrier - Waits until every thread of the team has arrived
+ *
+ * The size is read under the lock, so the team can shrink (failed
+ * pthread_create) while others are already waiting.
+ */
+static void team_barrier(DeltaTeam *team) {
+    pthread_mutex_lock(&team->lock);
+    uint64_t generation = team->generation;
+    if (++team->arrived >= team->size) {
+        team->arrived = 0;
+        team->generation++;
+        pthread_cond_broadcast(&team->cond);
+    } else {
+        while (generation == team->generation) {
+            pthread_cond_wait(&team->cond, &team->lock);
+        }
+    }
+    pthread_mutex_unlock(&team->lock);
+}
+
+/*
+ * relax - Lowers v's distance to @candidate via @u if that is shorter
+ *
+ * On success v goes into this thread's bucket for @candidate. A candidate
+ * saturated by dist_add() is INF and never passes the test, so it is
+ * never filed (its bucket index would be meaningless).
+ */
+static void relax(DeltaWorker *w, vertex_t u, vertex_t v, int candidate) {
+    DeltaTeam *team = w->team;
+    uint64_t old = __atomic_load_n(&team->state[v], __ATOMIC_RELAXED);
+    uint64_t packed = DS_PACK(candidate, u);
+
+    while (candidate < DS_DIST(old)) {
+        if (__atomic_compare_exchange_n(&team->state[v], &old, packed, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            w->stats.relaxations++;
+            int b = (int)((candidate / team->delta) % team->num_buckets);
+            if (!vertex_list_push(&w->buckets[b], v)) {
+                __atomic_store_n(&team->out_of_memory, true, __ATOMIC_RELAXED);
+            }
+            return;
+        }
+    }
+}
+
+/*
+ * process_frontier - Relaxes the current phase's edges for a share of the frontier
+ *
+ * Light phase: entries still in the current bucket relax their light
+ * edges (once per distance value) and are remembered as settled.
+ * Heavy phase: settled vertices relax their heavy edges.
+ */
+static void process_frontier(DeltaWorker *w) {
+    DeltaTeam *team = w->team;
+    const CSRGraph *g = team->graph;
+    int delta = team->delta;
+
+    for (;;) {
+        size_t begin = __atomic_fetch_add(&team->next_index, DELTA_CHUNK, __ATOMIC_RELAXED);
+        if (begin >= team->frontier.count) return;
+        size_t end = begin + DELTA_CHUNK;
+        if (end > team->frontier.count) end = team->frontier.count;
+
+        for (size_t i = begin; i < end; i++) {
+            vertex_t u = team->frontier.items[i];
+            int du = DS_DIST(__atomic_load_n(&team->state[u], __ATOMIC_RELAXED));
+
+            if (team->heavy) {
+                w->stats.vertices_settled++;
+                for (edge_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                    if (g->weights[e] < delta) continue;
+                    w->stats.edges_scanned++;
+                    relax(w, u, g->destinations[e], dist_add(du, g->weights[e]));
+                }
+                continue;
+            }
+
+            /* Stale (improved into an earlier bucket after being filed here),
+             * or light edges already relaxed at this distance */
+            if (du / delta != team->bucket) continue;
+            int previous = __atomic_exchange_n(&team->light_done[u], du, __ATOMIC_RELAXED);
+            if (previous == du) continue;
+            if (previous == -1 && !vertex_list_push(&w->settled, u)) {
+                __atomic_store_n(&team->out_of_memory, true, __ATOMIC_RELAXED);
+            }
+
+            for (edge_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                if (g->weights[e] >= delta) continue;
+                w->stats.edges_scanned++;
+                relax(w, u, g->destinations[e], dist_add(du, g->weights[e]));
+            }
+        }
+    }
+}
+
+/*
+ * gather - Moves every worker's list picked by @pick into the frontier
+ */
+static bool gather(DeltaTeam *team, VertexList *(*pick)(DeltaWorker *, int), int slot) {
+    size_t total = 0;
+    for (int t = 0; t < team->num_workers; t++) {
+        total += pick(&team->workers[t], slot)->count;
+    }
+    if (total > team->frontier.capacity) {
+        vertex_t *items = (vertex_t *)realloc(team->frontier.items, total * sizeof(vertex_t));
+        if (items == NULL) return false;
+        team->frontier.items = items;
+        team->frontier.capacity = total;
+    }
+
+    team->frontier.count = 0;
+    for (int t = 0; t < team->num_workers; t++) {
+        VertexList *list = pick(&team->workers[t], slot);
+        if (list->count > 0) {
+            memcpy(team->frontier.items + team->frontier.count, list->items,
+                   list->count * sizeof(vertex_t));
+        }
+        team->frontier.count += list->count;
+        list->count = 0;
+    }
+    return true;
+}
+
+static VertexList *pick_bucket(DeltaWorker *w, int slot) {
+    return &w->buckets[slot];
+}
+
+static VertexList *pick_settled(DeltaWorker *w, int slot) {
+    (void)slot;
+    return &w->settled;
+}
+
+/*
+ * advance - Sets up the next phase (thread 0, between barriers)
+ *
+ * Light phases repeat while the current bucket refills; then one heavy
+ * phase; then the next non-empty bucket, or done.
+ */
+static void advance(DeltaTeam *team) {
+    int slot = (int)(team->bucket % team->num_buckets);
+    bool ok = true;
+
+    team->next_index = 0;
+    if (team->out_of_memory) {
+        team->done = true;
+        return;
+    }
+
+    if (!team->heavy) {
+        size_t pending = 0;
+        for (int t = 0; t < team->num_workers; t++) {
+            pending += team->workers[t].buckets[slot].count;
+        }
+        if (pending > 0) {
+            ok = gather(team, pick_bucket, slot);
+        } else {
+            team->heavy = true;
+            ok = gather(team, pick_settled, 0);
+        }
+    } else {
+        team->heavy = false;
+        team->done = true;
+        for (int k = 1; k < team->num_buckets; k++) {
+            int next = (slot + k) % team->num_buckets;
+            for (int t = 0; t < team->num_workers && team->done; t++) {
+                if (team->workers[t].buckets[next].count > 0) team->done = false;
+            }
+            if (!team->done) {
+                team->bucket += k;
+                ok = gather(team, pick_bucket, next);
+                break;
+            }
+        }
+    }
+
+    if (!ok) {
+        team->out_of_memory = true;
+        team->done = true;
+    }
+}
+
+static void *delta_worker(void *arg) {
+    DeltaWorker *w = (DeltaWorker *)arg;
+    DeltaTeam *team = w->team;
+
+    for (;;) {
+        process_frontier(w);
+        team_barrier(team);
+        if (w->id == 0) advance(team);
+        team_barrier(team);
+        if (team->done) break;
+    }
+    return NULL;
+}
+
+/*
+ * default_delta - Bucket width when the caller passes delta <= 0
+ *
+ * Meyer & Sanders' choice for random weights: max_weight / average
+ * degree, so a vertex has about one light edge per unit of degree.
+ */
+static int default_delta(const CSRGraph *g, int max_weight) {
+    if (g->num_vertices == 0 || g->num_edges == 0) return 1;
+    double degree = (double)g->num_edges / (double)g->num_vertices;
+    int delta = (int)((double)max_weight / (degree > 1.0 ? degree : 1.0));
+    return (delta > 0) ? delta : 1;
+}
+
+/*
+ * dijkstra_delta - Single-source shortest paths by parallel delta-stepping
+ *
+ * @g:           Graph with non-negative weights
+ * @source:      Starting vertex
+ * @delta:       Bucket width; <= 0 picks max_weight / average degree
+ * @num_threads: Threads (see thread_count())
+ *
+ * Same result layout as dijkstra_heap_csr(). Distances are identical;
+ * among equally short paths the parent may differ between runs.
+ * Needs fewer than 2^32 - 1 vertices (parents are packed into 32 bits).
+ *
+ * Time Complexity: O(V + E + D/Δ · phases) work in total, where D is
+ *                  the largest distance; spread over the threads
+ * Space Complexity: O(V) shared plus O(max_weight / Δ) buckets per thread
+ *
+ * Return: DijkstraResult, or NULL on invalid input / allocation failure
+ */
+DijkstraResult *dijkstra_delta(const CSRGraph *g, vertex_t source, int delta, int num_threads) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_delta()\n");
+        return NULL;
+    }
+#ifdef DIJKSTRA_VERTEX_64
+    if ((uint64_t)g->num_vertices >= UINT32_MAX) {
+        fprintf(stderr, "Error: dijkstra_delta() supports fewer than 2^32 - 1 vertices\n");
+        return NULL;
+    }
+#endif
+
+    int max_weight = max_edge_weight(g);
+    if (max_weight < 0) {
+        fprintf(stderr, "Error: dijkstra_delta() needs non-negative weights\n");
+        return NULL;
+    }
+    if (delta <= 0) delta = default_delta(g, max_weight);
+    if ((int64_t)max_weight / delta + 2 > DELTA_MAX_BUCKETS) {
+        fprintf(stderr, "Error: delta %d is too small for weights up to %d\n",
+                delta, max_weight);
+        return NULL;
+    }
+    num_threads = thread_count(num_threads, DELTA_MAX_THREADS);
+
+    vertex_t n = g->num_vertices;
+    DeltaTeam team;
+    memset(&team, 0, sizeof(team));
+    team.graph = g;
+    team.delta = delta;
+    team.num_buckets = max_weight / delta + 2;
+    team.num_workers = num_threads;
+    team.size = num_threads;
+
+    DijkstraResult *result = create_result(n, source);
+    team.state = (uint64_t *)malloc((size_t)n * sizeof(uint64_t));
+    team.light_done = (int *)malloc((size_t)n * sizeof(int));
+    team.workers = (DeltaWorker *)calloc((size_t)num_threads, sizeof(DeltaWorker));
+    bool ok = result != NULL && team.state != NULL && team.light_done != NULL &&
+              team.workers != NULL;
+
+    for (int t = 0; ok && t < num_threads; t++) {
+        team.workers[t].team = &team;
+        team.workers[t].id = t;
+        team.workers[t].buckets = (VertexList *)calloc((size_t)team.num_buckets,
+                                                       sizeof(VertexList));
+        ok = team.workers[t].buckets != NULL;
+    }
+    ok = ok && vertex_list_push(&team.frontier, source);
+
+    if (ok) {
+        for (vertex_t v = 0; v < n; v++) {
+            team.state[v] = DS_PACK(INF, -1);
+            team.light_done[v] = -1;
+        }
+        team.state[source] = DS_PACK(0, -1);
+
+        pthread_mutex_init(&team.lock, NULL);
+        pthread_cond_init(&team.cond, NULL);
+
+        /* Thread 0 is the caller; a failed start shrinks the team */
+        int started = 1;
+        while (started < num_threads &&
+               pthread_create(&team.workers[started].thread, NULL, delta_worker,
+                              &team.workers[started]) == 0) {
+            started++;
+        }
+        if (started < num_threads) {
+            pthread_mutex_lock(&team.lock);
+            team.num_workers = team.size = started;
+            if (team.arrived >= team.size) {
+                team.arrived = 0;
+                team.generation++;
+                pthread_cond_broadcast(&team.cond);
+            }
+            pthread_mutex_unlock(&team.lock);
+        }
+
+        delta_worker(&team.workers[0]);
+        for (int t = 1; t < started; t++) {
+            pthread_join(team.workers[t].thread, NULL);
+        }
+        pthread_cond_destroy(&team.cond);
+        pthread_mutex_destroy(&team.lock);
+        ok = !team.out_of_memory;
+    }
+
+    if (ok) {
+        DijkstraStats *stats = &result->stats;
+        for (vertex_t v = 0; v < n; v++) {
+            result->distance[v] = DS_DIST(team.state[v]);
+            result->parent[v] = DS_PARENT(team.state[v]);
+        }
+        for (int t = 0; t < num_threads; t++) {
+            stats->vertices_settled += team.workers[t].stats.vertices_settled;
+            stats->edges_scanned += team.workers[t].stats.edges_scanned;
+            stats->relaxations += team.workers[t].stats.relaxations;
+        }
+    } else {
+        fprintf(stderr, "Error: Out of memory in dijkstra_delta()\n");
+        free_result(result);
+        result = NULL;
+    }
+
+    for (int t = 0; team.workers != NULL && t < num_threads; t++) {
+        for (int b = 0; team.workers[t].buckets != NULL && b < team.num_buckets; b++) {
+            free(team.workers[t].buckets[b].items);
+        }
+        free(team.workers[t].buckets);
+        free(team.workers[t].settled.items);
+    }
+    free(team.workers);
+    free(team.frontier.items);
+    free(team.state);
+    free(team.light_done);
+    return result;
+}
@@ -3,6 +3,7 @@
  * 
  * This file contains the core algorithm with two implementations:
  * 1. Array-based: O(V²) - simple, good for dense graphs
+ *    (plus a vectorized variant over a dense weight matrix)
  * 2. Heap-based:  O((V+E)logV) - optimized for sparse graphs
  * 
  * Mathematical Foundation:
@@ -21,6 +22,8 @@
  */
 
 #include "dijkstra.h"
+#include "heap.h"
+#include "simd.h"
 
 /*============================================================================
  * ARRAY-BASED IMPLEMENTATION
@@ -42,14 +45,16 @@
  * Called V times, each call is O(V), total: O(V²)
  * 
  * With a min-heap, this becomes O(log V), reducing total to O((V+E)log V)
+ * For dense graphs, dense_min_vertex() below keeps the O(V) scan but
+ * does it SIMD_LANES vertices at a time.
  * 
  * Return: Index of minimum distance unprocessed vertex, or -1 if none found
  */
-static int find_min_vertex(int *distance, bool *processed, int n) {
+static vertex_t find_min_vertex(int *distance, bool *processed, vertex_t n) {
     int min_distance = INF;
-    int min_vertex = -1;
+    vertex_t min_vertex = -1;
     
-    for (int v = 0; v < n; v++) {
+    for (vertex_t v = 0; v < n; v++) {
         /* Only consider unprocessed vertices */
         if (!processed[v] && distance[v] < min_distance) {
             min_distance = distance[v];
@@ -81,19 +86,19 @@ static int find_min_vertex(int *distance, bool *processed, int n) {
  * 
  * Return: DijkstraResult containing distances and parent pointers
  */
-DijkstraResult *dijkstra(Graph *g, int source) {
+DijkstraResult *dijkstra(Graph *g, vertex_t source) {
     /* Input validation */
     if (g == NULL) {
         fprintf(stderr, "Error: NULL graph in dijkstra()\n");
         return NULL;
     }
     if (source < 0 || source >= g->num_vertices) {
-        fprintf(stderr, "Error: Invalid source vertex %d (valid: 0 to %d)\n",
+        fprintf(stderr, "Error: Invalid source vertex %" PRIdVERTEX " (valid: 0 to %" PRIdVERTEX ")\n",
                 source, g->num_vertices - 1);
         return NULL;
     }
     
-    int n = g->num_vertices;
+    vertex_t n = g->num_vertices;
     
     /* Allocate result structure */
     DijkstraResult *result = (DijkstraResult *)malloc(sizeof(DijkstraResult));
@@ -102,8 +107,8 @@ DijkstraResult *dijkstra(Graph *g, int source) {
         return NULL;
     }
     
-    result->distance = (int *)malloc(n * sizeof(int));
-    result->parent = (int *)malloc(n * sizeof(int));
+    result->distance = (int *)malloc((size_t)n * sizeof(int));
+    result->parent = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
     bool *processed = (bool *)calloc(n, sizeof(bool));
     
     if (result->distance == NULL || result->parent == NULL || processed == NULL) {
@@ -117,6 +122,9 @@ DijkstraResult *dijkstra(Graph *g, int source) {
     
     result->source = source;
     result->num_vertices = n;
+    result->owner = NULL;
+    
+    DijkstraStats stats = {0};
     
     /*
      * PHASE 1: INITIALIZATION
@@ -126,9 +134,9 @@ DijkstraResult *dijkstra(Graph *g, int source) {
      *   d[v] = ∞        (all other vertices initially unreachable)
      *   parent[v] = -1  (no parent yet)
      */
-    printf("\n[DIJKSTRA] Initializing from source vertex %d...\n", source);
+    TRACE_PRINTF("\n[DIJKSTRA] Initializing from source vertex %" PRIdVERTEX "...\n", source);
     
-    for (int v = 0; v < n; v++) {
+    for (vertex_t v = 0; v < n; v++) {
         result->distance[v] = INF;  /* ∞ means unreachable */
         result->parent[v] = -1;     /* -1 means no parent */
     }
@@ -142,32 +150,34 @@ DijkstraResult *dijkstra(Graph *g, int source) {
      * 2. Mark it as processed (finalized)
      * 3. Relax all outgoing edges
      */
-    printf("[DIJKSTRA] Processing vertices...\n");
+    TRACE_PRINTF("[DIJKSTRA] Processing vertices...\n");
     
-    for (int iteration = 0; iteration < n; iteration++) {
+    for (vertex_t iteration = 0; iteration < n; iteration++) {
         /*
          * EXTRACT-MIN
          * Find vertex u with minimum d[u] among unprocessed vertices
          */
-        int u = find_min_vertex(result->distance, processed, n);
+        vertex_t u = find_min_vertex(result->distance, processed, n);
         
         /* If no reachable unprocessed vertex, graph has disconnected components */
         if (u == -1) {
-            printf("[DIJKSTRA] No more reachable vertices after %d iterations\n", iteration);
+            TRACE_PRINTF("[DIJKSTRA] No more reachable vertices after %" PRIdVERTEX " iterations\n",
+                         iteration);
             break;
         }
         
         /* If minimum distance is INF, remaining vertices are unreachable */
         if (result->distance[u] == INF) {
-            printf("[DIJKSTRA] Remaining vertices unreachable from source\n");
+            TRACE_PRINTF("[DIJKSTRA] Remaining vertices unreachable from source\n");
             break;
         }
         
         /* Mark u as processed - its distance is now finalized */
         processed[u] = true;
+        stats.vertices_settled++;
         
-        printf("  Iteration %d: Processing vertex %d (distance = %d)\n",
-               iteration + 1, u, result->distance[u]);
+        TRACE_PRINTF("  Iteration %" PRIdVERTEX ": Processing vertex %" PRIdVERTEX " (distance = %d)\n",
+                     iteration + 1, u, result->distance[u]);
         
         /*
          * RELAXATION
@@ -177,305 +187,619 @@ DijkstraResult *dijkstra(Graph *g, int source) {
          */
         Edge *edge = g->adj_list[u];
         while (edge != NULL) {
-            int v = edge->destination;
+            vertex_t v = edge->destination;
             int weight = edge->weight;
+            stats.edges_scanned++;
             
             /*
              * Relaxation condition:
              *   1. v must not be processed yet
-             *   2. d[u] must not be INF (avoid overflow)
-             *   3. Path through u must be shorter than current d[v]
+             *   2. Path through u must be shorter than current d[v]
+             * 
+             * dist_add() saturates at INF: a sum that would overflow an
+             * int compares as unreachable instead of wrapping negative.
              * 
              * Mathematical: d[v] = min(d[v], d[u] + w(u,v))
              */
-            if (!processed[v] && 
-                result->distance[u] != INF &&
-                result->distance[u] + weight < result->distance[v]) {
+            int candidate = dist_add(result->distance[u], weight);
+            if (!processed[v] && candidate < result->distance[v]) {
                 
                 int old_dist = result->distance[v];
-                result->distance[v] = result->distance[u] + weight;
+                result->distance[v] = candidate;
                 result->parent[v] = u;
+                stats.relaxations++;
                 
-                printf("    Relaxed edge (%d, %d): d[%d] updated from %s to %d\n",
-                       u, v, v,
-                       (old_dist == INF) ? "∞" : "previous",
-                       result->distance[v]);
+                TRACE_PRINTF("    Relaxed edge (%" PRIdVERTEX ", %" PRIdVERTEX "): d[%" PRIdVERTEX
+                             "] updated from %s to %d\n",
+                             u, v, v,
+                             (old_dist == INF) ? "∞" : "previous",
+                             result->distance[v]);
             }
             
             edge = edge->next;
         }
     }
     
-    printf("[DIJKSTRA] Algorithm complete!\n\n");
+    TRACE_PRINTF("[DIJKSTRA] Algorithm complete!\n\n");
     
     /* Clean up temporary array */
     free(processed);
     
+    result->stats = stats;
+    
     return result;
 }
 
 /*============================================================================
- * MIN-HEAP (PRIORITY QUEUE) IMPLEMENTATION
- * 
- * For sparse graphs, using a min-heap dramatically improves performance.
- * 
- * Time Complexity:  O((V + E) log V)
- * Space Complexity: O(V)
+ * DENSE MATRIX IMPLEMENTATION
+ *
+ * The same O(V²) algorithm as dijkstra(), run over the V×V weight matrix
+ * (build_weight_matrix()) instead of the linked lists. Both halves of an
+ * iteration become straight sweeps over contiguous ints, SIMD_LANES
+ * vertices per instruction (see simd.h):
+ *
+ *   EXTRACT-MIN: vector minimum over key[], where key[v] = distance[v]
+ *                while v is unprocessed and INF (a sentinel) after, so
+ *                no separate processed[] test is needed
+ *   RELAX:       row u of the matrix against distance[] in one pass;
+ *                missing edges (INF) are masked out
+ *
+ * Best for: dense graphs of up to a few thousand vertices, where the
+ * heap's log factor and the list's pointer chasing do not pay off.
  *===========================================================================*/
 
 /*
- * HeapNode - Node in the priority queue
+ * dense_min_vertex - Vectorized EXTRACT-MIN over the sentinel keys
+ *
+ * @key:    Keys, @stride entries (padding is INF)
+ * @stride: A multiple of SIMD_LANES
+ *
+ * Ties go to the lowest index, as in find_min_vertex().
+ *
+ * Return: Vertex with the smallest finite key, or -1 if none
  */
-typedef struct HeapNode {
-    int vertex;
-    int distance;
-} HeapNode;
+static vertex_t dense_min_vertex(const int *key, vertex_t stride) {
+    simd_vec best = vec_set1(INF);
+    for (vertex_t v = 0; v < stride; v += SIMD_LANES) {
+        best = vec_min(best, vec_load(key + v));
+    }
+
+    int lanes[SIMD_LANES];
+    vec_store(lanes, best);
+    int min_key = lanes[0];
+    for (int i = 1; i < SIMD_LANES; i++) {
+        if (lanes[i] < min_key) min_key = lanes[i];
+    }
+    if (min_key == INF) return -1;
+
+    /* Second pass stops at the first vector holding the minimum */
+    const simd_vec target = vec_set1(min_key);
+    for (vertex_t v = 0; v < stride; v += SIMD_LANES) {
+        int mask = vec_movemask(vec_eq(vec_load(key + v), target));
+        if (mask != 0) return v + __builtin_ctz((unsigned)mask);
+    }
+    return -1;
+}
 
 /*
- * MinHeap - Priority queue data structure
- * 
- * Binary heap stored in array:
- *   - Parent of i: (i-1)/2
- *   - Left child of i: 2*i + 1
- *   - Right child of i: 2*i + 2
- * 
- * The position array allows O(1) lookup of a vertex's position in the heap,
- * which is essential for the DECREASE-KEY operation.
+ * dijkstra_dense - Array-based Dijkstra over the dense weight matrix
+ *
+ * @g:      Pointer to the graph; its matrix is built first if missing
+ * @source: Starting vertex
+ *
+ * Gives the same distances and parents as dijkstra() (parallel edges
+ * count with their lightest weight). edges_scanned counts matrix
+ * entries, present or not.
+ *
+ * Time Complexity:  O(V² / SIMD_LANES)
+ * Space Complexity: O(V²) for the matrix, O(V) per query
+ *
+ * Return: DijkstraResult containing distances and parent pointers
  */
-typedef struct MinHeap {
-    int size;
-    int capacity;
-    int *position;      /* position[v] = index of vertex v in heap */
-    HeapNode **nodes;
-} MinHeap;
-
-/* Heap helper functions */
-static MinHeap *create_min_heap(int capacity) {
-    MinHeap *heap = (MinHeap *)malloc(sizeof(MinHeap));
-    if (heap == NULL) return NULL;
-    
-    heap->position = (int *)malloc(capacity * sizeof(int));
-    heap->nodes = (HeapNode **)malloc(capacity * sizeof(HeapNode *));
-    
-    if (heap->position == NULL || heap->nodes == NULL) {
-        free(heap->position);
-        free(heap->nodes);
-        free(heap);
+DijkstraResult *dijkstra_dense(Graph *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_dense()\n");
         return NULL;
     }
-    
-    heap->size = 0;
-    heap->capacity = capacity;
-    return heap;
-}
+    if (g->matrix == NULL && !build_weight_matrix(g)) return NULL;
 
-static HeapNode *create_heap_node(int v, int dist) {
-    HeapNode *node = (HeapNode *)malloc(sizeof(HeapNode));
-    if (node == NULL) return NULL;
-    node->vertex = v;
-    node->distance = dist;
-    return node;
-}
+    vertex_t n = g->num_vertices;
+    vertex_t stride = g->matrix_stride;
+    DijkstraResult *result = create_result(n, source);
 
-static void swap_heap_nodes(MinHeap *heap, int a, int b) {
-    HeapNode *temp = heap->nodes[a];
-    heap->nodes[a] = heap->nodes[b];
-    heap->nodes[b] = temp;
-    
-    /* Update position array to maintain O(1) vertex lookup */
-    heap->position[heap->nodes[a]->vertex] = a;
-    heap->position[heap->nodes[b]->vertex] = b;
+    /* Padded working copies: key, distance, parent (32-bit, so it blends) */
+    int *buffer = (int *)malloc(3 * (size_t)stride * sizeof(int));
+    if (result == NULL || buffer == NULL) {
+        free_result(result);
+        free(buffer);
+        return NULL;
+    }
+    int *key = buffer;
+    int *distance = buffer + stride;
+    int32_t *parent = (int32_t *)(buffer + 2 * (size_t)stride);
+    for (vertex_t v = 0; v < stride; v++) {
+        key[v] = INF;
+        distance[v] = INF;
+        parent[v] = -1;
+    }
+    key[source] = 0;
+    distance[source] = 0;
+
+    DijkstraStats stats = {0};
+
+    for (;;) {
+        vertex_t u = dense_min_vertex(key, stride);
+        if (u == -1) break;
+
+        int du = distance[u];
+        key[u] = INF;   /* Processed: never the minimum again */
+        stats.vertices_settled++;
+        stats.edges_scanned += (uint64_t)stride;
+        TRACE_PRINTF("  Processing vertex %" PRIdVERTEX " (distance = %d)\n", u, du);
+
+        /*
+         * Relax the whole row: better = (du + w did not wrap) && (du + w < d[v]).
+         * With w >= 0 the lane sum wraps exactly when it falls below du;
+         * such a lane is treated as INF (dist_add() saturation) and skipped.
+         * A missing edge (w == INF) wraps for du > 0 and gives INF for
+         * du == 0, so it never relaxes either. A processed v has
+         * d[v] <= du, so it is never improved.
+         */
+        const int *row = g->matrix + (size_t)u * (size_t)stride;
+        const simd_vec base = vec_set1(du);
+        const simd_vec from = vec_set1((int32_t)u);
+        for (vertex_t v = 0; v < stride; v += SIMD_LANES) {
+            simd_vec w = vec_load(row + v);
+            simd_vec d = vec_load(distance + v);
+            simd_vec candidate = vec_add(base, w);
+            simd_vec better = vec_andnot(vec_gt(base, candidate), vec_gt(d, candidate));
+            int mask = vec_movemask(better);
+            if (mask == 0) continue;
+
+            stats.relaxations += (uint64_t)__builtin_popcount((unsigned)mask);
+            vec_store(distance + v, vec_select(better, candidate, d));
+            vec_store(key + v, vec_select(better, candidate, vec_load(key + v)));
+            vec_store(parent + v, vec_select(better, from, vec_load(parent + v)));
+        }
+    }
+
+    for (vertex_t v = 0; v < n; v++) {
+        result->distance[v] = distance[v];
+        result->parent[v] = parent[v];
+    }
+    free(buffer);
+    result->stats = stats;
+    return result;
 }
 
+/*============================================================================
+ * MIN-HEAP (PRIORITY QUEUE) IMPLEMENTATION
+ * 
+ * For sparse graphs, using a min-heap dramatically improves performance.
+ * The heap itself lives in heap.h: an indexed d-ary heap of inline
+ * {key, vertex} entries with O(1) position lookup for DECREASE-KEY.
+ * 
+ * Vertices are inserted lazily, the first time an edge reaches them,
+ * so unreachable vertices never enter the heap at all.
+ * 
+ * Time Complexity:  O((V + E) log V)
+ * Space Complexity: O(V)
+ *===========================================================================*/
+
 /*
- * heapify - Restores min-heap property by sifting down
+ * create_result - Allocates a DijkstraResult with all vertices unreached
  * 
- * @heap: Pointer to min-heap
- * @idx:  Index to start heapifying from
+ * Shared by every engine that returns a DijkstraResult.
  * 
- * Time Complexity: O(log V)
+ * Return: Result with distance[v] = INF, parent[v] = -1, or NULL on failure
  */
-static void heapify(MinHeap *heap, int idx) {
-    int smallest = idx;
-    int left = 2 * idx + 1;
-    int right = 2 * idx + 2;
+DijkstraResult *create_result(vertex_t n, vertex_t source) {
+    DijkstraResult *result = (DijkstraResult *)malloc(sizeof(DijkstraResult));
+    if (result == NULL) return NULL;
     
-    if (left < heap->size && 
-        heap->nodes[left]->distance < heap->nodes[smallest]->distance) {
-        smallest = left;
-    }
+    result->distance = (int *)malloc((size_t)n * sizeof(int));
+    result->parent = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
     
-    if (right < heap->size && 
-        heap->nodes[right]->distance < heap->nodes[smallest]->distance) {
-        smallest = right;
+    if (result->distance == NULL || result->parent == NULL) {
+        free(result->distance);
+        free(result->parent);
+        free(result);
+        return NULL;
     }
     
-    if (smallest != idx) {
-        swap_heap_nodes(heap, smallest, idx);
-        heapify(heap, smallest);
+    for (vertex_t v = 0; v < n; v++) {
+        result->distance[v] = INF;
+        result->parent[v] = -1;
     }
+    result->source = source;
+    result->num_vertices = n;
+    result->owner = NULL;
+    result->stats = (DijkstraStats){0};
+    return result;
 }
 
 /*
- * extract_min - Removes and returns the minimum element
+ * heap_search - Heap-based search shared by dijkstra_heap(), dijkstra_to()
+ *               and dijkstra_multi()
+ * 
+ * @g:           Pointer to the graph (already validated)
+ * @sources:     Starting vertices, all at distance 0
+ * @num_sources: Length of @sources
+ * @target:      Vertex at which to stop, or -1 to settle every reachable vertex
+ * @owner:       If non-NULL, owner[v] receives the source whose tree v is in
+ * 
+ * Vertices are extracted in order of distance, so once @target is popped
+ * its distance and parent chain are final and the rest can be skipped.
  * 
- * Time Complexity: O(log V)
+ * Return: DijkstraResult (partial if stopped early), or NULL on failure
  */
-static HeapNode *extract_min(MinHeap *heap) {
-    if (heap->size == 0) return NULL;
+static DijkstraResult *heap_search(Graph *g, const vertex_t *sources, vertex_t num_sources,
+                                   vertex_t target, vertex_t *owner) {
+    vertex_t n = g->num_vertices;
+    DijkstraResult *result = create_result(n, (num_sources == 1) ? sources[0] : -1);
+    if (result == NULL) return NULL;
+    
+    DaryHeap heap;
+    if (!heap_init(&heap, n)) {
+        free_result(result);
+        return NULL;
+    }
+    
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
+    
+    /* Every source has distance 0 (duplicates are queued once) */
+    for (vertex_t i = 0; i < num_sources; i++) {
+        vertex_t s = sources[i];
+        if (distance[s] == 0) continue;
+        distance[s] = 0;
+        if (owner != NULL) owner[s] = s;
+        heap_push(&heap, s, 0);
+        stats.heap_pushes++;
+    }
+    stats.max_heap_size = stats.heap_pushes;
     
-    HeapNode *root = heap->nodes[0];
-    HeapNode *last = heap->nodes[heap->size - 1];
+    TRACE_PRINTF("\n[DIJKSTRA-HEAP] Running optimized algorithm from %" PRIdVERTEX
+                 " source(s), first %" PRIdVERTEX "...\n", num_sources, sources[0]);
     
-    heap->nodes[0] = last;
-    heap->position[root->vertex] = heap->size - 1;
-    heap->position[last->vertex] = 0;
+    /* Main loop */
+    while (!heap_empty(&heap)) {
+        vertex_t u = heap_pop(&heap).vertex;
+        int du = distance[u];
+        stats.heap_pops++;
+        stats.vertices_settled++;
+        
+        if (u == target) {
+            TRACE_PRINTF("[DIJKSTRA-HEAP] Target %" PRIdVERTEX " settled, stopping early\n", u);
+            break;
+        }
+        
+        /* Process all neighbors */
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            vertex_t v = edge->destination;
+            stats.edges_scanned++;
+            
+            int candidate = dist_add(du, edge->weight);
+            if (candidate < distance[v]) {
+                distance[v] = candidate;
+                parent[v] = u;
+                if (owner != NULL) owner[v] = owner[u];
+                stats.relaxations++;
+                
+                if (heap_contains(&heap, v)) {
+                    heap_decrease_key(&heap, v, distance[v]);
+                    stats.heap_decrease_keys++;
+                } else {
+                    heap_push(&heap, v, distance[v]);
+                    stats.heap_pushes++;
+                    if ((uint64_t)heap.size > stats.max_heap_size) {
+                        stats.max_heap_size = (uint64_t)heap.size;
+                    }
+                }
+            }
+        }
+    }
     
-    heap->size--;
-    heapify(heap, 0);
+    TRACE_PRINTF("[DIJKSTRA-HEAP] Complete!\n\n");
     
-    return root;
+    heap_free(&heap);
+    result->stats = stats;
+    return result;
 }
 
 /*
- * decrease_key - Decreases the distance value of a vertex
+ * dijkstra_heap - Heap-optimized Dijkstra's algorithm
+ * 
+ * @g:      Pointer to the graph
+ * @source: Starting vertex
  * 
- * @heap: Pointer to min-heap
- * @v:    Vertex whose key to decrease
- * @dist: New (smaller) distance value
+ * Uses a min-heap priority queue for efficient EXTRACT-MIN and DECREASE-KEY.
  * 
- * This is the KEY OPTIMIZATION over the array implementation!
- * Instead of O(V) to find minimum, we maintain heap property in O(log V).
+ * Relaxation with lazy insertion:
+ *   If d[u] + w < d[v]:
+ *     - v not in heap yet  → PUSH(v, d[v])
+ *     - v already in heap  → DECREASE-KEY(v, d[v])
+ *   A vertex that was already extracted can never pass the test, because
+ *   with non-negative weights d[v] <= d[u] for every extracted v.
  * 
- * Time Complexity: O(log V)
+ * Return: DijkstraResult containing distances and parent pointers
  */
-static void decrease_key(MinHeap *heap, int v, int dist) {
-    int i = heap->position[v];
-    heap->nodes[i]->distance = dist;
-    
-    /* Sift up while smaller than parent */
-    while (i > 0 && heap->nodes[i]->distance < heap->nodes[(i - 1) / 2]->distance) {
-        swap_heap_nodes(heap, i, (i - 1) / 2);
-        i = (i - 1) / 2;
+DijkstraResult *dijkstra_heap(Graph *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_heap()\n");
+        return NULL;
     }
+    return heap_search(g, &source, 1, -1, NULL);
 }
 
-static bool is_in_heap(MinHeap *heap, int v) {
-    return heap->position[v] < heap->size;
-}
-
-static void free_min_heap(MinHeap *heap, HeapNode **extracted, int num_extracted) {
-    if (heap == NULL) return;
-    
-    /* Free nodes still in heap */
-    for (int i = 0; i < heap->size; i++) {
-        if (heap->nodes[i]) free(heap->nodes[i]);
+/*
+ * dijkstra_multi - Distances from the nearest of several sources
+ * 
+ * @g:           Pointer to the graph
+ * @sources:     Source vertices (duplicates are allowed)
+ * @num_sources: Number of sources, at least 1
+ * 
+ * Equivalent to a single search from a virtual super-source joined to
+ * every source by a zero-weight edge: all sources enter the heap at
+ * distance 0 and the usual loop does the rest. One pass replaces k
+ * calls to dijkstra_heap() plus taking minima.
+ * 
+ *   distance[v] = min over sources s of d(s, v)
+ *   owner[v]    = a source attaining that minimum (Voronoi cell of v)
+ *   parent[v]   = predecessor towards owner[v]; -1 for the sources
+ * 
+ * Time Complexity: O((V + E) log V) - independent of the number of sources
+ * 
+ * Return: DijkstraResult with owner[] filled and source = -1 (or the
+ *         single source when num_sources == 1), or NULL on failure
+ */
+DijkstraResult *dijkstra_multi(Graph *g, const vertex_t *sources, vertex_t num_sources) {
+    if (g == NULL || sources == NULL || num_sources < 1) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_multi()\n");
+        return NULL;
     }
-    
-    /* Free extracted nodes */
-    for (int i = 0; i < num_extracted; i++) {
-        if (extracted[i]) free(extracted[i]);
+    for (vertex_t i = 0; i < num_sources; i++) {
+        if (sources[i] < 0 || sources[i] >= g->num_vertices) {
+            fprintf(stderr, "Error: Invalid source vertex %" PRIdVERTEX " (valid: 0 to %"
+                    PRIdVERTEX ")\n", sources[i], g->num_vertices - 1);
+            return NULL;
+        }
     }
     
-    free(heap->nodes);
-    free(heap->position);
-    free(heap);
+    vertex_t *owner = (vertex_t *)malloc(((size_t)g->num_vertices + 1) * sizeof(vertex_t));
+    if (owner == NULL) return NULL;
+    for (vertex_t v = 0; v < g->num_vertices; v++) owner[v] = -1;
+    
+    DijkstraResult *result = heap_search(g, sources, num_sources, -1, owner);
+    if (result == NULL) {
+        free(owner);
+        return NULL;
+    }
+    result->owner = owner;
+    return result;
 }
 
+/*============================================================================
+ * CSR ENGINES
+ * 
+ * Same algorithms as above, running on a frozen CSRGraph. The relaxation
+ * loop walks offsets/destinations/weights sequentially instead of
+ * following Edge pointers, and nothing is printed from the hot loop.
+ *===========================================================================*/
+
 /*
- * dijkstra_heap - Heap-optimized Dijkstra's algorithm
+ * dijkstra_csr - Array-based Dijkstra on a frozen CSR graph
  * 
- * @g:      Pointer to the graph
+ * @g:      Pointer to the CSR graph
  * @source: Starting vertex
  * 
- * Uses a min-heap priority queue for efficient EXTRACT-MIN and DECREASE-KEY.
+ * Time Complexity: O(V²)
  * 
  * Return: DijkstraResult containing distances and parent pointers
  */
-DijkstraResult *dijkstra_heap(Graph *g, int source) {
+DijkstraResult *dijkstra_csr(const CSRGraph *g, vertex_t source) {
     if (g == NULL || source < 0 || source >= g->num_vertices) {
-        fprintf(stderr, "Error: Invalid input to dijkstra_heap()\n");
+        fprintf(stderr, "Error: Invalid input to dijkstra_csr()\n");
         return NULL;
     }
     
-    int n = g->num_vertices;
+    vertex_t n = g->num_vertices;
+    DijkstraResult *result = create_result(n, source);
+    bool *processed = (bool *)calloc(n, sizeof(bool));
+    if (result == NULL || processed == NULL) {
+        free_result(result);
+        free(processed);
+        return NULL;
+    }
     
-    /* Allocate result */
-    DijkstraResult *result = (DijkstraResult *)malloc(sizeof(DijkstraResult));
-    if (result == NULL) return NULL;
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    distance[source] = 0;
+    DijkstraStats stats = {0};
     
-    result->distance = (int *)malloc(n * sizeof(int));
-    result->parent = (int *)malloc(n * sizeof(int));
+    for (vertex_t iteration = 0; iteration < n; iteration++) {
+        vertex_t u = find_min_vertex(distance, processed, n);
+        if (u == -1) break;
+        processed[u] = true;
+        stats.vertices_settled++;
+        
+        int du = distance[u];
+        edge_t end = g->offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - g->offsets[u]);
+        for (edge_t i = g->offsets[u]; i < end; i++) {
+            vertex_t v = g->destinations[i];
+            int candidate = dist_add(du, g->weights[i]);
+            if (!processed[v] && candidate < distance[v]) {
+                distance[v] = candidate;
+                parent[v] = u;
+                stats.relaxations++;
+            }
+        }
+    }
     
-    if (result->distance == NULL || result->parent == NULL) {
-        free(result->distance);
-        free(result->parent);
-        free(result);
+    free(processed);
+    result->stats = stats;
+    return result;
+}
+
+/*
+ * dijkstra_heap_csr - Heap-optimized Dijkstra on a frozen CSR graph
+ * 
+ * @g:      Pointer to the CSR graph
+ * @source: Starting vertex
+ * 
+ * Time Complexity: O((V + E) log V)
+ * 
+ * Return: DijkstraResult containing distances and parent pointers
+ */
+DijkstraResult *dijkstra_heap_csr(const CSRGraph *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_heap_csr()\n");
         return NULL;
     }
     
-    result->source = source;
-    result->num_vertices = n;
+    vertex_t n = g->num_vertices;
+    DijkstraResult *result = create_result(n, source);
+    if (result == NULL) return NULL;
     
-    /* Create and initialize min-heap */
-    MinHeap *heap = create_min_heap(n);
-    if (heap == NULL) {
+    DaryHeap heap;
+    if (!heap_init(&heap, n)) {
         free_result(result);
         return NULL;
     }
     
-    /* Track extracted nodes for proper memory cleanup */
-    HeapNode **extracted = (HeapNode **)malloc(n * sizeof(HeapNode *));
-    int num_extracted = 0;
-    
-    /* Initialize all vertices */
-    for (int v = 0; v < n; v++) {
-        result->distance[v] = INF;
-        result->parent[v] = -1;
-        heap->nodes[v] = create_heap_node(v, INF);
-        heap->position[v] = v;
-    }
-    
-    /* Source has distance 0 */
-    result->distance[source] = 0;
-    decrease_key(heap, source, 0);
-    heap->size = n;
+    const edge_t *offsets = g->offsets;
+    const vertex_t *destinations = g->destinations;
+    const int *weights = g->weights;
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
     
-    printf("\n[DIJKSTRA-HEAP] Running optimized algorithm from source %d...\n", source);
+    distance[source] = 0;
+    heap_push(&heap, source, 0);
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
     
-    /* Main loop */
-    while (heap->size > 0) {
-        HeapNode *min_node = extract_min(heap);
-        extracted[num_extracted++] = min_node;  /* Track for later freeing */
-        int u = min_node->vertex;
-        
-        /* If distance is INF, remaining vertices are unreachable */
-        if (result->distance[u] == INF) break;
+    while (!heap_empty(&heap)) {
+        vertex_t u = heap_pop(&heap).vertex;
+        int du = distance[u];
+        stats.heap_pops++;
+        stats.vertices_settled++;
         
-        /* Process all neighbors */
-        Edge *edge = g->adj_list[u];
-        while (edge != NULL) {
-            int v = edge->destination;
-            
-            if (is_in_heap(heap, v) &&
-                result->distance[u] != INF &&
-                result->distance[u] + edge->weight < result->distance[v]) {
+        edge_t end = offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - offsets[u]);
+        for (edge_t i = offsets[u]; i < end; i++) {
+            vertex_t v = destinations[i];
+            int candidate = dist_add(du, weights[i]);
+            if (candidate < distance[v]) {
+                distance[v] = candidate;
+                parent[v] = u;
+                stats.relaxations++;
                 
-                result->distance[v] = result->distance[u] + edge->weight;
-                result->parent[v] = u;
-                decrease_key(heap, v, result->distance[v]);
+                if (heap_contains(&heap, v)) {
+                    heap_decrease_key(&heap, v, candidate);
+                    stats.heap_decrease_keys++;
+                } else {
+                    heap_push(&heap, v, candidate);
+                    stats.heap_pushes++;
+                    if ((uint64_t)heap.size > stats.max_heap_size) {
+                        stats.max_heap_size = (uint64_t)heap.size;
+                    }
+                }
             }
-            edge = edge->next;
         }
     }
     
-    printf("[DIJKSTRA-HEAP] Complete!\n\n");
-    
-    free_min_heap(heap, extracted, num_extracted);
-    free(extracted);
+    heap_free(&heap);
+    result->stats = stats;
     return result;
 }
 
+/*============================================================================
+ * POINT-TO-POINT QUERIES
+ * 
+ * Single-pair routing does not need the whole shortest-path tree: the
+ * search can stop as soon as the target is extracted from the heap.
+ * On a road network a short trip settles a small ball around the
+ * source instead of the entire graph.
+ *===========================================================================*/
+
+/*
+ * dijkstra_to - Shortest path from source to one target
+ * 
+ * @g:      Pointer to the graph
+ * @source: Starting vertex
+ * @target: Destination vertex
+ * 
+ * Time Complexity: O((V' + E') log V') for the V' vertices closer than
+ *                  the target (plus O(V) to allocate the arrays)
+ * 
+ * Return: ShortestPath (distance INF and no vertices if unreachable),
+ *         or NULL on invalid input / allocation failure
+ *         Caller must call free_shortest_path()!
+ */
+ShortestPath *dijkstra_to(Graph *g, vertex_t source, vertex_t target) {
+    if (g == NULL || source < 0 || source >= g->num_vertices ||
+        target < 0 || target >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_to()\n");
+        return NULL;
+    }
+    
+    DijkstraResult *result = heap_search(g, &source, 1, target, NULL);
+    ShortestPath *sp = (ShortestPath *)malloc(sizeof(ShortestPath));
+    if (result == NULL || sp == NULL) {
+        free_result(result);
+        free(sp);
+        return NULL;
+    }
+    
+    sp->source = source;
+    sp->target = target;
+    sp->distance = result->distance[target];
+    sp->vertices = get_path(result, target, &sp->length);
+    sp->stats = result->stats;
+    free_result(result);
+    
+    if (sp->distance != INF && sp->vertices == NULL) {
+        free(sp);
+        return NULL;
+    }
+    return sp;
+}
+
+/*
+ * print_shortest_path - Displays the answer to a point-to-point query
+ */
+void print_shortest_path(const ShortestPath *sp) {
+    if (sp == NULL) {
+        printf("(NULL path)\n");
+        return;
+    }
+    
+    if (sp->distance == INF) {
+        printf("  %" PRIdVERTEX " → %" PRIdVERTEX ": unreachable\n", sp->source, sp->target);
+        return;
+    }
+    
+    printf("  %" PRIdVERTEX " → %" PRIdVERTEX ": distance %d, path ",
+           sp->source, sp->target, sp->distance);
+    for (vertex_t i = 0; i < sp->length; i++) {
+        if (i > 0) printf(" → ");
+        printf("%" PRIdVERTEX, sp->vertices[i]);
+    }
+    printf("\n");
+}
+
+/*
+ * free_shortest_path - Releases a ShortestPath
+ */
+void free_shortest_path(ShortestPath *sp) {
+    if (sp == NULL) return;
+    free(sp->vertices);
+    free(sp);
+}
+
 /*============================================================================
  * RESULT OUTPUT FUNCTIONS
  *===========================================================================*/
@@ -491,13 +815,13 @@ void print_result(DijkstraResult *result) {
     
     printf("┌───────────────────────────────────────────────────────┐\n");
     printf("│         DIJKSTRA'S ALGORITHM RESULTS                  │\n");
-    printf("│         Source Vertex: %d                              │\n", result->source);
+    printf("│         Source Vertex: %" PRIdVERTEX "                              │\n", result->source);
     printf("├──────────┬────────────┬───────────────────────────────┤\n");
     printf("│  Vertex  │  Distance  │            Path               │\n");
     printf("├──────────┼────────────┼───────────────────────────────┤\n");
     
-    for (int v = 0; v < result->num_vertices; v++) {
-        printf("│    %2d    │", v);
+    for (vertex_t v = 0; v < result->num_vertices; v++) {
+        printf("│    %2" PRIdVERTEX "    │", v);
         
         if (result->distance[v] == INF) {
             printf("     ∞      │ ");
@@ -513,26 +837,63 @@ void print_result(DijkstraResult *result) {
 }
 
 /*
- * print_path_recursive - Helper for recursive path printing
+ * print_stats - Displays the work counters of one query
  */
-void print_path_recursive(DijkstraResult *result, int v) {
-    if (v == result->source) {
-        printf("%d", v);
-        return;
-    }
-    if (result->parent[v] == -1) {
+void print_stats(const DijkstraStats *stats) {
+    if (stats == NULL) return;
+    
+    printf("  Vertices settled:   %" PRIu64 "\n", stats->vertices_settled);
+    printf("  Edges scanned:      %" PRIu64 "\n", stats->edges_scanned);
+    printf("  Relaxations:        %" PRIu64 "\n", stats->relaxations);
+    printf("  Heap pushes:        %" PRIu64 "\n", stats->heap_pushes);
+    printf("  Heap decrease-keys: %" PRIu64 "\n", stats->heap_decrease_keys);
+    printf("  Heap pops:          %" PRIu64 "\n", stats->heap_pops);
+    printf("  Max heap size:      %" PRIu64 "\n", stats->max_heap_size);
+}
+
+/*
+ * print_path_recursive - Prints the path ending at v
+ * 
+ * The path starts at the source, or for dijkstra_multi() results at
+ * whichever source owns v (the root: no parent, finite distance).
+ * 
+ * Despite the name (kept for existing callers) this is iterative: the
+ * path is collected back to front, in a small stack buffer or, for
+ * long paths, one heap buffer, so no path can overflow the call stack.
+ */
+void print_path_recursive(DijkstraResult *result, vertex_t v) {
+    if (result->parent[v] == -1 && v != result->source && result->distance[v] == INF) {
         printf("(unreachable)");
         return;
     }
     
-    print_path_recursive(result, result->parent[v]);
-    printf(" → %d", v);
+    vertex_t length = 0;
+    for (vertex_t u = v; u != -1; u = result->parent[u]) length++;
+    
+    vertex_t local[256];
+    vertex_t *path = local;
+    if (length > (vertex_t)(sizeof(local) / sizeof(local[0]))) {
+        path = (vertex_t *)malloc((size_t)length * sizeof(vertex_t));
+        if (path == NULL) {
+            printf("(path too long to print)");
+            return;
+        }
+    }
+    
+    vertex_t i = length;
+    for (vertex_t u = v; u != -1; u = result->parent[u]) path[--i] = u;
+    
+    for (i = 0; i < length; i++) {
+        if (i > 0) printf(" → ");
+        printf("%" PRIdVERTEX, path[i]);
+    }
+    if (path != local) free(path);
 }
 
 /*
  * print_path - Prints the shortest path to a destination vertex
  */
-void print_path(DijkstraResult *result, int destination) {
+void print_path(DijkstraResult *result, vertex_t destination) {
     if (result == NULL || destination < 0 || destination >= result->num_vertices) {
         return;
     }
@@ -555,7 +916,7 @@ void print_path(DijkstraResult *result, int destination) {
  * Return: Dynamically allocated array containing path vertices
  *         Caller must free this array!
  */
-int *get_path(DijkstraResult *result, int destination, int *path_length) {
+vertex_t *get_path(DijkstraResult *result, vertex_t destination, vertex_t *path_length) {
     if (result == NULL || destination < 0 || 
         destination >= result->num_vertices ||
         result->distance[destination] == INF) {
@@ -564,15 +925,15 @@ int *get_path(DijkstraResult *result, int destination, int *path_length) {
     }
     
     /* First, count path length */
-    int length = 0;
-    int v = destination;
+    vertex_t length = 0;
+    vertex_t v = destination;
     while (v != -1) {
         length++;
         v = result->parent[v];
     }
     
     /* Allocate array */
-    int *path = (int *)malloc(length * sizeof(int));
+    vertex_t *path = (vertex_t *)malloc((size_t)length * sizeof(vertex_t));
     if (path == NULL) {
         *path_length = 0;
         return NULL;
@@ -581,7 +942,7 @@ int *get_path(DijkstraResult *result, int destination, int *path_length) {
     /* Fill array in reverse (destination to source), then it's already correct
        since we traced back from destination */
     v = destination;
-    for (int i = length - 1; i >= 0; i--) {
+    for (vertex_t i = length - 1; i >= 0; i--) {
         path[i] = v;
         v = result->parent[v];
     }
@@ -590,6 +951,141 @@ int *get_path(DijkstraResult *result, int destination, int *path_length) {
     return path;
 }
 
+/*============================================================================
+ * BATCH PATH EXTRACTION
+ * 
+ * get_path() walks the parent chain twice and mallocs per call. For many
+ * destinations of one tree, measure_paths() lays all paths out in one
+ * caller-provided buffer and extract_paths() fills it, one walk per path
+ * and no allocation.
+ * 
+ * Depth Memo:
+ *   depth[v] = number of edges from the root of v's tree (-1 = unknown).
+ *   A walk up from a destination stops at the first vertex whose depth
+ *   is known, so paths sharing a prefix measure it only once:
+ * 
+ *     s ── a ── b ── c ── t1        measure t1: walks t1, c, b, a, s
+ *                 └── d ── t2       measure t2: walks t2, d, stops at b
+ * 
+ *   The memo stays valid as long as the result is unchanged, so it can
+ *   be kept across calls.
+ *===========================================================================*/
+
+/*
+ * measure_paths - Computes where each path goes in the output buffers
+ * 
+ * @result:       Result holding the shortest-path tree
+ * @destinations: Path end points (repeats allowed)
+ * @count:        Number of destinations
+ * @depth:        Depth memo, num_vertices entries. Fill with -1 before the
+ *                first call for a result; later calls reuse what it holds
+ * @offsets:      Output, count + 1 entries: path i will occupy entries
+ *                offsets[i] .. offsets[i + 1] - 1 (empty if unreachable)
+ * 
+ * Time Complexity: O(count + vertices not yet in the memo)
+ * 
+ * Return: Total number of entries (offsets[count]), or -1 on invalid input
+ */
+edge_t measure_paths(const DijkstraResult *result, const vertex_t *destinations, size_t count,
+                     vertex_t *depth, edge_t *offsets) {
+    if (result == NULL || depth == NULL || offsets == NULL ||
+        (destinations == NULL && count > 0)) {
+        fprintf(stderr, "Error: Invalid input to measure_paths()\n");
+        return -1;
+    }
+    
+    const vertex_t *parent = result->parent;
+    offsets[0] = 0;
+    for (size_t i = 0; i < count; i++) {
+        vertex_t t = destinations[i];
+        if (t < 0 || t >= result->num_vertices) {
+            fprintf(stderr, "Error: Destination %" PRIdVERTEX " out of range\n", t);
+            return -1;
+        }
+        if (result->distance[t] == INF) {
+            offsets[i + 1] = offsets[i];
+            continue;
+        }
+        
+        if (depth[t] < 0) {
+            /* Up to the first memoized vertex (or past the root) */
+            vertex_t steps = 0;
+            vertex_t u = t;
+            while (u != -1 && depth[u] < 0) {
+                steps++;
+                u = parent[u];
+            }
+            vertex_t d = (u == -1) ? steps - 1 : depth[u] + steps;
+            for (u = t; u != -1 && depth[u] < 0; u = parent[u]) {
+                depth[u] = d--;
+            }
+        }
+        offsets[i + 1] = offsets[i] + depth[t] + 1;
+    }
+    return offsets[count];
+}
+
+/*
+ * extract_paths - Writes the measured paths into caller buffers
+ * 
+ * @result:       Result holding the shortest-path tree
+ * @g:            CSR graph the tree was computed on (or freeze_graph()
+ *                of its Graph); only needed for @edges
+ * @destinations: Same destinations as for measure_paths()
+ * @count:        Number of destinations
+ * @depth:        Depth memo filled by measure_paths()
+ * @offsets:      Offsets from measure_paths()
+ * @vertices:     Output or NULL: path vertices, root first
+ * @edges:        Output or NULL: edges[j] = CSR id of the edge entering
+ *                vertices[j] (the lightest one matching the tree),
+ *                -1 at each path's root
+ * @distances:    Output or NULL: distances[j] = distance of vertices[j]
+ *                (cumulative length along the path)
+ * 
+ * Every output array holds offsets[count] entries; all three share the
+ * same layout. Each path is written back to front in a single walk.
+ * 
+ * Time Complexity: O(total path length), plus the out-degree of each
+ *                  path vertex when @edges is requested
+ * 
+ * Return: true on success
+ */
+bool extract_paths(const DijkstraResult *result, const CSRGraph *g, const vertex_t *destinations,
+                   size_t count, const vertex_t *depth, const edge_t *offsets,
+                   vertex_t *vertices, edge_t *edges, int *distances) {
+    if (result == NULL || depth == NULL || offsets == NULL ||
+        (destinations == NULL && count > 0) ||
+        (edges != NULL && (g == NULL || g->num_vertices != result->num_vertices))) {
+        fprintf(stderr, "Error: Invalid input to extract_paths()\n");
+        return false;
+    }
+    
+    const vertex_t *parent = result->parent;
+    const int *distance = result->distance;
+    for (size_t i = 0; i < count; i++) {
+        edge_t first = offsets[i];
+        edge_t j = offsets[i + 1];
+        
+        for (vertex_t v = destinations[i]; j > first; v = parent[v]) {
+            j--;
+            if (vertices != NULL) vertices[j] = v;
+            if (distances != NULL) distances[j] = distance[v];
+            if (edges == NULL) continue;
+            
+            edges[j] = -1;
+            vertex_t p = parent[v];
+            if (p == -1) continue;
+            for (edge_t e = g->offsets[p]; e < g->offsets[p + 1]; e++) {
+                if (g->destinations[e] == v && dist_add(distance[p], g->weights[e]) == distance[v]) {
+                    edges[j] = e;
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 /*
  * free_result - Deallocates result structure
  */
@@ -598,5 +1094,6 @@ void free_result(DijkstraResult *result) {
     
     free(result->distance);
     free(result->parent);
+    free(result->owner);
     free(result);
 }
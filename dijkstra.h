@@ -15,17 +15,77 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
 
 /*
  * CONSTANTS
  * ---------
- * MAX_VERTICES: Upper bound on graph size (memory consideration)
  * INF: Represents infinity (unreachable vertices)
  *      Using INT_MAX for mathematical correctness
+ * 
+ * There is no compile-time limit on graph size: vertex arrays grow on
+ * demand and every V- or E-sized buffer is allocated for the real graph.
  */
-#define MAX_VERTICES 1000
 #define INF INT_MAX
 
+/*
+ * dist_add - Saturating distance + weight for the int engines
+ * @d: Tentative distance, 0 <= d <= INF
+ * @w: Edge weight, 0 <= w <= INT_MAX
+ *
+ * The unsigned sum cannot wrap (both operands are at most INT_MAX); its
+ * top bit is set exactly when it exceeds INF, and is smeared into an
+ * all-ones mask without a branch. A path too long for an int therefore
+ * compares as INF (unreachable) instead of wrapping negative.
+ *
+ * Time Complexity: O(1)
+ *
+ * Return: min(d + w, INF)
+ */
+static inline int dist_add(int d, int w) {
+    unsigned int sum = (unsigned int)d + (unsigned int)w;
+    return (int)((sum | (0u - (sum >> 31))) & (unsigned int)INF);
+}
+
+/*
+ * TRACING
+ * -------
+ * TRACE_PRINTF() prints the step-by-step narration of the teaching
+ * engines. It is compiled in only when DIJKSTRA_TRACE is defined
+ * (make debug / make trace). Otherwise the call sits behind a constant
+ * false branch: the arguments are still type-checked, but the compiler
+ * removes the call entirely, so release builds do no I/O in hot loops.
+ */
+#ifdef DIJKSTRA_TRACE
+#define TRACE_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define TRACE_PRINTF(...) do { if (0) printf(__VA_ARGS__); } while (0)
+#endif
+
+/*
+ * INDEX TYPES
+ * -----------
+ * vertex_t: Vertex id. 32-bit by default (up to ~2.1 billion vertices);
+ *           build with -DDIJKSTRA_VERTEX_64 for 64-bit ids.
+ * edge_t:   Edge count / CSR offset. Always 64-bit so that a graph with
+ *           billions of edges can be indexed even with 32-bit vertex ids.
+ * 
+ * Both are signed so that -1 can mean "no vertex" (e.g. parent of source).
+ * Use PRIdVERTEX / PRIdEDGE in printf format strings.
+ */
+#ifdef DIJKSTRA_VERTEX_64
+typedef int64_t vertex_t;
+#define PRIdVERTEX PRId64
+#else
+typedef int32_t vertex_t;
+#define PRIdVERTEX PRId32
+#endif
+
+typedef int64_t edge_t;
+#define PRIdEDGE PRId64
+
 /*
  * GRAPH REPRESENTATION: Adjacency List
  * ------------------------------------
@@ -50,21 +110,64 @@
  * Members:
  *   destination: Target vertex index
  *   weight:      Edge weight (must be >= 0 for Dijkstra)
- *   next:        Pointer to next edge (linked list)
+ *   next:        Pointer to next edge (linked list); the edge itself
+ *                once remove_edge() has unlinked it
+ * 
+ * Nodes never move, so the Edge * returned by add_edge() serves as a
+ * handle for update_edge_weight() and remove_edge().
  */
 typedef struct Edge {
-    int destination;
+    vertex_t destination;
     int weight;
     struct Edge *next;
 } Edge;
 
+/*
+ * VertexCoord - Optional position of a vertex (for goal-directed search)
+ * 
+ * Members:
+ *   x, y: Plane coordinates for the Euclidean heuristic, or
+ *         longitude / latitude in degrees for the haversine heuristic
+ */
+typedef struct VertexCoord {
+    double x;
+    double y;
+} VertexCoord;
+
+/*
+ * EdgeBlock - One slab of a graph's edge arena (opaque, graph.c)
+ * 
+ * Edge nodes are handed out from blocks of doubling size (capped at 2^20
+ * edges) instead of one malloc() each, so building or freeing a graph
+ * costs O(log E + E / 2^20) allocator calls rather than O(E). Nodes of
+ * one block are contiguous, which also makes list walks over recently
+ * added edges cache-friendly.
+ */
+typedef struct EdgeBlock EdgeBlock;
+
 /*
  * Graph - Main graph data structure
  * 
  * Members:
  *   num_vertices: |V| - number of vertices
+ *   capacity:     Allocated length of adj_list (>= num_vertices)
  *   num_edges:    |E| - number of edges
+ *   edges_linked: Edges ever added; unlike num_edges it never goes down
+ *                 (remove_edge() does not lower it)
  *   adj_list:     Array of linked lists (one per vertex)
+ *   coords:       Vertex coordinates (capacity entries), NULL until the
+ *                 first set_vertex_coord(); unset vertices are at (0, 0)
+ *   matrix:       Optional dense copy of the edges for dijkstra_dense():
+ *                 matrix[u * matrix_stride + v] = lightest u → v weight,
+ *                 INF if none. NULL until build_weight_matrix(); kept
+ *                 current by add_edge(), dropped by add_vertex() when the
+ *                 new vertex does not fit (rebuilt on next use)
+ *   matrix_stride: Row length of matrix (>= num_vertices, padded)
+ *   edge_blocks:  Arena the Edge nodes are carved from (newest block
+ *                 first); free_graph() releases whole blocks, not nodes
+ * 
+ * The graph is growable: add_vertex() appends a vertex, doubling
+ * adj_list when capacity runs out (amortized O(1)).
  * 
  * Memory Layout:
  * 
@@ -78,19 +181,248 @@ typedef struct Edge {
  *                         └───┘
  */
 typedef struct Graph {
-    int num_vertices;
-    int num_edges;
+    vertex_t num_vertices;
+    vertex_t capacity;
+    edge_t num_edges;
+    edge_t edges_linked;
     Edge **adj_list;
+    VertexCoord *coords;
+    int *matrix;
+    vertex_t matrix_stride;
+    EdgeBlock *edge_blocks;
 } Graph;
 
+/*
+ * CSRGraph - Frozen, immutable Compressed Sparse Row graph
+ * 
+ * Members:
+ *   num_vertices: |V| - number of vertices
+ *   num_edges:    |E| - number of edges
+ *   offsets:      V+1 entries; edges of u are [offsets[u], offsets[u+1])
+ *   destinations: E entries; target vertex of each edge
+ *   weights:      E entries; weight of each edge
+ * 
+ *   mapping:      Base of the file mapping when loaded with map_csr_graph(),
+ *                 NULL when the arrays are heap-allocated
+ *   mapping_size: Length of the mapping in bytes
+ * 
+ *   reverse_offsets, reverse_sources, reverse_weights:
+ *                 Transposed adjacency (incoming edges of each vertex),
+ *                 NULL until build_reverse_graph() is called
+ *   coords:       Vertex coordinates (copied by freeze_graph() or read by
+ *                 load_coordinates()), NULL if the graph has none
+ * 
+ * Built once from a Graph with freeze_graph(). Neighbor scans walk two
+ * contiguous arrays instead of chasing Edge pointers.
+ * 
+ * A CSR graph can also be saved to disk and mapped back with zero copies:
+ * the three arrays then point straight into the mapped file.
+ */
+typedef struct CSRGraph {
+    vertex_t num_vertices;
+    edge_t num_edges;
+    edge_t *offsets;
+    vertex_t *destinations;
+    int *weights;
+    void *mapping;
+    size_t mapping_size;
+    edge_t *reverse_offsets;
+    vertex_t *reverse_sources;
+    int *reverse_weights;
+    VertexCoord *coords;
+} CSRGraph;
+
+/*
+ * EdgeList - Growable structure-of-arrays edge buffer
+ * 
+ * Members:
+ *   sources, destinations, weights: Parallel arrays, one entry per edge
+ *   count:                          Number of edges stored
+ *   capacity:                       Allocated length of each array
+ * 
+ * Used to collect edges in bulk (e.g. from a file parser) and turn them
+ * into a CSRGraph with build_csr_graph(), without going through
+ * add_edge() and its per-edge malloc.
+ */
+typedef struct EdgeList {
+    vertex_t *sources;
+    vertex_t *destinations;
+    int *weights;
+    edge_t count;
+    edge_t capacity;
+} EdgeList;
+
+/*
+ * GraphFormat - Input formats understood by load_graph()
+ * 
+ *   GRAPH_FORMAT_AUTO:      Detect from file contents / extension
+ *   GRAPH_FORMAT_DIMACS:    9th DIMACS Challenge .gr ("p sp", "a u v w", 1-based)
+ *   GRAPH_FORMAT_EDGE_LIST: One "u v [w]" per line, 0-based, weight defaults to 1
+ *   GRAPH_FORMAT_BINARY:    File written by save_csr_graph() (memory-mapped)
+ */
+typedef enum GraphFormat {
+    GRAPH_FORMAT_AUTO,
+    GRAPH_FORMAT_DIMACS,
+    GRAPH_FORMAT_EDGE_LIST,
+    GRAPH_FORMAT_BINARY
+} GraphFormat;
+
+/*
+ * GraphFamily - Synthetic graph families of the generator library
+ * 
+ *   GRAPH_GRID:        width x height (x depth) grid, 4 or 6 neighbors,
+ *                      both directions with one random weight
+ *   GRAPH_GEOMETRIC:   Random points in a square, joined when closer than
+ *                      a radius; weights follow the Euclidean length and
+ *                      the graph carries coordinates
+ *   GRAPH_RMAT:        R-MAT (2x2 stochastic Kronecker) power-law graph
+ *   GRAPH_ERDOS_RENYI: G(n, m): m edges with uniform random end points
+ */
+typedef enum GraphFamily {
+    GRAPH_GRID,
+    GRAPH_GEOMETRIC,
+    GRAPH_RMAT,
+    GRAPH_ERDOS_RENYI
+} GraphFamily;
+
+/*
+ * GraphSpec - Parameters of one generated graph
+ * 
+ * Members:
+ *   family:        Which generator
+ *   seed:          Same spec and seed give the same graph, bit for bit,
+ *                  on every run
+ *   num_vertices:  |V| (geometric, Erdős–Rényi)
+ *   num_edges:     Directed edges to draw (R-MAT, Erdős–Rényi)
+ *   width, height, depth: Grid dimensions (depth 1 for a 2D grid)
+ *   scale:         R-MAT: log2 |V|
+ *   a, b, c:       R-MAT quadrant probabilities (d = 1 - a - b - c)
+ *   radius:        Geometric: connection radius, in units where the
+ *                  points have density 1 (average degree ~ pi r^2)
+ *   min_weight, max_weight: Uniform weight range (grid, R-MAT,
+ *                  Erdős–Rényi); geometric weights are
+ *                  ceil(max_weight * length / radius), at least min_weight
+ * 
+ * Fill one in with grid_spec(), geometric_spec(), rmat_spec() or
+ * erdos_renyi_spec(), then adjust fields if needed.
+ */
+typedef struct GraphSpec {
+    GraphFamily family;
+    uint64_t seed;
+    vertex_t num_vertices;
+    edge_t num_edges;
+    vertex_t width;
+    vertex_t height;
+    vertex_t depth;
+    int scale;
+    double a;
+    double b;
+    double c;
+    double radius;
+    int min_weight;
+    int max_weight;
+} GraphSpec;
+
+/*
+ * GraphFileWriter - Binary graph file being written in slices (opaque,
+ *                   graph_file.c)
+ * 
+ * Lets a producer that cannot hold the whole CSR in memory write the
+ * save_csr_graph() format directly: offsets up front, then the edges in
+ * any number of slices.
+ */
+typedef struct GraphFileWriter GraphFileWriter;
+
+/*
+ * DijkstraStats - Work counters filled by every engine, per query
+ * 
+ * Members:
+ *   vertices_settled:   Vertices whose distance became final
+ *   edges_scanned:      Outgoing edges examined during relaxation
+ *   relaxations:        Edge scans that improved a tentative distance
+ *   heap_pushes:        Insertions into the priority queue
+ *   heap_decrease_keys: DECREASE-KEY operations
+ *   heap_pops:          EXTRACT-MIN operations
+ *   max_heap_size:      Largest number of entries in the queue at once
+ * 
+ * Counters are kept in locals inside the engines and stored once at the
+ * end, so they cost a few register increments per edge. The heap_*
+ * fields stay 0 for engines without a priority queue.
+ */
+typedef struct DijkstraStats {
+    uint64_t vertices_settled;
+    uint64_t edges_scanned;
+    uint64_t relaxations;
+    uint64_t heap_pushes;
+    uint64_t heap_decrease_keys;
+    uint64_t heap_pops;
+    uint64_t max_heap_size;
+} DijkstraStats;
+
+/*
+ * PerfCounter - Hardware / kernel counters read by perf_counters.c
+ * 
+ *   COUNTER_CYCLES, COUNTER_INSTRUCTIONS: Core cycles and retired instructions
+ *   COUNTER_BRANCH_MISSES:                Mispredicted branches
+ *   COUNTER_L1D_MISSES, COUNTER_LLC_MISSES: L1 data / last-level cache read misses
+ *   COUNTER_DTLB_MISSES:                  Data TLB read misses
+ *   COUNTER_PAGE_FAULTS:                  Page faults (software event)
+ */
+typedef enum PerfCounter {
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_L1D_MISSES,
+    COUNTER_LLC_MISSES,
+    COUNTER_DTLB_MISSES,
+    COUNTER_PAGE_FAULTS,
+    NUM_PERF_COUNTERS
+} PerfCounter;
+
+/*
+ * PerfSample - Counter values of one measured call
+ * 
+ * Members:
+ *   value: Count per PerfCounter (scaled if the counter was multiplexed)
+ *   valid: false where the counter is unavailable on this system
+ */
+typedef struct PerfSample {
+    uint64_t value[NUM_PERF_COUNTERS];
+    bool valid[NUM_PERF_COUNTERS];
+} PerfSample;
+
+/*
+ * PerfCounters - Counters opened for one thread (opaque, perf_counters.c)
+ */
+typedef struct PerfCounters PerfCounters;
+
+/*
+ * PERF_MEASURE - Runs @call (any statement, e.g. an engine call) between
+ *                perf_begin() and perf_end(), filling *@sample
+ * 
+ * The call always runs, whether or not counters are available. Each
+ * measurement costs a few system calls, so wrap whole queries, not
+ * single relaxations.
+ */
+#define PERF_MEASURE(pc, sample, call) \
+    do {                               \
+        perf_begin(pc);                \
+        call;                          \
+        perf_end(pc, sample);          \
+    } while (0)
+
 /*
  * DijkstraResult - Output of the algorithm
  * 
  * Members:
  *   distance:     Array of shortest distances from source
  *   parent:       Array of parent vertices for path reconstruction
- *   source:       The source vertex used
+ *   source:       The source vertex used (-1 for a multi-source search)
  *   num_vertices: Number of vertices in result
+ *   owner:        Multi-source searches only: owner[v] is the source v's
+ *                 path starts at (its Voronoi cell), -1 if unreachable;
+ *                 NULL for single-source results
+ *   stats:        Work counters for this query
  * 
  * Path Reconstruction:
  *   To find path from source to v:
@@ -100,32 +432,466 @@ typedef struct Graph {
  */
 typedef struct DijkstraResult {
     int *distance;
-    int *parent;
-    int source;
-    int num_vertices;
+    vertex_t *parent;
+    vertex_t source;
+    vertex_t num_vertices;
+    vertex_t *owner;
+    DijkstraStats stats;
 } DijkstraResult;
 
+/*
+ * ShortestPath - Answer to a single source → target query
+ * 
+ * Members:
+ *   source, target: The query
+ *   distance:       Shortest distance, INF if target is unreachable
+ *   vertices:       source, ..., target (NULL if unreachable)
+ *   length:         Number of entries in vertices (0 if unreachable)
+ *   stats:          Work counters; vertices_settled shows how early the
+ *                   search stopped compared to a full run
+ */
+typedef struct ShortestPath {
+    vertex_t source;
+    vertex_t target;
+    int distance;
+    vertex_t *vertices;
+    vertex_t length;
+    DijkstraStats stats;
+} ShortestPath;
+
+/*
+ * HeuristicFn - Custom A* heuristic: lower bound on the distance v → target
+ * 
+ * Must never overestimate (admissible). If it is also consistent
+ * (h(u) <= w(u, v) + h(v) for every edge) each vertex is settled once.
+ * Returning INF declares that the target is unreachable from v.
+ */
+typedef int (*HeuristicFn)(vertex_t v, vertex_t target, const void *context);
+
+/*
+ * HeuristicKind - Which heuristic astar_search() uses
+ * 
+ *   HEURISTIC_ZERO:      h = 0 (plain Dijkstra)
+ *   HEURISTIC_EUCLIDEAN: scale * straight-line distance between coords
+ *   HEURISTIC_HAVERSINE: scale * great-circle distance in meters, with
+ *                        coords as longitude / latitude in degrees
+ *   HEURISTIC_CUSTOM:    function(v, target, context)
+ *   HEURISTIC_LANDMARKS: ALT triangle-inequality bound, context is a
+ *                        LandmarkTable (no coordinates needed)
+ */
+typedef enum HeuristicKind {
+    HEURISTIC_ZERO,
+    HEURISTIC_EUCLIDEAN,
+    HEURISTIC_HAVERSINE,
+    HEURISTIC_CUSTOM,
+    HEURISTIC_LANDMARKS
+} HeuristicKind;
+
+/*
+ * Heuristic - A* heuristic selection
+ * 
+ * Members:
+ *   kind:     See HeuristicKind
+ *   scale:    Weight units per coordinate unit (Euclidean) or per meter
+ *             (haversine); heuristic_scale() computes the largest
+ *             admissible value for a graph
+ *   function: Callback for HEURISTIC_CUSTOM
+ *   context:  Passed through to the callback; the LandmarkTable for
+ *             HEURISTIC_LANDMARKS
+ */
+typedef struct Heuristic {
+    HeuristicKind kind;
+    double scale;
+    HeuristicFn function;
+    const void *context;
+} Heuristic;
+
+/*
+ * LandmarkStrategy - How build_landmarks() picks landmarks
+ * 
+ *   LANDMARKS_FARTHEST: Each new landmark is the vertex farthest from
+ *                       the ones already chosen
+ *   LANDMARKS_AVOID:    Goldberg-Werneck "avoid": grow a shortest-path
+ *                       tree and put the landmark at the end of the
+ *                       branch whose lower bounds are currently worst
+ */
+/* Upper bound on k; keeps a vertex's table row within a few cache lines */
+#define MAX_LANDMARKS 64
+
+typedef enum LandmarkStrategy {
+    LANDMARKS_FARTHEST,
+    LANDMARKS_AVOID
+} LandmarkStrategy;
+
+/*
+ * LandmarkTable - ALT preprocessing: distances to / from k landmarks
+ * 
+ * Members:
+ *   num_landmarks: k
+ *   num_vertices:  |V| of the graph the table was built for
+ *   num_edges:     |E| of that graph (sanity check when loading)
+ *   landmarks:     k landmark vertex ids
+ *   to:            to[v * k + i]   = d(v, landmark i), INF if unreachable
+ *   from:          from[v * k + i] = d(landmark i, v), INF if unreachable
+ *   mapping:       File mapping when loaded with load_landmarks(), or NULL
+ *   mapping_size:  Length of the mapping in bytes
+ * 
+ * Vertex-major layout: the k entries of one vertex share a cache line,
+ * which is what the A* inner loop reads for each relaxed vertex.
+ */
+typedef struct LandmarkTable {
+    int num_landmarks;
+    vertex_t num_vertices;
+    edge_t num_edges;
+    vertex_t *landmarks;
+    int *to;
+    int *from;
+    void *mapping;
+    size_t mapping_size;
+} LandmarkTable;
+
+/*
+ * ContractionHierarchy - Preprocessed graph for microsecond queries (ch.c)
+ * 
+ * Members:
+ *   num_vertices:  |V| of the original graph
+ *   num_arcs:      Upward plus downward arcs, shortcuts included
+ *   num_shortcuts: Arcs that stand for a path through a lower vertex
+ *   rank:          Contraction order; rank[v] = position of v
+ *   up_*:          CSR of arcs v → head with rank[head] > rank[v]
+ *   down_*:        CSR of arcs tail → v with rank[tail] > rank[v]
+ *   *_middles:     Contracted vertex a shortcut bypasses, -1 for an
+ *                  original edge
+ * 
+ * Both searches of a query only climb in rank: the forward one over
+ * up_*, the backward one over down_* (stored at the lower endpoint).
+ */
+typedef struct ContractionHierarchy {
+    vertex_t num_vertices;
+    edge_t num_arcs;
+    edge_t num_shortcuts;
+    vertex_t *rank;
+    edge_t *up_offsets;
+    vertex_t *up_heads;
+    int *up_weights;
+    vertex_t *up_middles;
+    edge_t *down_offsets;
+    vertex_t *down_tails;
+    int *down_weights;
+    vertex_t *down_middles;
+} ContractionHierarchy;
+
+/*
+ * BatchQuery - One query of a batch run by a QueryPool (batch.c)
+ * 
+ * Members:
+ *   source: Starting vertex
+ *   target: Destination vertex, or -1 for a full single-source search
+ */
+typedef struct BatchQuery {
+    vertex_t source;
+    vertex_t target;
+} BatchQuery;
+
+/*
+ * BatchStats - Totals of one run_batch() call
+ * 
+ * Members:
+ *   queries: Queries answered
+ *   steals:  Times an idle worker took work from another one
+ *   work:    Sum of the per-query DijkstraStats (max_heap_size is the
+ *            largest of any query)
+ */
+typedef struct BatchStats {
+    uint64_t queries;
+    uint64_t steals;
+    DijkstraStats work;
+} BatchStats;
+
+/*
+ * DijkstraWorkspace - Reusable query state, one per thread (see workspace.h)
+ * 
+ * Opaque: created with create_workspace(), filled by dijkstra_workspace(),
+ * read with workspace_distance() / workspace_parent().
+ */
+typedef struct DijkstraWorkspace DijkstraWorkspace;
+
+/*
+ * BatchCallback - Receives each answered query of a batch
+ * 
+ * Called on the worker thread right after query @index was answered;
+ * @ws holds its full result (read it with workspace_distance() /
+ * workspace_parent() / workspace_path()) until the callback returns.
+ * @worker (0 .. threads - 1) lets callers keep per-thread accumulators
+ * without locking.
+ */
+typedef void (*BatchCallback)(const BatchQuery *query, size_t index, int worker,
+                              const DijkstraWorkspace *ws, void *context);
+
+/*
+ * QueryPool - Fixed set of worker threads sharing one read-only graph (opaque)
+ */
+typedef struct QueryPool QueryPool;
+
+/*
+ * DistanceMatrix - All-pairs distances with next hops (apsp.c)
+ * 
+ * Members:
+ *   num_vertices: |V|
+ *   stride:       Row length in entries (|V| rounded up to whole tiles,
+ *                 plus padding); padding entries are INF
+ *   distance:     distance[i * stride + j] = d(i, j), INF if unreachable
+ *   next:         next[i * stride + j] = vertex after i on a shortest
+ *                 path to j (i itself when i == j), -1 if unreachable
+ * 
+ * Next hops are 32-bit in every build: a V×V table outgrows memory long
+ * before vertex ids do.
+ */
+typedef struct DistanceMatrix {
+    vertex_t num_vertices;
+    vertex_t stride;
+    int *distance;
+    int32_t *next;
+} DistanceMatrix;
+
+/*
+ * EdgeChange - One changed edge, for repair_result() (dynamic.c)
+ * 
+ * Members:
+ *   source: Source vertex of the edge. Must be the vertex the edge was
+ *           added from; it is not checked, and a wrong source gives
+ *           wrong distances
+ *   edge:   Its handle from add_edge(); the new weight is read from it
+ *           (INF after remove_edge()), so listing an edge twice is harmless
+ */
+typedef struct EdgeChange {
+    vertex_t source;
+    Edge *edge;
+} EdgeChange;
+
+/*
+ * TreeRepair - In-edge index and scratch space for repairing results
+ *              of one graph (opaque, dynamic.c)
+ */
+typedef struct TreeRepair TreeRepair;
+
+/*
+ * TYPED ENGINES (typed.c)
+ * -----------------------
+ * The engines above store int weights and int distances. Specialized
+ * copies of the heap engine are generated for other weight / distance
+ * pairs, one per entry X(suffix, weight type, distance type) of
+ * DIJKSTRA_WEIGHT_TYPES:
+ *
+ *   suffix  weight    distance  unreachable   use
+ *   u16     uint16_t  uint32_t  UINT32_MAX    small weights, half the
+ *                                             weight bandwidth
+ *   u32     uint32_t  uint64_t  UINT64_MAX    paths longer than INT_MAX
+ *   f32     float     double    HUGE_VAL      real-valued lengths
+ *
+ * Each entry declares CSRGraph_<suffix>, DijkstraResult_<suffix> and
+ * the functions typed_graph_<suffix>(), dijkstra_heap_<suffix>(),
+ * free_typed_graph_<suffix>() and free_result_<suffix>(). Distances
+ * saturate at the unreachable value INF_<suffix> instead of overflowing.
+ *
+ * A new pair needs an entry here, its INF_<suffix>, and an instance in
+ * typed.c; the build fails if any of the three is missing.
+ */
+#define DIJKSTRA_WEIGHT_TYPES(X)   \
+    X(u16, uint16_t, uint32_t)     \
+    X(u32, uint32_t, uint64_t)     \
+    X(f32, float, double)
+
+#define INF_u16 UINT32_MAX
+#define INF_u32 UINT64_MAX
+#define INF_f32 HUGE_VAL
+
+/*
+ * CSRGraph_<suffix> - Typed weights over a CSRGraph's structure
+ *
+ * offsets and destinations are borrowed from the CSRGraph the typed
+ * graph was built from, which must outlive it; only the weights are
+ * owned.
+ *
+ * DijkstraResult_<suffix> - DijkstraResult with typed distances
+ */
+#define DIJKSTRA_DECLARE_TYPES(S, W, D)     \
+    typedef struct CSRGraph_##S {           \
+        vertex_t num_vertices;              \
+        edge_t num_edges;                   \
+        const edge_t *offsets;              \
+        const vertex_t *destinations;       \
+        W *weights;                         \
+    } CSRGraph_##S;                         \
+    typedef struct DijkstraResult_##S {     \
+        D *distance;                        \
+        vertex_t *parent;                   \
+        vertex_t source;                    \
+        vertex_t num_vertices;              \
+        DijkstraStats stats;                \
+    } DijkstraResult_##S;
+
+DIJKSTRA_WEIGHT_TYPES(DIJKSTRA_DECLARE_TYPES)
+
 /*
  * FUNCTION PROTOTYPES
  * -------------------
  */
 
 /* Graph Creation and Management */
-Graph *create_graph(int vertices);
-void add_edge(Graph *g, int src, int dest, int weight);
-void add_undirected_edge(Graph *g, int v1, int v2, int weight);
+Graph *create_graph(vertex_t vertices);
+vertex_t add_vertex(Graph *g);
+Edge *add_edge(Graph *g, vertex_t src, vertex_t dest, int weight);
+bool add_edges(Graph *g, const vertex_t *src, const vertex_t *dest, const int *weights,
+               edge_t count);
+void add_undirected_edge(Graph *g, vertex_t v1, vertex_t v2, int weight);
+bool update_edge_weight(Graph *g, vertex_t src, Edge *edge, int weight);
+bool remove_edge(Graph *g, vertex_t src, Edge *edge);
+bool set_vertex_coord(Graph *g, vertex_t v, double x, double y);
+bool build_weight_matrix(Graph *g);
 void print_graph(Graph *g);
 void free_graph(Graph *g);
 
+/* Frozen CSR Graph */
+CSRGraph *freeze_graph(Graph *g);
+CSRGraph *build_csr_graph(vertex_t num_vertices, const EdgeList *lists, int num_lists);
+bool build_reverse_graph(CSRGraph *csr);
+int max_edge_weight(const CSRGraph *g);
+void free_csr_graph(CSRGraph *csr);
+
+/* Bulk Edge Buffers */
+void edge_list_init(EdgeList *list);
+bool edge_list_append(EdgeList *list, vertex_t src, vertex_t dest, int weight);
+void edge_list_free(EdgeList *list);
+
+/* Binary Graph Files (memory-mapped) */
+bool save_csr_graph(const CSRGraph *g, const char *path);
+CSRGraph *map_csr_graph(const char *path);
+CSRGraph *map_csr_graph_trusted(const char *path);
+GraphFileWriter *create_graph_file(const char *path, vertex_t num_vertices, edge_t num_edges,
+                                   const edge_t *offsets);
+bool write_graph_file_edges(GraphFileWriter *w, edge_t first, const vertex_t *destinations,
+                            const int *weights, edge_t count);
+bool close_graph_file(GraphFileWriter *w);
+
+/* Graph Generators (deterministic, seeded) */
+GraphSpec grid_spec(vertex_t width, vertex_t height, vertex_t depth, int max_weight, uint64_t seed);
+GraphSpec geometric_spec(vertex_t num_vertices, double radius, int max_weight, uint64_t seed);
+GraphSpec rmat_spec(int scale, edge_t num_edges, int max_weight, uint64_t seed);
+GraphSpec erdos_renyi_spec(vertex_t num_vertices, edge_t num_edges, int max_weight, uint64_t seed);
+CSRGraph *generate_graph(const GraphSpec *spec);
+bool generate_graph_file(const GraphSpec *spec, const char *path, size_t buffer_bytes);
+
+/* Text Graph Loaders (parallel, streaming) */
+CSRGraph *load_graph(const char *path, GraphFormat format, int num_threads);
+bool load_coordinates(CSRGraph *g, const char *path, double unit);
+
 /* Dijkstra's Algorithm */
-DijkstraResult *dijkstra(Graph *g, int source);
-DijkstraResult *dijkstra_heap(Graph *g, int source);
+DijkstraResult *dijkstra(Graph *g, vertex_t source);
+DijkstraResult *dijkstra_heap(Graph *g, vertex_t source);
+DijkstraResult *dijkstra_dense(Graph *g, vertex_t source);
+DijkstraResult *dijkstra_multi(Graph *g, const vertex_t *sources, vertex_t num_sources);
+DijkstraResult *dijkstra_csr(const CSRGraph *g, vertex_t source);
+DijkstraResult *dijkstra_heap_csr(const CSRGraph *g, vertex_t source);
+
+/* Integer-Weight Engines (monotone priority queues) */
+DijkstraResult *dijkstra_dial(const CSRGraph *g, vertex_t source);
+DijkstraResult *dijkstra_radix(const CSRGraph *g, vertex_t source);
+
+/* Parallel Single-Source Search (delta-stepping) */
+DijkstraResult *dijkstra_delta(const CSRGraph *g, vertex_t source, int delta, int num_threads);
+
+/* Reusable Workspaces (O(touched) per query) */
+DijkstraWorkspace *create_workspace(vertex_t capacity);
+void free_workspace(DijkstraWorkspace *ws);
+bool dijkstra_workspace(DijkstraWorkspace *ws, const CSRGraph *g, vertex_t source);
+int workspace_distance(const DijkstraWorkspace *ws, vertex_t v);
+vertex_t workspace_parent(const DijkstraWorkspace *ws, vertex_t v);
+const DijkstraStats *workspace_stats(const DijkstraWorkspace *ws);
+
+/* Point-to-Point Queries (stop once the target is settled) */
+ShortestPath *dijkstra_to(Graph *g, vertex_t source, vertex_t target);
+bool dijkstra_workspace_to(DijkstraWorkspace *ws, const CSRGraph *g,
+                           vertex_t source, vertex_t target);
+ShortestPath *workspace_path(const DijkstraWorkspace *ws, vertex_t target);
+void print_shortest_path(const ShortestPath *sp);
+void free_shortest_path(ShortestPath *sp);
+
+/* Bidirectional Search (needs build_reverse_graph()) */
+ShortestPath *dijkstra_bidirectional(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                                     const CSRGraph *g, vertex_t source, vertex_t target);
+
+/* Goal-Directed Search (A*) */
+double heuristic_scale(const CSRGraph *g, HeuristicKind kind);
+bool astar_search(DijkstraWorkspace *ws, const CSRGraph *g, vertex_t source,
+                  vertex_t target, const Heuristic *h);
+
+/* ALT: A* with Landmarks and the Triangle inequality */
+LandmarkTable *build_landmarks(CSRGraph *g, int num_landmarks, LandmarkStrategy strategy,
+                               uint64_t seed);
+bool alt_search(DijkstraWorkspace *ws, const CSRGraph *g, const LandmarkTable *table,
+                vertex_t source, vertex_t target);
+bool save_landmarks(const LandmarkTable *table, const char *path);
+LandmarkTable *load_landmarks(const char *path, const CSRGraph *g);
+void free_landmarks(LandmarkTable *table);
+
+/* Contraction Hierarchies */
+ContractionHierarchy *build_contraction_hierarchy(const CSRGraph *g, int num_threads);
+int ch_distance(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                const ContractionHierarchy *ch, vertex_t source, vertex_t target);
+ShortestPath *ch_shortest_path(DijkstraWorkspace *forward, DijkstraWorkspace *backward,
+                               const ContractionHierarchy *ch, vertex_t source, vertex_t target);
+void free_contraction_hierarchy(ContractionHierarchy *ch);
+
+/* Batch Queries on a Thread Pool */
+QueryPool *create_query_pool(const CSRGraph *g, int num_threads);
+bool run_batch(QueryPool *pool, const BatchQuery *queries, size_t count, int *distances,
+               BatchCallback callback, void *context, BatchStats *stats);
+int query_pool_threads(const QueryPool *pool);
+void free_query_pool(QueryPool *pool);
+
+/* All-Pairs Shortest Paths (dense graphs) */
+DistanceMatrix *floyd_warshall(const CSRGraph *g, int num_threads);
+int apsp_distance(const DistanceMatrix *m, vertex_t source, vertex_t target);
+ShortestPath *apsp_path(const DistanceMatrix *m, vertex_t source, vertex_t target);
+void free_distance_matrix(DistanceMatrix *m);
+
+/* Dynamic Graphs (shortest-path tree repair) */
+TreeRepair *create_tree_repair(const Graph *g);
+bool repair_result(TreeRepair *r, DijkstraResult *result, const EdgeChange *changes, size_t count);
+void free_tree_repair(TreeRepair *r);
+
+/* Typed Engines (one set per DIJKSTRA_WEIGHT_TYPES entry) */
+#define DIJKSTRA_DECLARE_FUNCTIONS(S, W, D)                                            \
+    CSRGraph_##S *typed_graph_##S(const CSRGraph *g, const W *weights);                \
+    void free_typed_graph_##S(CSRGraph_##S *g);                                        \
+    DijkstraResult_##S *dijkstra_heap_##S(const CSRGraph_##S *g, vertex_t source);     \
+    void free_result_##S(DijkstraResult_##S *result);
+
+DIJKSTRA_WEIGHT_TYPES(DIJKSTRA_DECLARE_FUNCTIONS)
+
+/* Hardware Performance Counters (Linux perf_event_open) */
+PerfCounters *create_perf_counters(void);
+int perf_counters_available(const PerfCounters *pc);
+const char *perf_counters_error(const PerfCounters *pc);
+void perf_begin(PerfCounters *pc);
+bool perf_end(PerfCounters *pc, PerfSample *sample);
+const char *perf_counter_name(PerfCounter counter);
+void print_perf_sample(const PerfSample *sample, const DijkstraStats *stats);
+void free_perf_counters(PerfCounters *pc);
 
 /* Result Display and Management */
+DijkstraResult *create_result(vertex_t num_vertices, vertex_t source);
 void print_result(DijkstraResult *result);
-void print_path(DijkstraResult *result, int destination);
-void print_path_recursive(DijkstraResult *result, int destination);
-int *get_path(DijkstraResult *result, int destination, int *path_length);
+void print_stats(const DijkstraStats *stats);
+void print_path(DijkstraResult *result, vertex_t destination);
+void print_path_recursive(DijkstraResult *result, vertex_t destination);
+vertex_t *get_path(DijkstraResult *result, vertex_t destination, vertex_t *path_length);
+edge_t measure_paths(const DijkstraResult *result, const vertex_t *destinations, size_t count,
+                     vertex_t *depth, edge_t *offsets);
+bool extract_paths(const DijkstraResult *result, const CSRGraph *g, const vertex_t *destinations,
+                   size_t count, const vertex_t *depth, const edge_t *offsets,
+                   vertex_t *vertices, edge_t *edges, int *distances);
 void free_result(DijkstraResult *result);
 
 #endif /* DIJKSTRA_H */
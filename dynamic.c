@@ -0,0 +1,295 @@
+/*
+ * dynamic.c - Shortest-Path Tree Repair After Edge Weight Changes
+ *
+ * When a few edge weights change (traffic updates), most of a cached
+ * DijkstraResult is still right. repair_result() fixes it in place,
+ * touching only the part of the shortest-path tree that the changes
+ * reach, in the style of Ramalingam and Reps:
+ *
+ *   1. Increases / removals. A changed edge (u → v) that was v's tree
+ *      edge and no longer gives d[v] cuts v's whole subtree loose. The
+ *      subtree is collected by following tree edges downwards:
+ *        child c of x  ⇔  edge x → c with parent[c] == x
+ *      Affected vertices are reset, then each takes the best offer over
+ *      its incoming edges from unaffected vertices (in-edge index).
+ *
+ *   2. Decreases. A changed edge with d[u] + w < d[v] improves v.
+ *
+ *   3. Every vertex improved in 1. or 2. is queued, and an ordinary
+ *      Dijkstra run from that queue settles the rest. Distances outside
+ *      the queue are valid upper bounds, so it stops as soon as nothing
+ *      improves any more.
+ *
+ *         before              edge (a, b) heavier          repaired
+ *           s                        s                         s
+ *          / \                      /  \                      / \
+ *         a   c                    a    c                    a   c
+ *         |   |                         |                        |\
+ *         b   d                   [b]   d                        d b
+ *         |                        |                               |
+ *         e                       [e]    affected = {b, e}         e
+ *
+ * The work is proportional to the affected subtree plus the edges
+ * around the vertices whose distance changes, not to the graph.
+ */
+
+#include "dijkstra.h"
+#include "heap.h"
+
+/*
+ * TreeRepair - Per-graph repair context
+ *
+ * Members:
+ *   graph:      Graph the index was built from
+ *   indexed:    graph->edges_linked when the index was built (edges
+ *               added later are not seen, so the context must be
+ *               rebuilt; removals do not lower the count)
+ *   in_offsets: In-edges of v are entries in_offsets[v] .. in_offsets[v+1]-1
+ *   in_sources: Source vertex of each in-edge
+ *   in_edges:   Handle of each in-edge; its weight is read live, and a
+ *               removed edge reads as INF
+ *   affected:   affected[v] while v's subtree is being rebuilt
+ *   subtree:    Affected vertices of the current repair
+ *   heap:       Priority queue, empty between repairs
+ *
+ * Scratch state is reused across repairs, so one context serves any
+ * number of cached results for its graph, one repair at a time.
+ */
+struct TreeRepair {
+    const Graph *graph;
+    edge_t indexed;
+    edge_t *in_offsets;
+    vertex_t *in_sources;
+    Edge **in_edges;
+    bool *affected;
+    vertex_t *subtree;
+    DaryHeap heap;
+};
+
+/*
+ * create_tree_repair - Builds the in-edge index of a graph
+ *
+ * @g: Pointer to the graph
+ *
+ * Weight changes and remove_edge() keep the index valid; add_edge()
+ * does not (create a new context after adding edges).
+ *
+ * Time Complexity:  O(V + E)
+ * Space Complexity: O(V + E)
+ *
+ * Return: New context, or NULL on failure. Free with free_tree_repair()
+ */
+TreeRepair *create_tree_repair(const Graph *g) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph in create_tree_repair()\n");
+        return NULL;
+    }
+
+    vertex_t n = g->num_vertices;
+    edge_t m = g->num_edges;
+    TreeRepair *r = (TreeRepair *)calloc(1, sizeof(TreeRepair));
+    if (r == NULL) return NULL;
+    r->in_offsets = (edge_t *)calloc((size_t)n + 1, sizeof(edge_t));
+    r->in_sources = (vertex_t *)malloc(((size_t)m + 1) * sizeof(vertex_t));
+    r->in_edges = (Edge **)malloc(((size_t)m + 1) * sizeof(Edge *));
+    r->affected = (bool *)calloc((size_t)n + 1, sizeof(bool));
+    r->subtree = (vertex_t *)malloc(((size_t)n + 1) * sizeof(vertex_t));
+    if (r->in_offsets == NULL || r->in_sources == NULL || r->in_edges == NULL ||
+        r->affected == NULL || r->subtree == NULL || !heap_init(&r->heap, n)) {
+        fprintf(stderr, "Error: Failed to allocate the in-edge index\n");
+        free(r->in_offsets);
+        free(r->in_sources);
+        free(r->in_edges);
+        free(r->affected);
+        free(r->subtree);
+        free(r);
+        return NULL;
+    }
+    r->graph = g;
+    r->indexed = g->edges_linked;
+
+    /* Counting sort of the edges by destination */
+    for (vertex_t u = 0; u < n; u++) {
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            r->in_offsets[edge->destination + 1]++;
+        }
+    }
+    for (vertex_t v = 0; v < n; v++) {
+        r->in_offsets[v + 1] += r->in_offsets[v];
+    }
+    edge_t *fill = r->in_offsets;
+    for (vertex_t u = 0; u < n; u++) {
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            edge_t slot = fill[edge->destination]++;
+            r->in_sources[slot] = u;
+            r->in_edges[slot] = edge;
+        }
+    }
+    /* fill[v] advanced to the old in_offsets[v + 1]: shift back by one */
+    for (vertex_t v = n; v > 0; v--) {
+        r->in_offsets[v] = r->in_offsets[v - 1];
+    }
+    r->in_offsets[0] = 0;
+    return r;
+}
+
+/*
+ * free_tree_repair - Frees a repair context (not the graph)
+ */
+void free_tree_repair(TreeRepair *r) {
+    if (r == NULL) return;
+    heap_free(&r->heap);
+    free(r->in_offsets);
+    free(r->in_sources);
+    free(r->in_edges);
+    free(r->affected);
+    free(r->subtree);
+    free(r);
+}
+
+/*
+ * improve - Lowers d[v] and queues v
+ */
+static inline void improve(TreeRepair *r, DijkstraResult *result, vertex_t v, int distance,
+                           vertex_t parent, DijkstraStats *stats) {
+    result->distance[v] = distance;
+    result->parent[v] = parent;
+    if (result->owner != NULL) result->owner[v] = result->owner[parent];
+    stats->relaxations++;
+
+    if (heap_contains(&r->heap, v)) {
+        heap_decrease_key(&r->heap, v, distance);
+        stats->heap_decrease_keys++;
+    } else {
+        heap_push(&r->heap, v, distance);
+        stats->heap_pushes++;
+        if ((uint64_t)r->heap.size > stats->max_heap_size) {
+            stats->max_heap_size = (uint64_t)r->heap.size;
+        }
+    }
+}
+
+/*
+ * repair_result - Updates a result after a batch of edge weight changes
+ *
+ * @r:       Repair context of the graph
+ * @result:  Result of dijkstra() / dijkstra_heap() / dijkstra_multi()
+ *           on that graph, before the changes; repaired in place
+ * @changes: Edges whose weight changed or that were removed, already
+ *           applied with update_edge_weight() / remove_edge()
+ * @count:   Number of changes
+ *
+ * Distances come out equal to a full rerun on the changed graph, and
+ * parent[] (and owner[]) form a valid shortest-path tree again, though
+ * ties may be broken differently. result->stats is replaced by the work
+ * of the repair.
+ *
+ * Time Complexity: O((A + k + R) log R) for A affected vertices plus
+ *                  their in-edges, k changes, R re-settled vertices
+ *                  plus their out-edges
+ *
+ * Return: true on success; false on invalid input or if edges were
+ *         added since create_tree_repair() (result unchanged)
+ */
+bool repair_result(TreeRepair *r, DijkstraResult *result, const EdgeChange *changes, size_t count) {
+    if (r == NULL || result == NULL || (changes == NULL && count > 0) ||
+        result->num_vertices != r->graph->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to repair_result()\n");
+        return false;
+    }
+    if (r->graph->edges_linked != r->indexed) {
+        fprintf(stderr, "Error: Graph gained edges since create_tree_repair()\n");
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (changes[i].edge == NULL || changes[i].source < 0 ||
+            changes[i].source >= r->graph->num_vertices) {
+            fprintf(stderr, "Error: Invalid edge change %zu\n", i);
+            return false;
+        }
+    }
+
+    const Graph *g = r->graph;
+    int *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
+
+    /* 1. Roots of detached subtrees: tree edges that no longer carry d[v] */
+    vertex_t num_affected = 0;
+    for (size_t i = 0; i < count; i++) {
+        vertex_t u = changes[i].source;
+        vertex_t v = changes[i].edge->destination;
+        if (parent[v] == u && !r->affected[v] &&
+            dist_add(distance[u], changes[i].edge->weight) > distance[v]) {
+            r->affected[v] = true;
+            r->subtree[num_affected++] = v;
+        }
+    }
+
+    /* Collect the subtrees, walking tree edges downwards */
+    for (vertex_t i = 0; i < num_affected; i++) {
+        vertex_t x = r->subtree[i];
+        for (Edge *edge = g->adj_list[x]; edge != NULL; edge = edge->next) {
+            vertex_t c = edge->destination;
+            stats.edges_scanned++;
+            if (parent[c] == x && !r->affected[c]) {
+                r->affected[c] = true;
+                r->subtree[num_affected++] = c;
+            }
+        }
+    }
+
+    for (vertex_t i = 0; i < num_affected; i++) {
+        vertex_t v = r->subtree[i];
+        distance[v] = INF;
+        parent[v] = -1;
+        if (result->owner != NULL) result->owner[v] = -1;
+    }
+
+    /* Best offer from the unaffected part of the tree */
+    for (vertex_t i = 0; i < num_affected; i++) {
+        vertex_t v = r->subtree[i];
+        for (edge_t j = r->in_offsets[v]; j < r->in_offsets[v + 1]; j++) {
+            vertex_t u = r->in_sources[j];
+            stats.edges_scanned++;
+            if (r->affected[u]) continue;
+            int candidate = dist_add(distance[u], r->in_edges[j]->weight);
+            if (candidate < distance[v]) {
+                improve(r, result, v, candidate, u, &stats);
+            }
+        }
+    }
+
+    /* 2. Edges that became shorter */
+    for (size_t i = 0; i < count; i++) {
+        vertex_t u = changes[i].source;
+        vertex_t v = changes[i].edge->destination;
+        int candidate = dist_add(distance[u], changes[i].edge->weight);
+        if (candidate < distance[v]) {
+            improve(r, result, v, candidate, u, &stats);
+        }
+    }
+
+    for (vertex_t i = 0; i < num_affected; i++) {
+        r->affected[r->subtree[i]] = false;
+    }
+
+    /* 3. Propagate the improvements */
+    while (!heap_empty(&r->heap)) {
+        vertex_t u = heap_pop(&r->heap).vertex;
+        int du = distance[u];
+        stats.heap_pops++;
+        stats.vertices_settled++;
+
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            stats.edges_scanned++;
+            int candidate = dist_add(du, edge->weight);
+            if (candidate < distance[edge->destination]) {
+                improve(r, result, edge->destination, candidate, u, &stats);
+            }
+        }
+    }
+
+    result->stats = stats;
+    return true;
+}
@@ -0,0 +1,630 @@
+/*
+ * generators.c - Deterministic Large-Scale Graph Generators
+ *
+ * Four synthetic families, for sizing hardware and testing engines at
+ * 10^6 - 10^8 edges:
+ *
+ *   GRAPH_GRID         2D / 3D grid, symmetric uniform random weights
+ *   GRAPH_GEOMETRIC    random geometric graph with coordinates (A*)
+ *   GRAPH_RMAT         R-MAT power-law graph (Graph500 style)
+ *   GRAPH_ERDOS_RENYI  G(n, m)
+ *
+ * Reproducibility:
+ *   Every random number is a pure function of (seed, key): the key-th
+ *   output of a SplitMix64 stream, computed directly, without state
+ *   carried from one edge to the next. The same spec therefore gives the
+ *   same graph bit for bit on every run, and any part of the edge
+ *   stream can be replayed on its own.
+ *
+ * Streaming:
+ *   No EdgeList and no add_edge(). A generator only emits the edges whose
+ *   source lies in a vertex range, into an EdgeSink, and is run twice:
+ *
+ *     pass 1 (count)  out-degrees → prefix sum → CSR offsets
+ *     pass 2 (fill)   each edge written straight into its CSR slot
+ *
+ *   Peak memory is the CSR itself (plus the points of a geometric
+ *   graph). generate_graph_file() goes one step further and fills the
+ *   edge arrays one vertex range at a time through a bounded buffer,
+ *   writing each slice to the binary graph file as it is done, so a
+ *   graph larger than memory can be produced and later mmap()ed.
+ *
+ *   Grids and geometric graphs emit a vertex range in time proportional
+ *   to its edges. R-MAT and G(n, m) draw sources at random, so each pass
+ *   replays the whole stream and keeps the edges in range.
+ */
+
+#include "dijkstra.h"
+#include <string.h>
+
+#define GENERATOR_GOLDEN         0x9E3779B97F4A7C15ULL
+#define GENERATOR_DEFAULT_BUFFER ((size_t)256 << 20)  /* 256 MiB of edges per slice */
+
+/*
+ * Generator - A spec plus the state derived from it
+ *
+ * Members:
+ *   spec:           Validated copy of the spec
+ *   n:              Number of vertices
+ *   points:         Geometric: coordinates in vertex order (vertices are
+ *                   numbered cell by cell, so neighbors get nearby ids)
+ *   cell_start:     Geometric: vertices of cell c are cell_start[c] ..
+ *                   cell_start[c + 1] - 1
+ *   cells_per_side: Geometric: the square is cut into cells_per_side^2
+ *                   cells no smaller than the radius
+ *   cell_size:      Geometric: side length of one cell
+ */
+typedef struct Generator {
+    GraphSpec spec;
+    vertex_t n;
+    VertexCoord *points;
+    vertex_t *cell_start;
+    vertex_t cells_per_side;
+    double cell_size;
+} Generator;
+
+/*
+ * EdgeSink - Where emitted edges go
+ *
+ * Members:
+ *   lo, hi:       Only edges with lo <= source < hi are kept
+ *   count:        Count pass (cursor NULL): count[u - lo + 1]++ per edge
+ *   cursor:       Fill pass: cursor[u - lo] is the CSR slot of u's next edge
+ *   base:         CSR index of destinations[0] / weights[0]
+ *   destinations, weights: Output slice
+ */
+typedef struct EdgeSink {
+    vertex_t lo;
+    vertex_t hi;
+    edge_t *count;
+    edge_t *cursor;
+    edge_t base;
+    vertex_t *destinations;
+    int *weights;
+} EdgeSink;
+
+/*
+ * emit - Hands one edge to the sink
+ */
+static inline void emit(EdgeSink *sink, vertex_t u, vertex_t v, int w) {
+    if (u < sink->lo || u >= sink->hi) return;
+    if (sink->cursor == NULL) {
+        sink->count[u - sink->lo + 1]++;
+        return;
+    }
+    edge_t slot = sink->cursor[u - sink->lo]++ - sink->base;
+    sink->destinations[slot] = v;
+    sink->weights[slot] = w;
+}
+
+/*====================================================================
+ * RANDOM NUMBERS
+ *====================================================================*/
+
+/*
+ * mix64 - SplitMix64 finalizer (a bijection on 64-bit words)
+ */
+static inline uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * random_at - The key-th output of the SplitMix64 stream of @seed
+ */
+static inline uint64_t random_at(uint64_t seed, uint64_t key) {
+    return mix64(seed + (key + 1) * GENERATOR_GOLDEN);
+}
+
+/*
+ * random_unit - Uniform double in [0, 1) from the top 53 bits
+ */
+static inline double random_unit(uint64_t r) {
+    return (double)(r >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * random_weight - Uniform weight in [min_weight, max_weight]
+ */
+static inline int random_weight(const GraphSpec *spec, uint64_t r) {
+    uint64_t range = (uint64_t)spec->max_weight - (uint64_t)spec->min_weight + 1;
+    return spec->min_weight + (int)(r % range);
+}
+
+/*====================================================================
+ * SPECS
+ *====================================================================*/
+
+/*
+ * base_spec - Fields shared by every family
+ */
+static GraphSpec base_spec(GraphFamily family, int max_weight, uint64_t seed) {
+    GraphSpec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.family = family;
+    spec.seed = seed;
+    spec.depth = 1;
+    spec.min_weight = 1;
+    spec.max_weight = max_weight;
+    return spec;
+}
+
+/*
+ * grid_spec - width x height x depth grid (depth 1: 2D, with coordinates)
+ *
+ * Every vertex is joined to its 4 (2D) or 6 (3D) axis neighbors in both
+ * directions; both directions share one weight in [1, max_weight].
+ */
+GraphSpec grid_spec(vertex_t width, vertex_t height, vertex_t depth, int max_weight, uint64_t seed) {
+    GraphSpec spec = base_spec(GRAPH_GRID, max_weight, seed);
+    spec.width = width;
+    spec.height = height;
+    spec.depth = depth;
+    return spec;
+}
+
+/*
+ * geometric_spec - Random geometric graph
+ *
+ * @num_vertices: Points, uniform in a sqrt(n) x sqrt(n) square
+ * @radius:       Connection radius (average degree ~ pi * radius^2)
+ * @max_weight:   Weight of an edge of length radius; shorter edges scale
+ *                down proportionally
+ */
+GraphSpec geometric_spec(vertex_t num_vertices, double radius, int max_weight, uint64_t seed) {
+    GraphSpec spec = base_spec(GRAPH_GEOMETRIC, max_weight, seed);
+    spec.num_vertices = num_vertices;
+    spec.radius = radius;
+    return spec;
+}
+
+/*
+ * rmat_spec - R-MAT graph on 2^scale vertices with the Graph500
+ *             probabilities a, b, c, d = 0.57, 0.19, 0.19, 0.05
+ */
+GraphSpec rmat_spec(int scale, edge_t num_edges, int max_weight, uint64_t seed) {
+    GraphSpec spec = base_spec(GRAPH_RMAT, max_weight, seed);
+    spec.scale = scale;
+    spec.num_edges = num_edges;
+    spec.a = 0.57;
+    spec.b = 0.19;
+    spec.c = 0.19;
+    return spec;
+}
+
+/*
+ * erdos_renyi_spec - G(n, m): num_edges directed edges, both end points
+ *                    uniform (no self-loops; parallel edges possible)
+ */
+GraphSpec erdos_renyi_spec(vertex_t num_vertices, edge_t num_edges, int max_weight, uint64_t seed) {
+    GraphSpec spec = base_spec(GRAPH_ERDOS_RENYI, max_weight, seed);
+    spec.num_vertices = num_vertices;
+    spec.num_edges = num_edges;
+    return spec;
+}
+
+/*====================================================================
+ * GENERATORS
+ *====================================================================*/
+
+/*
+ * geometric_point - Coordinates of the i-th point drawn (before sorting)
+ */
+static inline VertexCoord geometric_point(const GraphSpec *spec, double side, vertex_t i) {
+    VertexCoord p;
+    p.x = side * random_unit(random_at(spec->seed, 2 * (uint64_t)i));
+    p.y = side * random_unit(random_at(spec->seed, 2 * (uint64_t)i + 1));
+    return p;
+}
+
+/*
+ * geometric_cell - Cell index of a point
+ */
+static inline vertex_t geometric_cell(const Generator *gen, VertexCoord p) {
+    vertex_t cx = (vertex_t)(p.x / gen->cell_size);
+    vertex_t cy = (vertex_t)(p.y / gen->cell_size);
+    if (cx >= gen->cells_per_side) cx = gen->cells_per_side - 1;
+    if (cy >= gen->cells_per_side) cy = gen->cells_per_side - 1;
+    return cy * gen->cells_per_side + cx;
+}
+
+/*
+ * init_geometric - Draws the points and sorts them into cells
+ *
+ * Counting sort by cell, drawing each point twice (once to count, once
+ * to place) rather than storing an unsorted copy.
+ *
+ * Time Complexity: O(V)
+ *
+ * Return: true on success
+ */
+static bool init_geometric(Generator *gen) {
+    vertex_t n = gen->n;
+    double side = sqrt((double)n);
+    double cells = floor(side / gen->spec.radius);
+    /* Cells no smaller than the radius, and no more cells than points */
+    if (cells < 1) cells = 1;
+    if (cells * cells > (double)n) cells = floor(side);
+    gen->cells_per_side = (vertex_t)cells;
+    gen->cell_size = side / cells;
+
+    vertex_t num_cells = gen->cells_per_side * gen->cells_per_side;
+    gen->points = (VertexCoord *)malloc(((size_t)n + 1) * sizeof(VertexCoord));
+    gen->cell_start = (vertex_t *)calloc((size_t)num_cells + 1, sizeof(vertex_t));
+    if (gen->points == NULL || gen->cell_start == NULL) {
+        fprintf(stderr, "Error: Failed to allocate %" PRIdVERTEX " geometric points\n", n);
+        return false;
+    }
+
+    for (vertex_t i = 0; i < n; i++) {
+        gen->cell_start[geometric_cell(gen, geometric_point(&gen->spec, side, i)) + 1]++;
+    }
+    for (vertex_t c = 0; c < num_cells; c++) {
+        gen->cell_start[c + 1] += gen->cell_start[c];
+    }
+    for (vertex_t i = 0; i < n; i++) {
+        VertexCoord p = geometric_point(&gen->spec, side, i);
+        gen->points[gen->cell_start[geometric_cell(gen, p)]++] = p;
+    }
+    /* cell_start[c] advanced to the start of c + 1: shift back by one */
+    for (vertex_t c = num_cells; c > 0; c--) {
+        gen->cell_start[c] = gen->cell_start[c - 1];
+    }
+    gen->cell_start[0] = 0;
+    return true;
+}
+
+/*
+ * emit_grid - Edges of the grid vertices in [sink->lo, sink->hi)
+ *
+ * The weight of {u, u + step} is keyed by the lower end point and the
+ * axis, so both directions get the same value from either side.
+ */
+static void emit_grid(const Generator *gen, EdgeSink *sink) {
+    const GraphSpec *spec = &gen->spec;
+    vertex_t w = spec->width, h = spec->height, d = spec->depth;
+    vertex_t plane = w * h;
+
+    for (vertex_t u = sink->lo; u < sink->hi; u++) {
+        vertex_t x = u % w, y = (u / w) % h, z = u / plane;
+        uint64_t key = 3 * (uint64_t)u;
+        if (x > 0) emit(sink, u, u - 1, random_weight(spec, random_at(spec->seed, key - 3)));
+        if (x + 1 < w) emit(sink, u, u + 1, random_weight(spec, random_at(spec->seed, key)));
+        if (y > 0) {
+            emit(sink, u, u - w, random_weight(spec, random_at(spec->seed, key - 3 * (uint64_t)w + 1)));
+        }
+        if (y + 1 < h) emit(sink, u, u + w, random_weight(spec, random_at(spec->seed, key + 1)));
+        if (z > 0) {
+            emit(sink, u, u - plane,
+                 random_weight(spec, random_at(spec->seed, key - 3 * (uint64_t)plane + 2)));
+        }
+        if (z + 1 < d) emit(sink, u, u + plane, random_weight(spec, random_at(spec->seed, key + 2)));
+    }
+}
+
+/*
+ * emit_geometric - Edges of the geometric vertices in [sink->lo, sink->hi)
+ *
+ * Neighbors of u lie in u's cell or the 8 around it (cells are at least
+ * radius wide); they are emitted in cell order, then id order.
+ */
+static void emit_geometric(const Generator *gen, EdgeSink *sink) {
+    const GraphSpec *spec = &gen->spec;
+    double r = spec->radius;
+    vertex_t cps = gen->cells_per_side;
+
+    for (vertex_t u = sink->lo; u < sink->hi; u++) {
+        VertexCoord p = gen->points[u];
+        vertex_t cell = geometric_cell(gen, p);
+        vertex_t cx = cell % cps, cy = cell / cps;
+
+        for (vertex_t ny = cy - 1; ny <= cy + 1; ny++) {
+            if (ny < 0 || ny >= cps) continue;
+            for (vertex_t nx = cx - 1; nx <= cx + 1; nx++) {
+                if (nx < 0 || nx >= cps) continue;
+                vertex_t c = ny * cps + nx;
+                for (vertex_t v = gen->cell_start[c]; v < gen->cell_start[c + 1]; v++) {
+                    double dx = gen->points[v].x - p.x, dy = gen->points[v].y - p.y;
+                    double d2 = dx * dx + dy * dy;
+                    if (v == u || d2 > r * r) continue;
+                    int w = (int)ceil((double)spec->max_weight * sqrt(d2) / r);
+                    emit(sink, u, v, (w < spec->min_weight) ? spec->min_weight : w);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * emit_rmat - Replays all R-MAT edges, keeping those in the sink's range
+ *
+ * Edge i descends the adjacency matrix one bit of (u, v) at a time,
+ * picking quadrant a / b / c / d. Each 64-bit random word serves four
+ * levels as 16-bit fractions, so probabilities are exact to 2^-16, and
+ * the quadrant is picked without branches (they would mispredict on a
+ * large share of the levels). The ids are then scrambled by a bijection
+ * of [0, 2^scale), as in Graph500, so the hubs are not all at small ids.
+ */
+static void emit_rmat(const Generator *gen, EdgeSink *sink) {
+    const GraphSpec *spec = &gen->spec;
+    int scale = spec->scale;
+    uint64_t mask = ((uint64_t)1 << scale) - 1;
+    uint64_t ta = (uint64_t)(spec->a * 65536.0);
+    uint64_t tb = (uint64_t)((spec->a + spec->b) * 65536.0);
+    uint64_t tc = (uint64_t)((spec->a + spec->b + spec->c) * 65536.0);
+    uint64_t words = (uint64_t)scale / 4 + 2;   /* bits, then one for the weight */
+    uint64_t offset = mix64(spec->seed) & mask;
+
+    for (edge_t i = 0; i < spec->num_edges; i++) {
+        uint64_t key = (uint64_t)i * words;
+        uint64_t u = 0, v = 0;
+        for (int bit = 0; bit < scale; bit += 4) {
+            uint64_t r = random_at(spec->seed, key++);
+            int levels = (scale - bit < 4) ? scale - bit : 4;
+            for (int j = 0; j < levels; j++) {
+                uint64_t p = (r >> (16 * j)) & 0xFFFF;
+                /* Branch-free: c or d sets the u bit, b or d the v bit */
+                u |= (uint64_t)(p >= tb) << (bit + j);
+                v |= (uint64_t)((p >= ta) ^ (p >= tb) ^ (p >= tc)) << (bit + j);
+            }
+        }
+        u = ((u * GENERATOR_GOLDEN) + offset) & mask;
+        v = ((v * GENERATOR_GOLDEN) + offset) & mask;
+        int w = random_weight(spec, random_at(spec->seed, (uint64_t)i * words + words - 1));
+        emit(sink, (vertex_t)u, (vertex_t)v, w);
+    }
+}
+
+/*
+ * emit_erdos_renyi - Replays all G(n, m) edges, keeping those in range
+ *
+ * v is drawn from the n - 1 vertices other than u, so there are no
+ * self-loops and no rejection loop.
+ */
+static void emit_erdos_renyi(const Generator *gen, EdgeSink *sink) {
+    const GraphSpec *spec = &gen->spec;
+    uint64_t n = (uint64_t)gen->n;
+
+    for (edge_t i = 0; i < spec->num_edges; i++) {
+        uint64_t key = 3 * (uint64_t)i;
+        uint64_t u = random_at(spec->seed, key) % n;
+        uint64_t v = (u + 1 + random_at(spec->seed, key + 1) % (n - 1)) % n;
+        emit(sink, (vertex_t)u, (vertex_t)v, random_weight(spec, random_at(spec->seed, key + 2)));
+    }
+}
+
+/*
+ * emit_edges - Runs the generator of the spec's family over the sink
+ */
+static void emit_edges(const Generator *gen, EdgeSink *sink) {
+    switch (gen->spec.family) {
+    case GRAPH_GRID:        emit_grid(gen, sink); break;
+    case GRAPH_GEOMETRIC:   emit_geometric(gen, sink); break;
+    case GRAPH_RMAT:        emit_rmat(gen, sink); break;
+    case GRAPH_ERDOS_RENYI: emit_erdos_renyi(gen, sink); break;
+    }
+}
+
+/*
+ * free_generator - Frees the derived state (not the Generator itself)
+ */
+static void free_generator(Generator *gen) {
+    free(gen->points);
+    free(gen->cell_start);
+}
+
+/*
+ * init_generator - Validates a spec and derives the generator state
+ *
+ * Return: true on success; false on an invalid spec (message on stderr)
+ */
+static bool init_generator(Generator *gen, const GraphSpec *spec) {
+    memset(gen, 0, sizeof(*gen));
+    if (spec == NULL) {
+        fprintf(stderr, "Error: NULL graph spec\n");
+        return false;
+    }
+    gen->spec = *spec;
+
+    double max_vertices = (double)((sizeof(vertex_t) == 8) ? INT64_MAX : INT32_MAX);
+    bool valid = spec->min_weight >= 0 && spec->max_weight >= spec->min_weight;
+    switch (spec->family) {
+    case GRAPH_GRID:
+        valid = valid && spec->width > 0 && spec->height > 0 && spec->depth > 0 &&
+                (double)spec->width * (double)spec->height * (double)spec->depth < max_vertices;
+        if (valid) gen->n = spec->width * spec->height * spec->depth;
+        break;
+    case GRAPH_GEOMETRIC:
+        valid = valid && spec->num_vertices > 0 && spec->radius > 0;
+        gen->n = spec->num_vertices;
+        break;
+    case GRAPH_RMAT:
+        valid = valid && spec->scale >= 0 && spec->scale < (int)(8 * sizeof(vertex_t)) - 1 &&
+                spec->num_edges >= 0 && spec->a >= 0 && spec->b >= 0 && spec->c >= 0 &&
+                spec->a + spec->b + spec->c <= 1.0;
+        if (valid) gen->n = (vertex_t)1 << spec->scale;
+        break;
+    case GRAPH_ERDOS_RENYI:
+        valid = valid && spec->num_vertices > 0 && spec->num_edges >= 0 &&
+                (spec->num_vertices > 1 || spec->num_edges == 0);
+        gen->n = spec->num_vertices;
+        break;
+    default:
+        valid = false;
+        break;
+    }
+    if (!valid) {
+        fprintf(stderr, "Error: Invalid graph spec\n");
+        return false;
+    }
+
+    if (spec->family == GRAPH_GEOMETRIC && !init_geometric(gen)) {
+        free_generator(gen);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * count_edges - Count pass: out-degrees prefix-summed into @offsets
+ *
+ * @offsets: n + 1 entries, zeroed by the caller; on return offsets[u] is
+ *           the CSR index of u's first edge and offsets[n] = |E|
+ */
+static void count_edges(const Generator *gen, edge_t *offsets) {
+    EdgeSink sink = { 0, gen->n, offsets, NULL, 0, NULL, NULL };
+    emit_edges(gen, &sink);
+    for (vertex_t u = 0; u < gen->n; u++) {
+        offsets[u + 1] += offsets[u];
+    }
+}
+
+/*====================================================================
+ * OUTPUT
+ *====================================================================*/
+
+/*
+ * generate_graph - Generates a graph into a CSR graph
+ *
+ * @spec: Graph parameters (see grid_spec() and friends)
+ *
+ * Edges of each vertex appear in generation order. Grids (2D) and
+ * geometric graphs come with coordinates.
+ *
+ * Time Complexity:  O(V + E) for grids / geometric graphs (for fixed
+ *                   radius); O(V + E log V) for R-MAT
+ * Space Complexity: The CSR graph only
+ *
+ * Return: New CSR graph, or NULL on failure. Free with free_csr_graph()
+ */
+CSRGraph *generate_graph(const GraphSpec *spec) {
+    Generator gen;
+    if (!init_generator(&gen, spec)) return NULL;
+
+    vertex_t n = gen.n;
+    CSRGraph *csr = (CSRGraph *)calloc(1, sizeof(CSRGraph));
+    edge_t *offsets = (edge_t *)calloc((size_t)n + 1, sizeof(edge_t));
+    if (csr == NULL || offsets == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for CSR graph\n");
+        free(csr);
+        free(offsets);
+        free_generator(&gen);
+        return NULL;
+    }
+    count_edges(&gen, offsets);
+
+    edge_t m = offsets[n];
+    csr->num_vertices = n;
+    csr->num_edges = m;
+    csr->offsets = offsets;
+    csr->destinations = (vertex_t *)malloc(((size_t)m + 1) * sizeof(vertex_t));
+    csr->weights = (int *)malloc(((size_t)m + 1) * sizeof(int));
+    if (csr->destinations == NULL || csr->weights == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for %" PRIdEDGE " edges\n", m);
+        free_csr_graph(csr);
+        free_generator(&gen);
+        return NULL;
+    }
+
+    /* Fill pass, with offsets as the cursors (they end one vertex ahead) */
+    EdgeSink sink = { 0, n, NULL, offsets, 0, csr->destinations, csr->weights };
+    emit_edges(&gen, &sink);
+    for (vertex_t u = n; u > 0; u--) {
+        offsets[u] = offsets[u - 1];
+    }
+    offsets[0] = 0;
+
+    /* Points of geometric graphs and 2D grids become the coordinates */
+    if (spec->family == GRAPH_GEOMETRIC) {
+        csr->coords = gen.points;
+        gen.points = NULL;
+    } else if (spec->family == GRAPH_GRID && spec->depth == 1) {
+        csr->coords = (VertexCoord *)malloc(((size_t)n + 1) * sizeof(VertexCoord));
+        if (csr->coords == NULL) {
+            fprintf(stderr, "Error: Failed to allocate memory for CSR coordinates\n");
+            free_csr_graph(csr);
+            csr = NULL;
+        }
+        for (vertex_t u = 0; csr != NULL && u < n; u++) {
+            csr->coords[u].x = (double)(u % spec->width);
+            csr->coords[u].y = (double)(u / spec->width);
+        }
+    }
+
+    free_generator(&gen);
+    return csr;
+}
+
+/*
+ * generate_graph_file - Generates a graph straight into a binary graph file
+ *
+ * @spec:         Graph parameters
+ * @path:         Output file, readable with map_csr_graph() / load_graph()
+ * @buffer_bytes: Memory for edges in flight (0 = 256 MiB); raised to the
+ *                largest out-degree if that does not fit
+ *
+ * After the count pass, vertices are cut into consecutive ranges whose
+ * edges fit the buffer. Each range is generated, placed in CSR order and
+ * written to its final position in the file. The file is identical to
+ * save_csr_graph(generate_graph(spec)); coordinates are not stored.
+ *
+ * Time Complexity:  O(V + E) for grids / geometric graphs; one replay
+ *                   of the edge stream per range for R-MAT / G(n, m)
+ * Space Complexity: O(V) + buffer_bytes
+ *
+ * Return: true on success
+ */
+bool generate_graph_file(const GraphSpec *spec, const char *path, size_t buffer_bytes) {
+    if (path == NULL) {
+        fprintf(stderr, "Error: NULL path in generate_graph_file()\n");
+        return false;
+    }
+    Generator gen;
+    if (!init_generator(&gen, spec)) return false;
+
+    vertex_t n = gen.n;
+    edge_t *offsets = (edge_t *)calloc((size_t)n + 1, sizeof(edge_t));
+    edge_t *cursor = (edge_t *)malloc(((size_t)n + 1) * sizeof(edge_t));
+    if (offsets == NULL || cursor == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for %" PRIdVERTEX " offsets\n", n);
+        free(offsets);
+        free(cursor);
+        free_generator(&gen);
+        return false;
+    }
+    count_edges(&gen, offsets);
+
+    edge_t m = offsets[n];
+    edge_t capacity = (edge_t)((buffer_bytes > 0 ? buffer_bytes : GENERATOR_DEFAULT_BUFFER) /
+                               (sizeof(vertex_t) + sizeof(int)));
+    for (vertex_t u = 0; u < n; u++) {
+        if (offsets[u + 1] - offsets[u] > capacity) capacity = offsets[u + 1] - offsets[u];
+    }
+    if (capacity > m) capacity = m;
+
+    vertex_t *destinations = (vertex_t *)malloc(((size_t)capacity + 1) * sizeof(vertex_t));
+    int *weights = (int *)malloc(((size_t)capacity + 1) * sizeof(int));
+    GraphFileWriter *w = (destinations != NULL && weights != NULL)
+                       ? create_graph_file(path, n, m, offsets) : NULL;
+    bool ok = (w != NULL);
+
+    for (vertex_t lo = 0, hi; ok && lo < n; lo = hi) {
+        hi = lo + 1;
+        while (hi < n && offsets[hi + 1] - offsets[lo] <= capacity) hi++;
+
+        memcpy(cursor, offsets + lo, (size_t)(hi - lo) * sizeof(edge_t));
+        EdgeSink sink = { lo, hi, NULL, cursor, offsets[lo], destinations, weights };
+        emit_edges(&gen, &sink);
+        ok = write_graph_file_edges(w, offsets[lo], destinations, weights,
+                                    offsets[hi] - offsets[lo]);
+    }
+
+    if (w != NULL && !close_graph_file(w)) ok = false;
+    free(destinations);
+    free(weights);
+    free(offsets);
+    free(cursor);
+    free_generator(&gen);
+    return ok;
+}
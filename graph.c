@@ -5,20 +5,108 @@
  * 
  * Key Design Decisions:
  * 1. Adjacency list for space efficiency on sparse graphs
- * 2. Linked list for edge storage (simple, O(1) insertion)
+ * 2. Linked list for edge storage (simple, O(1) insertion), with the
+ *    nodes carved from an arena of large blocks (no malloc per edge)
  * 3. Defensive programming with input validation
  * 4. Careful memory management to prevent leaks
  */
 
 #include "dijkstra.h"
 
+/*============================================================================
+ * EDGE ARENA
+ * 
+ * Edges are never freed one at a time (remove_edge() only unlinks the
+ * node), so they can live in a chain of blocks released together. Block sizes
+ * double from EDGE_BLOCK_MIN up to EDGE_BLOCK_MAX edges and stay there; a
+ * bulk insert that does not fit gets max(next size, count) edges, so one
+ * larger than EDGE_BLOCK_MAX still lands in a single block.
+ *===========================================================================*/
+
+#define EDGE_BLOCK_MIN 64
+#define EDGE_BLOCK_MAX (1 << 20)
+
+struct EdgeBlock {
+    EdgeBlock *next;     /* Older block */
+    size_t used;         /* Edges handed out from this block */
+    size_t capacity;     /* Edges this block holds */
+    Edge edges[];
+};
+
+/*
+ * reserve_edges - Makes room for count more edges in the newest block
+ * 
+ * @g:     Pointer to the graph
+ * @count: Number of edges about to be added (at least 1)
+ * 
+ * The unused tail of a full block is abandoned; it is at most one
+ * block's worth and is reclaimed by free_graph() like the rest.
+ * 
+ * Time Complexity: O(1)
+ * 
+ * Return: true if the newest block has count free slots
+ */
+static bool reserve_edges(Graph *g, size_t count) {
+    EdgeBlock *head = g->edge_blocks;
+    if (head != NULL && head->capacity - head->used >= count) return true;
+    
+    size_t capacity = (head == NULL) ? EDGE_BLOCK_MIN : head->capacity * 2;
+    if (capacity > EDGE_BLOCK_MAX) capacity = EDGE_BLOCK_MAX;
+    if (capacity < count) capacity = count;
+    
+    EdgeBlock *block = (EdgeBlock *)malloc(sizeof(EdgeBlock) + capacity * sizeof(Edge));
+    if (block == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for %zu edges\n", capacity);
+        return false;
+    }
+    block->next = head;
+    block->used = 0;
+    block->capacity = capacity;
+    g->edge_blocks = block;
+    return true;
+}
+
+/*
+ * link_edge - Pushes an edge from the reserved block onto src's list
+ * 
+ * Inputs are already validated and a slot is reserved.
+ */
+static inline void link_edge(Graph *g, vertex_t src, vertex_t dest, int weight) {
+    EdgeBlock *block = g->edge_blocks;
+    Edge *edge = &block->edges[block->used++];
+    
+    edge->destination = dest;
+    edge->weight = weight;
+    
+    /*
+     * Insert at head of list
+     * 
+     * Before: adj_list[src] -> A -> B -> NULL
+     * After:  adj_list[src] -> new_edge -> A -> B -> NULL
+     */
+    edge->next = g->adj_list[src];
+    g->adj_list[src] = edge;
+    g->num_edges++;
+    g->edges_linked++;
+    
+    /* Keep the dense copy (if any) in step: it holds the lightest parallel edge */
+    if (g->matrix != NULL) {
+        int *cell = &g->matrix[(size_t)src * (size_t)g->matrix_stride + (size_t)dest];
+        if (weight < *cell) *cell = weight;
+    }
+}
+
+/*============================================================================
+ * GRAPH CONSTRUCTION
+ *===========================================================================*/
+
 /*
  * create_graph - Allocates and initializes a new graph
  * 
- * @vertices: Number of vertices in the graph
+ * @vertices: Initial number of vertices (0 is allowed; see add_vertex())
  * 
  * Algorithm:
- * 1. Validate input (positive, within bounds)
+ * 1. Validate input (non-negative)
  * 2. Allocate Graph structure
  * 3. Allocate array of Edge pointers
  * 4. Initialize all lists to NULL (empty)
@@ -30,14 +118,11 @@
  * 
  * IMPORTANT: Caller is responsible for calling free_graph() later!
  */
-Graph *create_graph(int vertices) {
+Graph *create_graph(vertex_t vertices) {
     /* Input validation */
-    if (vertices <= 0) {
-        fprintf(stderr, "Error: Number of vertices must be positive (got %d)\n", vertices);
-        return NULL;
-    }
-    if (vertices > MAX_VERTICES) {
-        fprintf(stderr, "Error: Too many vertices (%d > %d max)\n", vertices, MAX_VERTICES);
+    if (vertices < 0) {
+        fprintf(stderr, "Error: Number of vertices must be non-negative (got %" PRIdVERTEX ")\n",
+                vertices);
         return NULL;
     }
     
@@ -50,7 +135,13 @@ Graph *create_graph(int vertices) {
     
     /* Initialize fields */
     g->num_vertices = vertices;
+    g->capacity = (vertices > 0) ? vertices : 1;
     g->num_edges = 0;
+    g->edges_linked = 0;
+    g->coords = NULL;
+    g->matrix = NULL;
+    g->matrix_stride = 0;
+    g->edge_blocks = NULL;
     
     /*
      * Allocate array of adjacency list heads
@@ -61,7 +152,7 @@ Graph *create_graph(int vertices) {
      *   - calloc checks for overflow in n * size
      *   - malloc may be slightly faster but requires explicit initialization
      */
-    g->adj_list = (Edge **)calloc(vertices, sizeof(Edge *));
+    g->adj_list = (Edge **)calloc((size_t)g->capacity, sizeof(Edge *));
     if (g->adj_list == NULL) {
         fprintf(stderr, "Error: Failed to allocate memory for adjacency lists\n");
         free(g);  /* Clean up already allocated memory */
@@ -72,6 +163,139 @@ Graph *create_graph(int vertices) {
     return g;
 }
 
+/*
+ * add_vertex - Appends a new isolated vertex to the graph
+ * 
+ * @g: Pointer to the graph
+ * 
+ * When adj_list is full its capacity is doubled, so a sequence of
+ * add_vertex() calls costs amortized O(1) each.
+ * 
+ * Return: Id of the new vertex, or -1 on failure
+ */
+vertex_t add_vertex(Graph *g) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph pointer in add_vertex()\n");
+        return -1;
+    }
+    
+    if (g->num_vertices == g->capacity) {
+        vertex_t new_capacity = g->capacity * 2;
+        Edge **grown = (Edge **)realloc(g->adj_list,
+                                        (size_t)new_capacity * sizeof(Edge *));
+        if (grown == NULL) {
+            fprintf(stderr, "Error: Failed to grow adjacency lists to %" PRIdVERTEX "\n",
+                    new_capacity);
+            return -1;
+        }
+        g->adj_list = grown;
+        
+        if (g->coords != NULL) {
+            VertexCoord *coords = (VertexCoord *)realloc(g->coords,
+                                                         (size_t)new_capacity * sizeof(VertexCoord));
+            if (coords == NULL) {
+                fprintf(stderr, "Error: Failed to grow vertex coordinates to %" PRIdVERTEX "\n",
+                        new_capacity);
+                return -1;
+            }
+            g->coords = coords;
+        }
+        g->capacity = new_capacity;
+    }
+    
+    g->adj_list[g->num_vertices] = NULL;
+    if (g->coords != NULL) {
+        g->coords[g->num_vertices] = (VertexCoord){0.0, 0.0};
+    }
+    
+    /* Padding rows / columns are already INF; a full matrix is rebuilt on demand */
+    if (g->matrix != NULL && g->num_vertices == g->matrix_stride) {
+        free(g->matrix);
+        g->matrix = NULL;
+        g->matrix_stride = 0;
+    }
+    return g->num_vertices++;
+}
+
+/*
+ * set_vertex_coord - Attaches a position to a vertex
+ * 
+ * @g:    Pointer to the graph
+ * @v:    Vertex index (0 to V-1)
+ * @x, y: Coordinates (plane units, or longitude / latitude in degrees)
+ * 
+ * The coordinate array is allocated on first use, so graphs without
+ * coordinates pay nothing. They are only needed for A* heuristics.
+ * 
+ * Time Complexity: O(1), O(V) for the first call
+ * 
+ * Return: true on success
+ */
+bool set_vertex_coord(Graph *g, vertex_t v, double x, double y) {
+    if (g == NULL || v < 0 || v >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to set_vertex_coord()\n");
+        return false;
+    }
+    
+    if (g->coords == NULL) {
+        g->coords = (VertexCoord *)calloc((size_t)g->capacity, sizeof(VertexCoord));
+        if (g->coords == NULL) {
+            fprintf(stderr, "Error: Failed to allocate memory for vertex coordinates\n");
+            return false;
+        }
+    }
+    
+    g->coords[v].x = x;
+    g->coords[v].y = y;
+    return true;
+}
+
+/*
+ * build_weight_matrix - Builds the dense V×V copy of the edges
+ *
+ * @g: Pointer to the graph
+ *
+ * Rows are padded to a multiple of 16 entries (one 64-byte cache line),
+ * so the SIMD kernels of dijkstra_dense() never need a scalar tail, and
+ * add_vertex() can add vertices into the padding. Parallel edges keep
+ * the lightest weight. Any previous matrix is replaced.
+ *
+ * Time Complexity: O(V² + E)
+ * Space Complexity: O(V²) - 4 bytes per vertex pair
+ *
+ * Return: true on success
+ */
+bool build_weight_matrix(Graph *g) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: NULL graph pointer in build_weight_matrix()\n");
+        return false;
+    }
+
+    vertex_t stride = (g->num_vertices + 16) / 16 * 16;
+    size_t cells = (size_t)stride * (size_t)stride;
+    int *matrix = (int *)malloc(cells * sizeof(int));
+    if (matrix == NULL) {
+        fprintf(stderr, "Error: Failed to allocate a %" PRIdVERTEX " x %" PRIdVERTEX
+                " weight matrix\n", stride, stride);
+        return false;
+    }
+
+    for (size_t c = 0; c < cells; c++) {
+        matrix[c] = INF;
+    }
+    for (vertex_t u = 0; u < g->num_vertices; u++) {
+        int *row = matrix + (size_t)u * (size_t)stride;
+        for (Edge *edge = g->adj_list[u]; edge != NULL; edge = edge->next) {
+            if (edge->weight < row[edge->destination]) row[edge->destination] = edge->weight;
+        }
+    }
+
+    free(g->matrix);
+    g->matrix = matrix;
+    g->matrix_stride = stride;
+    return true;
+}
+
 /*
  * add_edge - Adds a directed edge to the graph
  * 
@@ -85,26 +309,30 @@ Graph *create_graph(int vertices) {
  * Implementation Note:
  * New edges are inserted at the HEAD of the adjacency list.
  * This gives O(1) insertion but edges appear in reverse order of insertion.
+ * The node comes from the edge arena, not from its own malloc().
  * 
  * Time Complexity: O(1)
+ * 
+ * Return: Handle of the new edge for update_edge_weight() /
+ *         remove_edge(), or NULL on invalid input
  */
-void add_edge(Graph *g, int src, int dest, int weight) {
+Edge *add_edge(Graph *g, vertex_t src, vertex_t dest, int weight) {
     /* Defensive programming: validate all inputs */
     if (g == NULL) {
         fprintf(stderr, "Error: NULL graph pointer in add_edge()\n");
-        return;
+        return NULL;
     }
     
     if (src < 0 || src >= g->num_vertices) {
-        fprintf(stderr, "Error: Source vertex %d out of range [0, %d)\n", 
+        fprintf(stderr, "Error: Source vertex %" PRIdVERTEX " out of range [0, %" PRIdVERTEX ")\n",
                 src, g->num_vertices);
-        return;
+        return NULL;
     }
     
     if (dest < 0 || dest >= g->num_vertices) {
-        fprintf(stderr, "Error: Destination vertex %d out of range [0, %d)\n", 
+        fprintf(stderr, "Error: Destination vertex %" PRIdVERTEX " out of range [0, %" PRIdVERTEX ")\n",
                 dest, g->num_vertices);
-        return;
+        return NULL;
     }
     
     /*
@@ -113,33 +341,187 @@ void add_edge(Graph *g, int src, int dest, int weight) {
      * The algorithm will still run but produce incorrect results.
      */
     if (weight < 0) {
-        fprintf(stderr, "WARNING: Negative edge weight %d on edge (%d, %d)\n", 
+        fprintf(stderr, "WARNING: Negative edge weight %d on edge (%" PRIdVERTEX ", %" PRIdVERTEX ")\n",
                 weight, src, dest);
         fprintf(stderr, "         Dijkstra's algorithm requires non-negative weights!\n");
         fprintf(stderr, "         Consider using Bellman-Ford instead.\n");
     }
     
-    /* Allocate new edge node */
-    Edge *new_edge = (Edge *)malloc(sizeof(Edge));
-    if (new_edge == NULL) {
-        fprintf(stderr, "Error: Failed to allocate memory for edge\n");
-        return;
+    if (!reserve_edges(g, 1)) return NULL;
+    link_edge(g, src, dest, weight);
+    return g->adj_list[src];
+}
+
+/*
+ * add_edges - Adds a batch of directed edges
+ * 
+ * @g:       Pointer to the graph
+ * @src:     Source vertex of each edge
+ * @dest:    Destination vertex of each edge
+ * @weights: Weight of each edge
+ * @count:   Number of edges
+ * 
+ * Same result as count calls to add_edge() in array order, but the
+ * whole batch is validated up front and its edges are carved from a
+ * single arena block. Negative weights are reported once per batch.
+ * 
+ * Time Complexity: O(count), one allocation
+ * 
+ * Return: true on success; on invalid input or allocation failure
+ *         nothing is added
+ */
+bool add_edges(Graph *g, const vertex_t *src, const vertex_t *dest, const int *weights,
+               edge_t count) {
+    if (g == NULL || count < 0 || (count > 0 && (src == NULL || dest == NULL || weights == NULL))) {
+        fprintf(stderr, "Error: Invalid input to add_edges()\n");
+        return false;
     }
+    if (count == 0) return true;
     
-    /* Initialize edge data */
-    new_edge->destination = dest;
-    new_edge->weight = weight;
+    edge_t negative = 0;
+    for (edge_t i = 0; i < count; i++) {
+        if (src[i] < 0 || src[i] >= g->num_vertices ||
+            dest[i] < 0 || dest[i] >= g->num_vertices) {
+            fprintf(stderr, "Error: Edge %" PRIdEDGE " (%" PRIdVERTEX ", %" PRIdVERTEX
+                    ") out of range [0, %" PRIdVERTEX ")\n", i, src[i], dest[i], g->num_vertices);
+            return false;
+        }
+        negative += (weights[i] < 0);
+    }
     
-    /*
-     * Insert at head of list
-     * 
-     * Before: adj_list[src] -> A -> B -> NULL
-     * After:  adj_list[src] -> new_edge -> A -> B -> NULL
-     */
-    new_edge->next = g->adj_list[src];
-    g->adj_list[src] = new_edge;
+    if (negative > 0) {
+        fprintf(stderr, "WARNING: %" PRIdEDGE " negative edge weights in add_edges()\n", negative);
+        fprintf(stderr, "         Dijkstra's algorithm requires non-negative weights!\n");
+    }
     
-    g->num_edges++;
+    if (!reserve_edges(g, (size_t)count)) return false;
+    for (edge_t i = 0; i < count; i++) {
+        link_edge(g, src[i], dest[i], weights[i]);
+    }
+    return true;
+}
+
+/*
+ * refresh_matrix_cell - Recomputes one dense-matrix cell from the lists
+ * 
+ * An edge got heavier or disappeared, so the cell's minimum over the
+ * parallel src → dest edges has to be taken again.
+ */
+static void refresh_matrix_cell(Graph *g, vertex_t src, vertex_t dest) {
+    if (g->matrix == NULL) return;
+    
+    int lightest = INF;
+    for (Edge *edge = g->adj_list[src]; edge != NULL; edge = edge->next) {
+        if (edge->destination == dest && edge->weight < lightest) lightest = edge->weight;
+    }
+    g->matrix[(size_t)src * (size_t)g->matrix_stride + (size_t)dest] = lightest;
+}
+
+/*
+ * edge_removed - Tells whether remove_edge() has unlinked an edge
+ * 
+ * A removed node points at itself, which no linked node does. The
+ * weight cannot tell: INF is also a valid weight for a linked edge.
+ */
+static inline bool edge_removed(const Edge *edge) {
+    return edge->next == edge;
+}
+
+/*
+ * in_list - Tells whether an edge is a node of src's adjacency list
+ */
+static bool in_list(const Graph *g, vertex_t src, const Edge *edge) {
+    for (const Edge *node = g->adj_list[src]; node != NULL; node = node->next) {
+        if (node == edge) return true;
+    }
+    return false;
+}
+
+/*
+ * update_edge_weight - Changes the weight of an existing edge
+ * 
+ * @g:      Pointer to the graph
+ * @src:    Source vertex of the edge. Must be the vertex @edge was added
+ *          from; this is checked only with a weight matrix, where src
+ *          selects the cell to update
+ * @edge:   Handle returned by add_edge() (or any node of src's list)
+ * @weight: New weight (INF makes the edge unusable but keeps it linked)
+ * 
+ * Shortest-path results computed earlier go stale; repair_result()
+ * brings them up to date without a full rerun.
+ * 
+ * Time Complexity: O(1), O(out-degree of src) with a weight matrix
+ * 
+ * Return: true on success, false for invalid input or a removed edge
+ */
+bool update_edge_weight(Graph *g, vertex_t src, Edge *edge, int weight) {
+    if (g == NULL || edge == NULL || src < 0 || src >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to update_edge_weight()\n");
+        return false;
+    }
+    if (edge_removed(edge)) {
+        fprintf(stderr, "Error: Edge (%" PRIdVERTEX ", %" PRIdVERTEX ") was removed\n",
+                src, edge->destination);
+        return false;
+    }
+    if (g->matrix != NULL && !in_list(g, src, edge)) {
+        fprintf(stderr, "Error: Edge to %" PRIdVERTEX " is not an edge of vertex %" PRIdVERTEX "\n",
+                edge->destination, src);
+        return false;
+    }
+    if (weight < 0) {
+        fprintf(stderr, "WARNING: Negative edge weight %d on edge (%" PRIdVERTEX ", %" PRIdVERTEX ")\n",
+                weight, src, edge->destination);
+        fprintf(stderr, "         Dijkstra's algorithm requires non-negative weights!\n");
+    }
+    
+    int old_weight = edge->weight;
+    edge->weight = weight;
+    if (weight > old_weight) {
+        refresh_matrix_cell(g, src, edge->destination);
+    } else if (g->matrix != NULL) {
+        int *cell = &g->matrix[(size_t)src * (size_t)g->matrix_stride + (size_t)edge->destination];
+        if (weight < *cell) *cell = weight;
+    }
+    return true;
+}
+
+/*
+ * remove_edge - Unlinks an edge from its source's adjacency list
+ * 
+ * @g:    Pointer to the graph
+ * @src:  Source vertex of the edge
+ * @edge: Handle returned by add_edge()
+ * 
+ * The node stays in the edge arena until free_graph() with its weight
+ * set to INF, so the handle remains readable: repair_result() treats it
+ * as an edge of infinite length. Its next pointer is set to the node
+ * itself, which marks it removed: a second remove_edge() and
+ * update_edge_weight() fail.
+ * 
+ * Time Complexity: O(out-degree of src) - finds the predecessor node
+ * 
+ * Return: true if the edge was found and removed, false (silently) if
+ *         it is not in src's list, e.g. because it was already removed
+ */
+bool remove_edge(Graph *g, vertex_t src, Edge *edge) {
+    if (g == NULL || edge == NULL || src < 0 || src >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to remove_edge()\n");
+        return false;
+    }
+    if (edge_removed(edge)) return false;
+    
+    for (Edge **link = &g->adj_list[src]; *link != NULL; link = &(*link)->next) {
+        if (*link == edge) {
+            *link = edge->next;
+            edge->next = edge;      /* Marks it removed, see edge_removed() */
+            edge->weight = INF;
+            g->num_edges--;
+            refresh_matrix_cell(g, src, edge->destination);
+            return true;
+        }
+    }
+    return false;   /* Already removed, or not an edge of src: not an error */
 }
 
 /*
@@ -155,7 +537,7 @@ void add_edge(Graph *g, int src, int dest, int weight) {
  * Convenience function for undirected graphs.
  * Internally calls add_edge twice.
  */
-void add_undirected_edge(Graph *g, int v1, int v2, int weight) {
+void add_undirected_edge(Graph *g, vertex_t v1, vertex_t v2, int weight) {
     add_edge(g, v1, v2, weight);
     add_edge(g, v2, v1, weight);
 }
@@ -177,12 +559,12 @@ void print_graph(Graph *g) {
     printf("\n");
     printf("┌─────────────────────────────────────────┐\n");
     printf("│           GRAPH STRUCTURE               │\n");
-    printf("│  Vertices: %-4d    Edges: %-4d          │\n", 
+    printf("│  Vertices: %-4" PRIdVERTEX "    Edges: %-4" PRIdEDGE "          │\n",
            g->num_vertices, g->num_edges);
     printf("├─────────────────────────────────────────┤\n");
     
-    for (int v = 0; v < g->num_vertices; v++) {
-        printf("│ %2d: ", v);
+    for (vertex_t v = 0; v < g->num_vertices; v++) {
+        printf("│ %2" PRIdVERTEX ": ", v);
         
         Edge *e = g->adj_list[v];
         if (e == NULL) {
@@ -192,7 +574,7 @@ void print_graph(Graph *g) {
         int edge_count = 0;
         while (e != NULL) {
             if (edge_count > 0) printf(", ");
-            printf("→%d(w=%d)", e->destination, e->weight);
+            printf("→%" PRIdVERTEX "(w=%d)", e->destination, e->weight);
             e = e->next;
             edge_count++;
         }
@@ -208,7 +590,7 @@ void print_graph(Graph *g) {
  * @g: Pointer to the graph to free
  * 
  * Memory Deallocation Order (LIFO - Last In First Out):
- * 1. Free all Edge nodes in each adjacency list
+ * 1. Free the edge arena blocks (every Edge node at once)
  * 2. Free the adj_list array
  * 3. Free the Graph structure
  * 
@@ -217,24 +599,24 @@ void print_graph(Graph *g) {
  * - Use-after-free bugs (accessing freed memory)
  * - Double-free errors (freeing same memory twice)
  * 
- * Time Complexity: O(V + E) - must visit all edges
+ * Time Complexity: O(log E + E / EDGE_BLOCK_MAX) - one free() per arena
+ * block; the edge lists are never walked
  */
 void free_graph(Graph *g) {
     if (g == NULL) return;
     
-    /* First, free all edge nodes */
-    for (int v = 0; v < g->num_vertices; v++) {
-        Edge *current = g->adj_list[v];
-        
-        while (current != NULL) {
-            Edge *temp = current;      /* Save pointer to current */
-            current = current->next;    /* Move to next BEFORE freeing */
-            free(temp);                 /* Now safe to free */
-        }
+    /* First, free the edge nodes block by block */
+    EdgeBlock *block = g->edge_blocks;
+    while (block != NULL) {
+        EdgeBlock *older = block->next;    /* Save link BEFORE freeing */
+        free(block);
+        block = older;
     }
     
     /* Then free the array of list heads */
     free(g->adj_list);
+    free(g->coords);
+    free(g->matrix);
     
     /* Finally free the graph structure itself */
     free(g);
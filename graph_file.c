@@ -0,0 +1,673 @@
+/*
+ * graph_file.c - Memory-Mapped Binary Graph Files
+ *
+ * Building a big graph with add_edge() costs one malloc per edge, and
+ * parsing a text file is no better. Instead we store a frozen CSRGraph
+ * on disk in exactly the layout the engines use, and map it back with
+ * mmap(). Loading is then one read-only pass that checks the offsets and
+ * destinations: no parsing, no copying, no per-edge allocation. A second
+ * process mapping the same file shares the page cache. For files known
+ * to be intact, map_csr_graph_trusted() skips the pass and loads in O(1);
+ * pages are then faulted in as the search touches them.
+ *
+ * File Layout (version 1):
+ *
+ *   ┌──────────────────────────────┐ 0
+ *   │ GraphFileHeader (64 bytes)   │
+ *   ├──────────────────────────────┤ offsets_pos       (64-byte aligned)
+ *   │ edge_t   offsets[V + 1]      │
+ *   ├──────────────────────────────┤ destinations_pos  (64-byte aligned)
+ *   │ vertex_t destinations[E]     │
+ *   ├──────────────────────────────┤ weights_pos       (64-byte aligned)
+ *   │ int32    weights[E]          │
+ *   └──────────────────────────────┘
+ *
+ * All integers are stored in native byte order; the endian tag in the
+ * header lets a reader on a different architecture reject the file
+ * instead of misreading it.
+ *
+ * Producers too large to build in memory (generators.c) write the same
+ * layout slice by slice with create_graph_file() and friends.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GRAPH_FILE_MAGIC      "DJKGRAPH"
+#define GRAPH_FILE_VERSION    1
+#define GRAPH_FILE_ENDIAN_TAG 0x01020304u
+#define GRAPH_FILE_ALIGNMENT  64
+
+/*
+ * GraphFileHeader - First 64 bytes of every graph file
+ *
+ * Members:
+ *   magic:            "DJKGRAPH" (not NUL-terminated)
+ *   version:          Format version, bumped on incompatible changes
+ *   endian_tag:       GRAPH_FILE_ENDIAN_TAG as written by the producer
+ *   vertex_bytes:     sizeof(vertex_t) of the producer (4 or 8)
+ *   flags:            Reserved, must be 0 in version 1
+ *   num_vertices:     |V|
+ *   num_edges:        |E|
+ *   *_pos:            Byte offset of each section from start of file
+ */
+typedef struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t vertex_bytes;
+    uint32_t flags;
+    uint64_t num_vertices;
+    uint64_t num_edges;
+    uint64_t offsets_pos;
+    uint64_t destinations_pos;
+    uint64_t weights_pos;
+} GraphFileHeader;
+
+/*
+ * align_up - Rounds a file position up to the section alignment
+ */
+static uint64_t align_up(uint64_t pos) {
+    return (pos + GRAPH_FILE_ALIGNMENT - 1) & ~(uint64_t)(GRAPH_FILE_ALIGNMENT - 1);
+}
+
+/*
+ * write_section - Pads the file to @pos and writes @bytes of @data
+ *
+ * Return: true on success
+ */
+static bool write_section(FILE *fp, uint64_t *written, uint64_t pos,
+                          const void *data, size_t bytes) {
+    static const char zeros[GRAPH_FILE_ALIGNMENT] = {0};
+
+    if (fwrite(zeros, 1, (size_t)(pos - *written), fp) != (size_t)(pos - *written)) {
+        return false;
+    }
+    if (bytes > 0 && fwrite(data, 1, bytes, fp) != bytes) {
+        return false;
+    }
+    *written = pos + bytes;
+    return true;
+}
+
+/*
+ * init_graph_header - Fills in the header of a graph with n vertices and
+ *                     m edges, including the section positions
+ */
+static void init_graph_header(GraphFileHeader *h, vertex_t n, edge_t m) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, GRAPH_FILE_MAGIC, sizeof(h->magic));
+    h->version = GRAPH_FILE_VERSION;
+    h->endian_tag = GRAPH_FILE_ENDIAN_TAG;
+    h->vertex_bytes = (uint32_t)sizeof(vertex_t);
+    h->num_vertices = (uint64_t)n;
+    h->num_edges = (uint64_t)m;
+    h->offsets_pos = align_up(sizeof(*h));
+    h->destinations_pos = align_up(h->offsets_pos + ((uint64_t)n + 1) * sizeof(edge_t));
+    h->weights_pos = align_up(h->destinations_pos + (uint64_t)m * sizeof(vertex_t));
+}
+
+/*
+ * save_csr_graph - Writes a CSR graph to a binary graph file
+ *
+ * @g:    Pointer to the CSR graph
+ * @path: Output file path (overwritten if it exists)
+ *
+ * Time Complexity: O(V + E) - one sequential write per section
+ *
+ * Return: true on success, false on I/O error (message on stderr)
+ */
+bool save_csr_graph(const CSRGraph *g, const char *path) {
+    if (g == NULL || path == NULL) {
+        fprintf(stderr, "Error: Invalid input to save_csr_graph()\n");
+        return false;
+    }
+
+    size_t offsets_bytes = ((size_t)g->num_vertices + 1) * sizeof(edge_t);
+    size_t destinations_bytes = (size_t)g->num_edges * sizeof(vertex_t);
+    size_t weights_bytes = (size_t)g->num_edges * sizeof(int32_t);
+
+    GraphFileHeader header;
+    init_graph_header(&header, g->num_vertices, g->num_edges);
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: Cannot open '%s' for writing\n", path);
+        return false;
+    }
+
+    uint64_t written = 0;
+    bool ok = write_section(fp, &written, 0, &header, sizeof(header)) &&
+              write_section(fp, &written, header.offsets_pos,
+                            g->offsets, offsets_bytes) &&
+              write_section(fp, &written, header.destinations_pos,
+                            g->destinations, destinations_bytes) &&
+              write_section(fp, &written, header.weights_pos,
+                            g->weights, weights_bytes);
+
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed writing graph file '%s'\n", path);
+    }
+    return ok;
+}
+
+/*
+ * check_header - Validates a mapped header against the file size
+ *
+ * Only O(1) checks are done here (check_sections() reads the arrays);
+ * the section bounds are verified so a truncated file cannot be read
+ * past its end.
+ *
+ * Return: true if the file can be used by this build
+ */
+static bool check_header(const GraphFileHeader *h, uint64_t file_size, const char *path) {
+    if (memcmp(h->magic, GRAPH_FILE_MAGIC, sizeof(h->magic)) != 0) {
+        fprintf(stderr, "Error: '%s' is not a graph file\n", path);
+        return false;
+    }
+    if (h->version != GRAPH_FILE_VERSION) {
+        fprintf(stderr, "Error: '%s' has unsupported version %" PRIu32 "\n",
+                path, h->version);
+        return false;
+    }
+    if (h->endian_tag != GRAPH_FILE_ENDIAN_TAG) {
+        fprintf(stderr, "Error: '%s' was written on a machine with different byte order\n",
+                path);
+        return false;
+    }
+    if (h->vertex_bytes != sizeof(vertex_t)) {
+        fprintf(stderr, "Error: '%s' uses %" PRIu32 "-byte vertex ids, this build uses %u\n",
+                path, h->vertex_bytes, (unsigned)sizeof(vertex_t));
+        return false;
+    }
+
+    if (h->num_vertices >= file_size || h->num_edges >= file_size) {
+        fprintf(stderr, "Error: '%s' is truncated or corrupt\n", path);
+        return false;
+    }
+
+    uint64_t offsets_end = h->offsets_pos + (h->num_vertices + 1) * sizeof(edge_t);
+    uint64_t destinations_end = h->destinations_pos + h->num_edges * sizeof(vertex_t);
+    uint64_t weights_end = h->weights_pos + h->num_edges * sizeof(int32_t);
+
+    if (h->offsets_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        h->destinations_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        h->weights_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        offsets_end > file_size || destinations_end > file_size ||
+        weights_end > file_size) {
+        fprintf(stderr, "Error: '%s' is truncated or corrupt\n", path);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * check_sections - Validates the offsets and destinations of a mapped graph
+ *
+ * The header check only bounds the sections. The engines also walk
+ * offsets[u] .. offsets[u+1] and index distance[] with every destination,
+ * so a single corrupt entry would make them read out of bounds.
+ *
+ * Time Complexity: O(V + E) - reads both sections once
+ *
+ * Return: true if the offsets rise from 0 to E and every destination is
+ *         a vertex
+ */
+static bool check_sections(const CSRGraph *g, const char *path) {
+    vertex_t n = g->num_vertices;
+    for (vertex_t u = 0; u < n; u++) {
+        if (g->offsets[u + 1] < g->offsets[u]) {
+            fprintf(stderr, "Error: '%s' has decreasing edge offsets at vertex %" PRIdVERTEX "\n",
+                    path, u);
+            return false;
+        }
+    }
+    for (edge_t i = 0; i < g->num_edges; i++) {
+        if (g->destinations[i] < 0 || g->destinations[i] >= n) {
+            fprintf(stderr, "Error: '%s' has destination %" PRIdVERTEX " out of range at edge %"
+                    PRIdEDGE "\n", path, g->destinations[i], i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * map_graph_file - Maps a graph file, optionally validating the sections
+ */
+static CSRGraph *map_graph_file(const char *path, bool validate) {
+    if (path == NULL) {
+        fprintf(stderr, "Error: NULL path in map_csr_graph()\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open '%s'\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(GraphFileHeader)) {
+        fprintf(stderr, "Error: '%s' is too small to be a graph file\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* The mapping keeps the file alive */
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: mmap() failed for '%s'\n", path);
+        return NULL;
+    }
+
+    const GraphFileHeader *h = (const GraphFileHeader *)base;
+    CSRGraph *g = NULL;
+    if (check_header(h, size, path)) {
+        g = (CSRGraph *)malloc(sizeof(CSRGraph));
+    }
+    if (g == NULL) {
+        munmap(base, size);
+        return NULL;
+    }
+
+    char *bytes = (char *)base;
+    g->num_vertices = (vertex_t)h->num_vertices;
+    g->num_edges = (edge_t)h->num_edges;
+    g->offsets = (edge_t *)(void *)(bytes + h->offsets_pos);
+    g->destinations = (vertex_t *)(void *)(bytes + h->destinations_pos);
+    g->weights = (int *)(void *)(bytes + h->weights_pos);
+    g->mapping = base;
+    g->mapping_size = size;
+    g->reverse_offsets = NULL;
+    g->reverse_sources = NULL;
+    g->reverse_weights = NULL;
+    g->coords = NULL;
+
+    if (g->offsets[0] != 0 || g->offsets[g->num_vertices] != g->num_edges) {
+        fprintf(stderr, "Error: '%s' has inconsistent edge offsets\n", path);
+        free_csr_graph(g);
+        return NULL;
+    }
+    if (validate && !check_sections(g, path)) {
+        free_csr_graph(g);
+        return NULL;
+    }
+    return g;
+}
+
+/*
+ * map_csr_graph - Maps a binary graph file as a read-only CSR graph
+ *
+ * @path: Path of a file written by save_csr_graph()
+ *
+ * The returned graph's arrays point directly into the mapping, so any
+ * engine taking a const CSRGraph * runs on the file contents as-is.
+ * Offsets and destinations are validated first, so a corrupt file is
+ * rejected instead of crashing the engines.
+ *
+ * Time Complexity: O(V + E) - one sequential read of both sections
+ *
+ * Return: Pointer to CSR graph, or NULL on failure
+ *         Caller must call free_csr_graph() (which unmaps the file)!
+ */
+CSRGraph *map_csr_graph(const char *path) {
+    return map_graph_file(path, true);
+}
+
+/*
+ * map_csr_graph_trusted - map_csr_graph() without validating the sections
+ *
+ * @path: Path of an intact file written by save_csr_graph()
+ *
+ * Only the header and the first and last offsets are checked. Use it for
+ * files this program wrote itself; a corrupt file can crash the engines.
+ *
+ * Time Complexity: O(1) - independent of graph size
+ *
+ * Return: Same as map_csr_graph()
+ */
+CSRGraph *map_csr_graph_trusted(const char *path) {
+    return map_graph_file(path, false);
+}
+
+/*====================================================================
+ * STREAMING WRITER
+ *
+ * save_csr_graph() needs the whole graph in memory. A generator that
+ * produces 10^8 edges can instead write them slice by slice: the
+ * offsets fix every section position up front, so each slice of
+ * destinations / weights is written straight to its place with pwrite().
+ *====================================================================*/
+
+/*
+ * GraphFileWriter - File being written by create_graph_file()
+ *
+ * Members:
+ *   fd:     Open output file
+ *   header: Header as written (section positions)
+ *   path:   Output path, for messages
+ *   ok:     false after the first failed write
+ */
+struct GraphFileWriter {
+    int fd;
+    GraphFileHeader header;
+    const char *path;
+    bool ok;
+};
+
+/*
+ * write_at - pwrite() of @bytes at @pos, resuming after short writes
+ *
+ * Return: true on success
+ */
+static bool write_at(int fd, const void *data, size_t bytes, uint64_t pos) {
+    const char *p = (const char *)data;
+    while (bytes > 0) {
+        ssize_t n = pwrite(fd, p, bytes, (off_t)pos);
+        if (n <= 0) return false;
+        p += n;
+        bytes -= (size_t)n;
+        pos += (uint64_t)n;
+    }
+    return true;
+}
+
+/*
+ * create_graph_file - Starts a binary graph file of known shape
+ *
+ * @path:         Output file path (overwritten if it exists); must stay
+ *                valid until close_graph_file()
+ * @num_vertices: |V|
+ * @num_edges:    |E|
+ * @offsets:      The final CSR offsets, num_vertices + 1 entries
+ *
+ * Writes the header and offsets and sizes the file; the edge sections
+ * are then filled by write_graph_file_edges().
+ *
+ * Time Complexity: O(V)
+ *
+ * Return: Writer, or NULL on failure. Finish with close_graph_file()
+ */
+GraphFileWriter *create_graph_file(const char *path, vertex_t num_vertices, edge_t num_edges,
+                                   const edge_t *offsets) {
+    if (path == NULL || num_vertices < 0 || num_edges < 0 || offsets == NULL ||
+        offsets[0] != 0 || offsets[num_vertices] != num_edges) {
+        fprintf(stderr, "Error: Invalid input to create_graph_file()\n");
+        return NULL;
+    }
+
+    GraphFileWriter *w = (GraphFileWriter *)malloc(sizeof(GraphFileWriter));
+    if (w == NULL) return NULL;
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (w->fd < 0) {
+        fprintf(stderr, "Error: Cannot open '%s' for writing\n", path);
+        free(w);
+        return NULL;
+    }
+    w->path = path;
+    init_graph_header(&w->header, num_vertices, num_edges);
+
+    uint64_t end = w->header.weights_pos + (uint64_t)num_edges * sizeof(int32_t);
+    w->ok = ftruncate(w->fd, (off_t)end) == 0 &&
+            write_at(w->fd, &w->header, sizeof(w->header), 0) &&
+            write_at(w->fd, offsets, ((size_t)num_vertices + 1) * sizeof(edge_t),
+                     w->header.offsets_pos);
+    if (!w->ok) {
+        fprintf(stderr, "Error: Failed writing graph file '%s'\n", path);
+        close(w->fd);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+/*
+ * write_graph_file_edges - Writes one slice of the edge sections
+ *
+ * @w:            Writer from create_graph_file()
+ * @first:        CSR index of the first edge of the slice
+ * @destinations: count destinations, in CSR order
+ * @weights:      count weights, in CSR order
+ * @count:        Number of edges in the slice
+ *
+ * Slices may come in any order; together they must cover every edge.
+ *
+ * Time Complexity: O(count)
+ *
+ * Return: true on success
+ */
+bool write_graph_file_edges(GraphFileWriter *w, edge_t first, const vertex_t *destinations,
+                            const int *weights, edge_t count) {
+    if (w == NULL || first < 0 || count < 0 ||
+        (uint64_t)(first + count) > w->header.num_edges ||
+        (count > 0 && (destinations == NULL || weights == NULL))) {
+        fprintf(stderr, "Error: Invalid input to write_graph_file_edges()\n");
+        return false;
+    }
+    if (!w->ok) return false;
+
+    w->ok = write_at(w->fd, destinations, (size_t)count * sizeof(vertex_t),
+                     w->header.destinations_pos + (uint64_t)first * sizeof(vertex_t)) &&
+            write_at(w->fd, weights, (size_t)count * sizeof(int32_t),
+                     w->header.weights_pos + (uint64_t)first * sizeof(int32_t));
+    if (!w->ok) {
+        fprintf(stderr, "Error: Failed writing graph file '%s'\n", w->path);
+    }
+    return w->ok;
+}
+
+/*
+ * close_graph_file - Closes the file and frees the writer
+ *
+ * Return: true if every write succeeded
+ */
+bool close_graph_file(GraphFileWriter *w) {
+    if (w == NULL) return false;
+    bool ok = w->ok;
+    if (close(w->fd) != 0) ok = false;
+    free(w);
+    return ok;
+}
+
+/*====================================================================
+ * LANDMARK FILES
+ *
+ * ALT tables (landmarks.c) take k full SSSP runs to build but never
+ * change for a given graph, so they are stored next to it in the same
+ * style: a header, then 64-byte aligned sections mapped back as-is.
+ *
+ *   LandmarkFileHeader | vertex_t landmarks[k] | int32 to[V * k] | int32 from[V * k]
+ *====================================================================*/
+
+#define LANDMARK_FILE_MAGIC   "DJKLMARK"
+#define LANDMARK_FILE_VERSION 1
+
+/*
+ * LandmarkFileHeader - First bytes of every landmark file
+ *
+ * Members:
+ *   magic, version, endian_tag, vertex_bytes: As in GraphFileHeader
+ *   num_landmarks:    k
+ *   num_vertices:     |V| of the graph the table was built for
+ *   num_edges:        |E| of that graph (a cheap mismatch check)
+ *   *_pos:            Byte offset of each section from start of file
+ */
+typedef struct LandmarkFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t vertex_bytes;
+    uint32_t num_landmarks;
+    uint64_t num_vertices;
+    uint64_t num_edges;
+    uint64_t landmarks_pos;
+    uint64_t to_pos;
+    uint64_t from_pos;
+} LandmarkFileHeader;
+
+/*
+ * save_landmarks - Writes a landmark table to a binary file
+ *
+ * @table: Table from build_landmarks()
+ * @path:  Output file path (overwritten if it exists)
+ *
+ * Time Complexity: O(k V)
+ *
+ * Return: true on success, false on I/O error (message on stderr)
+ */
+bool save_landmarks(const LandmarkTable *table, const char *path) {
+    if (table == NULL || path == NULL) {
+        fprintf(stderr, "Error: Invalid input to save_landmarks()\n");
+        return false;
+    }
+
+    size_t cells = (size_t)table->num_vertices * (size_t)table->num_landmarks;
+    size_t landmarks_bytes = (size_t)table->num_landmarks * sizeof(vertex_t);
+    size_t table_bytes = cells * sizeof(int32_t);
+
+    LandmarkFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LANDMARK_FILE_MAGIC, sizeof(header.magic));
+    header.version = LANDMARK_FILE_VERSION;
+    header.endian_tag = GRAPH_FILE_ENDIAN_TAG;
+    header.vertex_bytes = (uint32_t)sizeof(vertex_t);
+    header.num_landmarks = (uint32_t)table->num_landmarks;
+    header.num_vertices = (uint64_t)table->num_vertices;
+    header.num_edges = (uint64_t)table->num_edges;
+    header.landmarks_pos = align_up(sizeof(header));
+    header.to_pos = align_up(header.landmarks_pos + landmarks_bytes);
+    header.from_pos = align_up(header.to_pos + table_bytes);
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: Cannot open '%s' for writing\n", path);
+        return false;
+    }
+
+    uint64_t written = 0;
+    bool ok = write_section(fp, &written, 0, &header, sizeof(header)) &&
+              write_section(fp, &written, header.landmarks_pos,
+                            table->landmarks, landmarks_bytes) &&
+              write_section(fp, &written, header.to_pos, table->to, table_bytes) &&
+              write_section(fp, &written, header.from_pos, table->from, table_bytes);
+
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed writing landmark file '%s'\n", path);
+    }
+    return ok;
+}
+
+/*
+ * check_landmark_header - Validates a mapped landmark header
+ *
+ * Return: true if the file can be used by this build
+ */
+static bool check_landmark_header(const LandmarkFileHeader *h, uint64_t file_size,
+                                  const char *path) {
+    if (memcmp(h->magic, LANDMARK_FILE_MAGIC, sizeof(h->magic)) != 0) {
+        fprintf(stderr, "Error: '%s' is not a landmark file\n", path);
+        return false;
+    }
+    if (h->version != LANDMARK_FILE_VERSION) {
+        fprintf(stderr, "Error: '%s' has unsupported version %" PRIu32 "\n",
+                path, h->version);
+        return false;
+    }
+    if (h->endian_tag != GRAPH_FILE_ENDIAN_TAG || h->vertex_bytes != sizeof(vertex_t)) {
+        fprintf(stderr, "Error: '%s' was written by an incompatible build\n", path);
+        return false;
+    }
+    if (h->num_landmarks == 0 || h->num_landmarks > MAX_LANDMARKS ||
+        h->num_vertices >= file_size || h->num_edges > INT64_MAX) {
+        fprintf(stderr, "Error: '%s' is truncated or corrupt\n", path);
+        return false;
+    }
+
+    uint64_t table_bytes = h->num_vertices * h->num_landmarks * sizeof(int32_t);
+    uint64_t landmarks_end = h->landmarks_pos + h->num_landmarks * sizeof(vertex_t);
+
+    if (h->landmarks_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        h->to_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        h->from_pos % GRAPH_FILE_ALIGNMENT != 0 ||
+        landmarks_end > file_size || h->to_pos + table_bytes > file_size ||
+        h->from_pos + table_bytes > file_size) {
+        fprintf(stderr, "Error: '%s' is truncated or corrupt\n", path);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * load_landmarks - Maps a landmark file written by save_landmarks()
+ *
+ * @path: Landmark file
+ * @g:    Graph the table will be used with (checked against the file)
+ *
+ * Time Complexity: O(k) - the tables are paged in on demand
+ *
+ * Return: Landmark table, or NULL on failure
+ *         Caller must call free_landmarks() (which unmaps the file)!
+ */
+LandmarkTable *load_landmarks(const char *path, const CSRGraph *g) {
+    if (path == NULL || g == NULL) {
+        fprintf(stderr, "Error: Invalid input to load_landmarks()\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open '%s'\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < sizeof(LandmarkFileHeader)) {
+        fprintf(stderr, "Error: '%s' is too small to be a landmark file\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: mmap() failed for '%s'\n", path);
+        return NULL;
+    }
+
+    const LandmarkFileHeader *h = (const LandmarkFileHeader *)base;
+    LandmarkTable *table = NULL;
+    if (check_landmark_header(h, size, path)) {
+        if (h->num_vertices != (uint64_t)g->num_vertices ||
+            h->num_edges != (uint64_t)g->num_edges) {
+            fprintf(stderr, "Error: '%s' was built for a different graph\n", path);
+        } else {
+            table = (LandmarkTable *)malloc(sizeof(LandmarkTable));
+        }
+    }
+    if (table == NULL) {
+        munmap(base, size);
+        return NULL;
+    }
+
+    char *bytes = (char *)base;
+    table->num_landmarks = (int)h->num_landmarks;
+    table->num_vertices = (vertex_t)h->num_vertices;
+    table->num_edges = (edge_t)h->num_edges;
+    table->landmarks = (vertex_t *)(void *)(bytes + h->landmarks_pos);
+    table->to = (int *)(void *)(bytes + h->to_pos);
+    table->from = (int *)(void *)(bytes + h->from_pos);
+    table->mapping = base;
+    table->mapping_size = size;
+    return table;
+}
@@ -0,0 +1,536 @@
+/*
+ * graph_parser.c - Parallel Streaming Loader for Text Graph Files
+ *
+ * Supported formats:
+ *
+ *   DIMACS .gr (9th DIMACS Implementation Challenge, shortest paths):
+ *     c <comment>
+ *     p sp <vertices> <arcs>        (before the first arc)
+ *     a <from> <to> <weight>        (vertex ids are 1-based, at most <vertices>)
+ *
+ *   Edge list:
+ *     # or % <comment>
+ *     <from> <to> [weight]          (0-based, weight defaults to 1)
+ *
+ * Numbers are decimal integers. A line with anything else (a fraction,
+ * a stray word, an extra field) is skipped and counted as malformed, so
+ * bad input never turns silently into a different graph. Lines may end
+ * in "\r\n", and the last one needs no newline.
+ *
+ * Pipeline:
+ *
+ *   file ──fread──> chunk A ──split at '\n'──> T slices ──> T parser threads
+ *                   chunk B <──fread (overlapped with parsing of A)
+ *
+ * The file is read in large chunks. Each chunk is cut into one slice per
+ * thread at line boundaries, and every thread appends the edges it finds
+ * to its own EdgeList, so parsers never share or lock anything. While the
+ * threads parse one chunk, the main thread reads the next one; a partial
+ * last line is carried over to the start of the next chunk.
+ *
+ * After the last chunk, the per-thread buffers go straight into
+ * build_csr_graph() - a counting sort, no add_edge() and no per-edge malloc.
+ *
+ * Vertex coordinates (for A*) come from a separate DIMACS .co file, read
+ * sequentially by load_coordinates():
+ *     c <comment>
+ *     p aux sp co <vertices>
+ *     v <id> <x> <y>                (1-based, integers or decimals)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dijkstra.h"
+#include "threads.h"
+#include <string.h>
+
+#define PARSE_CHUNK_SIZE ((size_t)64 << 20)  /* 64 MiB per read */
+
+/*
+ * ParseTask - Per-thread parser state, kept across all chunks
+ *
+ * Members:
+ *   begin, end:        Slice of the current chunk to parse
+ *   format:            DIMACS or edge list
+ *   edges:             This thread's private edge buffer
+ *   max_vertex:        Largest vertex id seen (0-based)
+ *   declared_vertices: Vertex count from the DIMACS "p" line, -1 if the
+ *                      file has none (set before parsing starts)
+ *   problem_lines:     DIMACS "p" lines seen (only one is valid)
+ *   bad_lines:         Lines that could not be parsed (skipped)
+ *   negative_weights:  Edges with weight < 0 (Dijkstra needs >= 0)
+ *   out_of_memory:     Set if the edge buffer could not grow
+ */
+typedef struct ParseTask {
+    const char *begin;
+    const char *end;
+    GraphFormat format;
+    EdgeList edges;
+    vertex_t max_vertex;
+    vertex_t declared_vertices;
+    edge_t problem_lines;
+    edge_t bad_lines;
+    edge_t negative_weights;
+    bool out_of_memory;
+} ParseTask;
+
+/*
+ * skip_blanks - Advances past spaces and tabs (not newlines)
+ */
+static const char *skip_blanks(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+/*
+ * at_line_end - Tells whether only blanks and a '\r' are left in [p, end)
+ */
+static bool at_line_end(const char *p, const char *end) {
+    p = skip_blanks(p, end);
+    return p == end || (*p == '\r' && p + 1 == end);
+}
+
+/*
+ * parse_integer - Parses an optionally signed decimal integer
+ *
+ * Hand-rolled instead of strtol(): no locale, no errno, and it stops at
+ * the slice end instead of needing a NUL terminator.
+ *
+ * Return: Pointer past the number, or NULL if no digits were found or
+ *         the digits run into anything but a blank, '\r' or the end
+ *         ("2.9", "5x")
+ */
+static const char *parse_integer(const char *p, const char *end, int64_t *out) {
+    p = skip_blanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    const char *digits = p;
+    int64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (value > (INT64_MAX - 9) / 10) return NULL;  /* Would overflow */
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    if (p == digits) return NULL;
+    if (p < end && *p != ' ' && *p != '\t' && *p != '\r') return NULL;
+
+    *out = negative ? -value : value;
+    return p;
+}
+
+/*
+ * record_edge - Validates one parsed edge and appends it to the buffer
+ */
+static void record_edge(ParseTask *task, int64_t u, int64_t v, int64_t w) {
+    vertex_t declared = task->declared_vertices;
+    if (u < 0 || v < 0 || (vertex_t)u != u || (vertex_t)v != v ||
+        (declared >= 0 && (u >= declared || v >= declared)) ||
+        w > INT_MAX || w < INT_MIN) {
+        task->bad_lines++;
+        return;
+    }
+    if (w < 0) task->negative_weights++;
+
+    if (!edge_list_append(&task->edges, (vertex_t)u, (vertex_t)v, (int)w)) {
+        task->out_of_memory = true;
+        return;
+    }
+    if (u > task->max_vertex) task->max_vertex = (vertex_t)u;
+    if (v > task->max_vertex) task->max_vertex = (vertex_t)v;
+}
+
+/*
+ * parse_problem_line - Parses the rest of a DIMACS "p sp <n> <m>" line
+ *
+ * @p:   Just past the 'p'
+ *
+ * Return: n, or -1 if the line is malformed
+ */
+static vertex_t parse_problem_line(const char *p, const char *end) {
+    p = skip_blanks(p, end);
+    while (p < end && *p != ' ' && *p != '\t') p++;  /* Problem type */
+    int64_t n, m;
+    if ((p = parse_integer(p, end, &n)) == NULL ||
+        (p = parse_integer(p, end, &m)) == NULL || !at_line_end(p, end) ||
+        n < 0 || (vertex_t)n != n) {
+        return -1;
+    }
+    return (vertex_t)n;
+}
+
+/*
+ * parse_line - Parses one line [p, end) (newline excluded)
+ */
+static void parse_line(ParseTask *task, const char *p, const char *end) {
+    p = skip_blanks(p, end);
+    if (at_line_end(p, end)) return;  /* Blank line */
+
+    int64_t u, v, w;
+
+    if (task->format == GRAPH_FORMAT_DIMACS) {
+        char kind = *p++;
+        if (kind == 'c') return;
+
+        if (kind == 'p') {
+            /* Read by find_problem_line() before parsing; only counted here */
+            task->problem_lines++;
+            return;
+        }
+
+        if (kind == 'a' &&
+            (p = parse_integer(p, end, &u)) != NULL &&
+            (p = parse_integer(p, end, &v)) != NULL &&
+            (p = parse_integer(p, end, &w)) != NULL && at_line_end(p, end)) {
+            record_edge(task, u - 1, v - 1, w);  /* DIMACS ids are 1-based */
+            return;
+        }
+
+        task->bad_lines++;
+        return;
+    }
+
+    /* Edge list */
+    if (*p == '#' || *p == '%') return;
+
+    if ((p = parse_integer(p, end, &u)) == NULL ||
+        (p = parse_integer(p, end, &v)) == NULL) {
+        task->bad_lines++;
+        return;
+    }
+    if (at_line_end(p, end)) {
+        w = 1;
+    } else if ((p = parse_integer(p, end, &w)) == NULL || !at_line_end(p, end)) {
+        task->bad_lines++;
+        return;
+    }
+    record_edge(task, u, v, w);
+}
+
+/*
+ * find_problem_line - Reads the DIMACS "p" line ahead of the parsers
+ *
+ * @chunk:  First chunk of the file
+ * @length: Bytes in it
+ *
+ * The "p" line comes before the first arc, after any comments. The
+ * parser threads need its vertex count to reject arcs outside it, so it
+ * is read here, sequentially, before they start.
+ *
+ * Return: Declared vertex count, -1 if the file has no valid "p" line
+ *         before its first other line
+ */
+static vertex_t find_problem_line(const char *chunk, size_t length) {
+    const char *end = chunk + length;
+    for (const char *p = chunk; p < end; ) {
+        const char *eol = (const char *)memchr(p, '\n', (size_t)(end - p));
+        if (eol == NULL) eol = end;
+        const char *q = skip_blanks(p, eol);
+        if (q < eol && *q == 'p') return parse_problem_line(q + 1, eol);
+        if (!at_line_end(q, eol) && *q != 'c') return -1;
+        p = eol + 1;
+    }
+    return -1;
+}
+
+/*
+ * parse_slice - Thread entry point: parses every line of the task's slice
+ */
+static void *parse_slice(void *arg) {
+    ParseTask *task = (ParseTask *)arg;
+    const char *p = task->begin;
+
+    while (p < task->end && !task->out_of_memory) {
+        const char *eol = (const char *)memchr(p, '\n', (size_t)(task->end - p));
+        if (eol == NULL) eol = task->end;
+        parse_line(task, p, eol);
+        p = eol + 1;
+    }
+    return NULL;
+}
+
+/*
+ * detect_format - Chooses a parser from the file name and first bytes
+ */
+static GraphFormat detect_format(const char *path, FILE *fp) {
+    char head[8];
+    size_t got = fread(head, 1, sizeof(head), fp);
+    rewind(fp);
+
+    if (got == sizeof(head) && memcmp(head, "DJKGRAPH", sizeof(head)) == 0) {
+        return GRAPH_FORMAT_BINARY;
+    }
+
+    size_t len = strlen(path);
+    if (len >= 3 && strcmp(path + len - 3, ".gr") == 0) {
+        return GRAPH_FORMAT_DIMACS;
+    }
+    if (got > 0 && (head[0] == 'c' || head[0] == 'p')) {
+        return GRAPH_FORMAT_DIMACS;
+    }
+    return GRAPH_FORMAT_EDGE_LIST;
+}
+
+/*
+ * fill_chunk - Reads into buf after the @carry bytes already there
+ *
+ * Return: Total number of valid bytes in buf
+ */
+static size_t fill_chunk(FILE *fp, char *buf, size_t carry) {
+    return carry + fread(buf + carry, 1, PARSE_CHUNK_SIZE - carry, fp);
+}
+
+/*
+ * load_graph - Loads a graph file into a CSR graph
+ *
+ * @path:        File to load
+ * @format:      File format, or GRAPH_FORMAT_AUTO to detect it
+ * @num_threads: Parser threads (see thread_count())
+ *
+ * Binary files are memory-mapped (see map_csr_graph()); text files are
+ * streamed through the parallel parser described at the top of this file.
+ *
+ * For edge lists the vertex count is the largest id + 1; for DIMACS it is
+ * the "p" line's count (the largest id + 1 if there is none). Arcs with
+ * ids beyond that count, a second or late "p" line, and every line the
+ * parser cannot read fully are skipped and reported on stderr.
+ *
+ * Time Complexity: O(file size / threads + V + E)
+ *
+ * Return: Pointer to CSR graph, or NULL on failure (message on stderr)
+ */
+CSRGraph *load_graph(const char *path, GraphFormat format, int num_threads) {
+    if (path == NULL) {
+        fprintf(stderr, "Error: NULL path in load_graph()\n");
+        return NULL;
+    }
+
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: Cannot open '%s'\n", path);
+        return NULL;
+    }
+
+    if (format == GRAPH_FORMAT_AUTO) {
+        format = detect_format(path, fp);
+    }
+    if (format == GRAPH_FORMAT_BINARY) {
+        fclose(fp);
+        return map_csr_graph(path);
+    }
+
+    num_threads = thread_count(num_threads, TASK_MAX_THREADS);
+
+    char *buffers[2];
+    buffers[0] = (char *)malloc(PARSE_CHUNK_SIZE);
+    buffers[1] = (char *)malloc(PARSE_CHUNK_SIZE);
+    ParseTask *tasks = (ParseTask *)calloc((size_t)num_threads, sizeof(ParseTask));
+
+    if (buffers[0] == NULL || buffers[1] == NULL || tasks == NULL) {
+        fprintf(stderr, "Error: Failed to allocate parser buffers\n");
+        free(buffers[0]);
+        free(buffers[1]);
+        free(tasks);
+        fclose(fp);
+        return NULL;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        tasks[t].format = format;
+        edge_list_init(&tasks[t].edges);
+        tasks[t].max_vertex = -1;
+        tasks[t].declared_vertices = -1;
+    }
+
+    bool ok = true;
+    int current = 0;
+    size_t length = fill_chunk(fp, buffers[current], 0);
+
+    vertex_t declared = -1;
+    if (format == GRAPH_FORMAT_DIMACS) {
+        declared = find_problem_line(buffers[current], length);
+        for (int t = 0; t < num_threads; t++) tasks[t].declared_vertices = declared;
+    }
+
+    while (ok && length > 0) {
+        char *chunk = buffers[current];
+        bool at_eof = feof(fp) || length < PARSE_CHUNK_SIZE;
+
+        /* Only whole lines are parsed; the tail waits for the next chunk */
+        size_t complete = length;
+        if (!at_eof) {
+            while (complete > 0 && chunk[complete - 1] != '\n') complete--;
+            if (complete == 0) {
+                fprintf(stderr, "Error: Line longer than %zu bytes in '%s'\n",
+                        PARSE_CHUNK_SIZE, path);
+                ok = false;
+                break;
+            }
+        }
+
+        /* Cut [0, complete) into one slice per thread at line boundaries */
+        int launched = 0;
+        size_t start = 0;
+        for (int t = 0; t < num_threads && start < complete; t++) {
+            size_t stop = complete;
+            if (t < num_threads - 1) {
+                stop = start + (complete - start) / (size_t)(num_threads - t);
+                if (stop <= start) stop = start + 1;   /* fewer bytes than threads */
+                while (stop < complete && chunk[stop - 1] != '\n') stop++;
+            }
+            tasks[t].begin = chunk + start;
+            tasks[t].end = chunk + stop;
+            launched++;
+            start = stop;
+        }
+        TaskThreads team;
+        start_tasks(&team, parse_slice, tasks, sizeof(ParseTask), launched);
+
+        /* Overlap: read the next chunk while the current one is parsed */
+        size_t carry = length - complete;
+        int next = 1 - current;
+        memcpy(buffers[next], chunk + complete, carry);
+        length = at_eof ? 0 : fill_chunk(fp, buffers[next], carry);
+
+        join_tasks(&team);
+        for (int t = 0; t < launched; t++) {
+            if (tasks[t].out_of_memory) ok = false;
+        }
+        current = next;
+    }
+
+    if (ferror(fp)) {
+        fprintf(stderr, "Error: Read error on '%s'\n", path);
+        ok = false;
+    }
+    fclose(fp);
+    free(buffers[0]);
+    free(buffers[1]);
+
+    /* Merge per-thread statistics */
+    vertex_t num_vertices = (declared >= 0) ? declared : 0;
+    edge_t bad_lines = 0;
+    edge_t negative_weights = 0;
+    for (int t = 0; t < num_threads; t++) {
+        if (tasks[t].max_vertex + 1 > num_vertices) num_vertices = tasks[t].max_vertex + 1;
+        bad_lines += tasks[t].bad_lines + tasks[t].problem_lines;
+        negative_weights += tasks[t].negative_weights;
+    }
+    if (declared >= 0) bad_lines--;   /* The one valid "p" line */
+
+    if (bad_lines > 0) {
+        fprintf(stderr, "WARNING: Skipped %" PRIdEDGE " malformed line(s) in '%s'\n",
+                bad_lines, path);
+    }
+    if (negative_weights > 0) {
+        fprintf(stderr, "WARNING: %" PRIdEDGE " negative edge weight(s) in '%s'\n",
+                negative_weights, path);
+        fprintf(stderr, "         Dijkstra's algorithm requires non-negative weights!\n");
+    }
+
+    CSRGraph *g = NULL;
+    if (ok) {
+        EdgeList *lists = (EdgeList *)malloc((size_t)num_threads * sizeof(EdgeList));
+        if (lists != NULL) {
+            for (int t = 0; t < num_threads; t++) lists[t] = tasks[t].edges;
+            g = build_csr_graph(num_vertices, lists, num_threads);
+            free(lists);
+        }
+    } else {
+        fprintf(stderr, "Error: Failed to load '%s'\n", path);
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        edge_list_free(&tasks[t].edges);
+    }
+    free(tasks);
+    return g;
+}
+
+/*============================================================================
+ * COORDINATE FILES
+ *===========================================================================*/
+
+/*
+ * load_coordinates - Reads a DIMACS .co file into g->coords
+ *
+ * @g:    Graph the coordinates belong to
+ * @path: Coordinate file ("v <id> <x> <y>" lines, 1-based ids)
+ * @unit: Factor applied to every coordinate, e.g. 1e-6 for the DIMACS
+ *        road graphs, which store longitude / latitude in microdegrees
+ *
+ * Vertices without a "v" line are placed at (0, 0). Existing
+ * coordinates of @g are replaced.
+ *
+ * Time Complexity: O(V + file size)
+ *
+ * Return: true on success
+ */
+bool load_coordinates(CSRGraph *g, const char *path, double unit) {
+    if (g == NULL || path == NULL) {
+        fprintf(stderr, "Error: Invalid input to load_coordinates()\n");
+        return false;
+    }
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: Cannot open '%s'\n", path);
+        return false;
+    }
+
+    VertexCoord *coords = (VertexCoord *)calloc((size_t)g->num_vertices + 1, sizeof(VertexCoord));
+    if (coords == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for coordinates\n");
+        fclose(fp);
+        return false;
+    }
+
+    char *line = NULL;
+    size_t line_capacity = 0;
+    edge_t bad_lines = 0;
+
+    while (getline(&line, &line_capacity, fp) != -1) {
+        const char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == 'c' || *p == 'p' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        char *rest;
+        long long id = (*p == 'v') ? strtoll(p + 1, &rest, 10) : 0;
+        if (*p != 'v' || rest == p + 1 || id < 1 || id > (long long)g->num_vertices) {
+            bad_lines++;
+            continue;
+        }
+
+        char *after_x, *after_y;
+        double x = strtod(rest, &after_x);
+        double y = strtod(after_x, &after_y);
+        if (after_x == rest || after_y == after_x) {
+            bad_lines++;
+            continue;
+        }
+        coords[id - 1].x = x * unit;
+        coords[id - 1].y = y * unit;
+    }
+
+    bool ok = !ferror(fp);
+    free(line);
+    fclose(fp);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Read error on '%s'\n", path);
+        free(coords);
+        return false;
+    }
+    if (bad_lines > 0) {
+        fprintf(stderr, "WARNING: Skipped %" PRIdEDGE " malformed line(s) in '%s'\n",
+                bad_lines, path);
+    }
+
+    free(g->coords);
+    g->coords = coords;
+    return true;
+}
@@ -0,0 +1,63 @@
+/*
+ * heap.h - Indexed d-ary Min-Heap (priority queue for the engines)
+ *
+ * The textbook heap stored an array of pointers to individually
+ * malloc'd nodes, and sifted down recursively. This one is built for
+ * the hot loop:
+ *
+ *   - Value type: entries are {key, vertex} pairs stored inline, so a
+ *     comparison never dereferences a pointer
+ *   - d-ary: each node has DIJKSTRA_HEAP_ARITY children (2, 4 or 8).
+ *     A wider heap is shallower, so DECREASE-KEY (sift-up, the common
+ *     operation in Dijkstra) touches fewer levels, and the d children
+ *     scanned by sift-down sit next to each other in one cache line
+ *   - Cache-line aligned: the array is offset so that every sibling
+ *     group starts on a 64-byte boundary
+ *   - Indexed: position[v] gives v's slot for O(1) DECREASE-KEY, and is
+ *     -1 when v is not in the heap
+ *   - Iterative sift-up/sift-down that move a "hole" instead of swapping
+ *   - Lazy insertion: vertices are pushed when first reached, not all
+ *     V up front, and the heap can be cleared in O(size) for reuse
+ *
+ * Array layout (arity 4):
+ *
+ *   index:   0 | 1  2  3  4 | 5  6  7  8 | 9 ...
+ *            ^   children     children
+ *          root  of 0         of 1
+ *
+ *   Parent of i:      (i - 1) / d
+ *   Children of i:    d*i + 1  ...  d*i + d
+ *
+ * All functions are static inline: the heap operations are the inner
+ * loop of every engine and must be inlined into it.
+ *
+ * Key Types:
+ *   The functions live in heap_impl.h, written against HEAP_KEY and
+ *   HEAP_NAME(). This header instantiates it once with int keys and the
+ *   plain names (DaryHeap, heap_push(), ...). The typed engines include
+ *   heap_impl.h again for their distance type, e.g. DaryHeap_u32 and
+ *   heap_push_u32() with uint64_t keys (see typed_engine.h).
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "dijkstra.h"
+
+#ifndef DIJKSTRA_HEAP_ARITY
+#define DIJKSTRA_HEAP_ARITY 4
+#endif
+
+#if DIJKSTRA_HEAP_ARITY != 2 && DIJKSTRA_HEAP_ARITY != 4 && DIJKSTRA_HEAP_ARITY != 8
+#error "DIJKSTRA_HEAP_ARITY must be 2, 4 or 8"
+#endif
+
+#define HEAP_CACHE_LINE 64
+
+#define HEAP_KEY        int
+#define HEAP_NAME(name) name
+#include "heap_impl.h"
+#undef HEAP_KEY
+#undef HEAP_NAME
+
+#endif /* HEAP_H */
@@ -0,0 +1,200 @@
+/*
+ * heap_impl.h - Body of the indexed d-ary heap (internal, see heap.h)
+ *
+ * Included once per key type, without an include guard. Before each
+ * inclusion define:
+ *
+ *   HEAP_KEY         Key type (int, uint32_t, double, ...)
+ *   HEAP_NAME(name)  Name of each generated type / function, e.g.
+ *                    name or name##_u32
+ *
+ * heap.h must have been included first (arity and cache-line settings).
+ */
+
+#define HEAP_ENTRY HEAP_NAME(HeapEntry)
+#define HEAP_TYPE  HEAP_NAME(DaryHeap)
+
+/*
+ * HeapEntry - One heap slot: priority key and the vertex it belongs to
+ */
+typedef struct HEAP_ENTRY {
+    HEAP_KEY key;
+    vertex_t vertex;
+} HEAP_ENTRY;
+
+/*
+ * DaryHeap - Indexed d-ary min-heap over vertex ids [0, capacity)
+ *
+ * Members:
+ *   entries:  Heap array (cache-line aligned sibling groups)
+ *   position: position[v] = index of v in entries, -1 if not in heap
+ *   size:     Number of entries currently in the heap
+ *   capacity: Number of vertex ids (maximum possible size)
+ *   block:    Raw allocation behind entries (for free)
+ */
+typedef struct HEAP_TYPE {
+    HEAP_ENTRY *entries;
+    vertex_t *position;
+    vertex_t size;
+    vertex_t capacity;
+    void *block;
+} HEAP_TYPE;
+
+/*
+ * heap_init - Allocates an empty heap for vertex ids [0, capacity)
+ *
+ * Time Complexity: O(capacity) - once; reuse the heap via heap_clear()
+ *
+ * Return: true on success
+ */
+static inline bool HEAP_NAME(heap_init)(HEAP_TYPE *h, vertex_t capacity) {
+    /*
+     * Offset the array so that entries[1] (the first sibling group) is
+     * line-aligned; then every group d*i+1 .. d*i+d is aligned too.
+     */
+    size_t pad = HEAP_CACHE_LINE / sizeof(HEAP_ENTRY) - 1;
+    size_t bytes = ((size_t)capacity + pad + 1) * sizeof(HEAP_ENTRY) + HEAP_CACHE_LINE;
+
+    h->block = malloc(bytes);
+    h->position = (vertex_t *)malloc(((size_t)capacity + 1) * sizeof(vertex_t));
+    if (h->block == NULL || h->position == NULL) {
+        free(h->block);
+        free(h->position);
+        h->block = NULL;
+        h->position = NULL;
+        return false;
+    }
+
+    uintptr_t aligned = ((uintptr_t)h->block + HEAP_CACHE_LINE - 1) &
+                        ~(uintptr_t)(HEAP_CACHE_LINE - 1);
+    h->entries = (HEAP_ENTRY *)aligned + pad;
+    h->size = 0;
+    h->capacity = capacity;
+
+    for (vertex_t v = 0; v < capacity; v++) {
+        h->position[v] = -1;
+    }
+    return true;
+}
+
+/*
+ * heap_free - Releases the heap's memory
+ */
+static inline void HEAP_NAME(heap_free)(HEAP_TYPE *h) {
+    free(h->block);
+    free(h->position);
+    h->block = NULL;
+    h->position = NULL;
+    h->entries = NULL;
+    h->size = 0;
+}
+
+/*
+ * heap_clear - Empties the heap for the next query
+ *
+ * Time Complexity: O(size) - only the entries still in the heap
+ */
+static inline void HEAP_NAME(heap_clear)(HEAP_TYPE *h) {
+    for (vertex_t i = 0; i < h->size; i++) {
+        h->position[h->entries[i].vertex] = -1;
+    }
+    h->size = 0;
+}
+
+static inline bool HEAP_NAME(heap_empty)(const HEAP_TYPE *h) {
+    return h->size == 0;
+}
+
+static inline bool HEAP_NAME(heap_contains)(const HEAP_TYPE *h, vertex_t v) {
+    return h->position[v] >= 0;
+}
+
+/*
+ * heap_top_key - Smallest key in the heap (must not be empty)
+ */
+static inline HEAP_KEY HEAP_NAME(heap_top_key)(const HEAP_TYPE *h) {
+    return h->entries[0].key;
+}
+
+/*
+ * heap_sift_up - Moves the hole at @i up until @entry fits, then fills it
+ */
+static inline void HEAP_NAME(heap_sift_up)(HEAP_TYPE *h, vertex_t i, HEAP_ENTRY entry) {
+    while (i > 0) {
+        vertex_t parent = (i - 1) / DIJKSTRA_HEAP_ARITY;
+        if (h->entries[parent].key <= entry.key) break;
+
+        h->entries[i] = h->entries[parent];
+        h->position[h->entries[i].vertex] = i;
+        i = parent;
+    }
+    h->entries[i] = entry;
+    h->position[entry.vertex] = i;
+}
+
+/*
+ * heap_sift_down - Moves the hole at @i down until @entry fits, then fills it
+ */
+static inline void HEAP_NAME(heap_sift_down)(HEAP_TYPE *h, vertex_t i, HEAP_ENTRY entry) {
+    for (;;) {
+        vertex_t first = i * DIJKSTRA_HEAP_ARITY + 1;
+        if (first >= h->size) break;
+
+        /* Smallest of up to d adjacent children (one cache line) */
+        vertex_t last = first + DIJKSTRA_HEAP_ARITY;
+        if (last > h->size) last = h->size;
+        vertex_t best = first;
+        for (vertex_t c = first + 1; c < last; c++) {
+            if (h->entries[c].key < h->entries[best].key) best = c;
+        }
+
+        if (h->entries[best].key >= entry.key) break;
+
+        h->entries[i] = h->entries[best];
+        h->position[h->entries[i].vertex] = i;
+        i = best;
+    }
+    h->entries[i] = entry;
+    h->position[entry.vertex] = i;
+}
+
+/*
+ * heap_push - Inserts vertex @v (not already in the heap) with @key
+ *
+ * Time Complexity: O(log_d V)
+ */
+static inline void HEAP_NAME(heap_push)(HEAP_TYPE *h, vertex_t v, HEAP_KEY key) {
+    HEAP_ENTRY entry = { key, v };
+    HEAP_NAME(heap_sift_up)(h, h->size++, entry);
+}
+
+/*
+ * heap_decrease_key - Lowers the key of vertex @v (already in the heap)
+ *
+ * Time Complexity: O(log_d V)
+ */
+static inline void HEAP_NAME(heap_decrease_key)(HEAP_TYPE *h, vertex_t v, HEAP_KEY key) {
+    HEAP_ENTRY entry = { key, v };
+    HEAP_NAME(heap_sift_up)(h, h->position[v], entry);
+}
+
+/*
+ * heap_pop - Removes and returns the entry with the smallest key
+ *
+ * Must not be called on an empty heap.
+ *
+ * Time Complexity: O(d log_d V)
+ */
+static inline HEAP_ENTRY HEAP_NAME(heap_pop)(HEAP_TYPE *h) {
+    HEAP_ENTRY top = h->entries[0];
+    h->position[top.vertex] = -1;
+
+    h->size--;
+    if (h->size > 0) {
+        HEAP_NAME(heap_sift_down)(h, 0, h->entries[h->size]);
+    }
+    return top;
+}
+
+#undef HEAP_ENTRY
+#undef HEAP_TYPE
@@ -0,0 +1,361 @@
+/*
+ * landmarks.c - ALT Preprocessing (A*, Landmarks, Triangle inequality)
+ *
+ * A* needs a lower bound on the remaining distance. Without coordinates
+ * we precompute one: pick k landmark vertices and store the exact
+ * distances from every vertex to each landmark and back. At query time
+ * the triangle inequality turns two table lookups per landmark into a
+ * lower bound (see landmarks.h), and astar_search() does the rest.
+ *
+ * Preprocessing:
+ *   1. Add the reverse adjacency to the graph (backward distances)
+ *   2. For i = 1 .. k:
+ *        pick landmark L_i (farthest or avoid, below)
+ *        from[., i] = SSSP from L_i on the graph
+ *        to[., i]   = SSSP from L_i on the reverse graph
+ *   Cost: 2k (farthest) or 3k (avoid) full SSSP runs, 8 k V bytes.
+ *
+ * Good landmarks lie "behind" the vertices of typical queries, i.e. on
+ * the periphery of the graph. Both strategies look for such vertices.
+ *
+ * Tables can be written with save_landmarks() and mapped back with
+ * load_landmarks() (graph_file.c), so this runs once per graph, not at
+ * every startup.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "workspace.h"
+#include "landmarks.h"
+#include <sys/mman.h>
+
+/*
+ * reverse_view - The transposed graph as a CSRGraph the engines accept
+ *
+ * The view borrows g's reverse arrays and must not be freed.
+ */
+static CSRGraph reverse_view(const CSRGraph *g) {
+    CSRGraph view = *g;
+    view.offsets = g->reverse_offsets;
+    view.destinations = g->reverse_sources;
+    view.weights = g->reverse_weights;
+    view.mapping = NULL;
+    view.mapping_size = 0;
+    view.reverse_offsets = NULL;
+    view.reverse_sources = NULL;
+    view.reverse_weights = NULL;
+    view.coords = NULL;
+    return view;
+}
+
+/*
+ * select_farthest - Vertex farthest from the landmarks chosen so far
+ *
+ * For the first landmark "farthest" is measured from the random start
+ * vertex, whose distances are in @ws. Afterwards a vertex's score is its
+ * distance from the nearest existing landmark.
+ */
+static vertex_t select_farthest(const LandmarkTable *table, int chosen,
+                                const DijkstraWorkspace *ws) {
+    vertex_t best = -1;
+    int64_t best_score = -1;
+
+    for (vertex_t v = 0; v < table->num_vertices; v++) {
+        int64_t score;
+        if (chosen == 0) {
+            int d = workspace_distance(ws, v);
+            score = (d == INF) ? -1 : d;
+        } else {
+            const int *from = table->from + (size_t)v * (size_t)table->num_landmarks;
+            score = INF;
+            for (int i = 0; i < chosen; i++) {
+                /* Unreached vertices score 0: they would only help their own component */
+                int d = (from[i] == INF) ? 0 : from[i];
+                if (d < score) score = d;
+            }
+        }
+        if (score > best_score) {
+            best_score = score;
+            best = v;
+        }
+    }
+    return best;
+}
+
+/*
+ * select_avoid - Goldberg-Werneck "avoid" landmark selection
+ *
+ * Grow a shortest-path tree from the random root r (in @ws). Every
+ * vertex gets weight(v) = d(r, v) - LB(r, v): how badly the current
+ * landmarks underestimate its distance. size(v) is the total weight of
+ * v's subtree, and subtrees that already contain a landmark are excluded
+ * (a landmark only helps the vertices "behind" it once). Starting
+ * at the vertex of largest size, walk down to a leaf, always into the
+ * child of largest size; that leaf is the new landmark.
+ *
+ * Return: New landmark, or -1 if every branch is covered or on
+ *         allocation failure
+ */
+static vertex_t select_avoid(const LandmarkTable *table, int chosen, vertex_t root,
+                             const DijkstraWorkspace *ws) {
+    vertex_t n = table->num_vertices;
+    size_t k = (size_t)table->num_landmarks;
+    vertex_t count = ws->num_touched;
+    const vertex_t *tree = ws->touched;
+
+    /* Children of each tree vertex as a CSR over the touched vertices */
+    vertex_t *child_start = (vertex_t *)calloc((size_t)n + 1, sizeof(vertex_t));
+    vertex_t *children = (vertex_t *)malloc(((size_t)count + 1) * sizeof(vertex_t));
+    int64_t *size = (int64_t *)calloc((size_t)n + 1, sizeof(int64_t));
+    vertex_t *order = (vertex_t *)malloc(((size_t)count + 1) * sizeof(vertex_t));
+    bool *is_landmark = (bool *)calloc((size_t)n + 1, sizeof(bool));
+
+    if (child_start == NULL || children == NULL || size == NULL || order == NULL ||
+        is_landmark == NULL) {
+        free(child_start);
+        free(children);
+        free(size);
+        free(order);
+        free(is_landmark);
+        return -1;
+    }
+
+    for (int i = 0; i < chosen; i++) is_landmark[table->landmarks[i]] = true;
+
+    for (vertex_t j = 0; j < count; j++) {
+        vertex_t p = workspace_parent(ws, tree[j]);
+        if (p >= 0) child_start[p + 1]++;
+    }
+    for (vertex_t v = 0; v < n; v++) child_start[v + 1] += child_start[v];
+    for (vertex_t j = 0; j < count; j++) {
+        vertex_t p = workspace_parent(ws, tree[j]);
+        if (p >= 0) children[child_start[p]++] = tree[j];
+    }
+    for (vertex_t v = n; v > 0; v--) child_start[v] = child_start[v - 1];
+    child_start[0] = 0;
+
+    /* Pre-order from the root; sizes are then summed in reverse order */
+    vertex_t head = 0, tail = 0;
+    order[tail++] = root;
+    while (head < tail) {
+        vertex_t v = order[head++];
+        for (vertex_t c = child_start[v]; c < child_start[v + 1]; c++) {
+            order[tail++] = children[c];
+        }
+    }
+
+    const int *r_to = table->to + (size_t)root * k;
+    const int *r_from = table->from + (size_t)root * k;
+    LandmarkTable partial = *table;
+    partial.num_landmarks = chosen;
+
+    for (vertex_t j = tail - 1; j >= 0; j--) {
+        vertex_t v = order[j];
+        int lower = landmark_bound(&partial, r_to, r_from,
+                                   table->to + (size_t)v * k, table->from + (size_t)v * k);
+        int64_t weight = (int64_t)workspace_distance(ws, v) - (lower == INF ? 0 : lower);
+        int64_t total = weight;
+        bool has_landmark = is_landmark[v];
+
+        for (vertex_t c = child_start[v]; c < child_start[v + 1]; c++) {
+            if (size[children[c]] < 0) {
+                has_landmark = true;
+            } else {
+                total += size[children[c]];
+            }
+        }
+        size[v] = has_landmark ? -1 : total;  /* -1 marks "contains a landmark" */
+    }
+
+    vertex_t best = root;
+    for (vertex_t j = 0; j < tail; j++) {
+        if (size[order[j]] > size[best]) best = order[j];
+    }
+    for (;;) {
+        vertex_t next = -1;
+        for (vertex_t c = child_start[best]; c < child_start[best + 1]; c++) {
+            if (next == -1 || size[children[c]] > size[next]) next = children[c];
+        }
+        if (next == -1 || size[next] < 0) break;
+        best = next;
+    }
+    if (size[best] < 0) best = -1;  /* Every subtree already has a landmark */
+
+    free(child_start);
+    free(children);
+    free(size);
+    free(order);
+    free(is_landmark);
+    return best;
+}
+
+/*
+ * fill_column - Stores the distances of the last query on @g as table column i
+ *
+ * The query leaves INF both at unreachable vertices and at vertices whose
+ * distance saturated. When the farthest distance plus the heaviest edge
+ * can reach INF, a search from the reached vertices tells them apart and
+ * stores the saturated ones as LANDMARK_FAR (see landmarks.h).
+ *
+ * Return: false on allocation failure
+ */
+static bool fill_column(int *column, size_t k, const CSRGraph *g, int max_weight,
+                        const DijkstraWorkspace *ws) {
+    vertex_t n = g->num_vertices;
+    int farthest = 0;
+    for (vertex_t v = 0; v < n; v++) {
+        int d = workspace_distance(ws, v);
+        column[(size_t)v * k] = d;
+        if (d != INF && d > farthest) farthest = d;
+    }
+    if (dist_add(farthest, max_weight) != INF) return true;
+
+    /* Every vertex is pushed at most once: when reached, or when marked */
+    vertex_t *stack = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+    if (stack == NULL) return false;
+    for (vertex_t s = 0; s < n; s++) {
+        if (column[(size_t)s * k] == INF) continue;
+        vertex_t top = 0;
+        stack[top++] = s;
+        while (top > 0) {
+            vertex_t u = stack[--top];
+            for (edge_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                vertex_t w = g->destinations[e];
+                if (column[(size_t)w * k] != INF) continue;
+                column[(size_t)w * k] = LANDMARK_FAR;
+                stack[top++] = w;
+            }
+        }
+    }
+    free(stack);
+    return true;
+}
+
+/*
+ * build_landmarks - Selects landmarks and computes the ALT tables
+ *
+ * @g:             Graph (its reverse adjacency is built if missing)
+ * @num_landmarks: k, between 1 and min(V, 64); 8-16 is typical
+ * @strategy:      LANDMARKS_FARTHEST or LANDMARKS_AVOID
+ * @seed:          Seed for the random start vertex (deterministic)
+ *
+ * Time Complexity:  O(k (V + E) log V)
+ * Space Complexity: O(k V)
+ *
+ * Return: Landmark table, or NULL on failure
+ *         Caller must call free_landmarks()!
+ */
+LandmarkTable *build_landmarks(CSRGraph *g, int num_landmarks, LandmarkStrategy strategy,
+                               uint64_t seed) {
+    if (g == NULL || num_landmarks < 1 || num_landmarks > MAX_LANDMARKS ||
+        num_landmarks > g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to build_landmarks() (1 <= k <= %d, k <= V)\n",
+                MAX_LANDMARKS);
+        return NULL;
+    }
+    if (!build_reverse_graph(g)) return NULL;
+
+    vertex_t n = g->num_vertices;
+    size_t k = (size_t)num_landmarks;
+    CSRGraph reverse = reverse_view(g);
+
+    LandmarkTable *table = (LandmarkTable *)calloc(1, sizeof(LandmarkTable));
+    DijkstraWorkspace *ws = create_workspace(n);
+    if (table != NULL) {
+        table->num_landmarks = num_landmarks;
+        table->num_vertices = n;
+        table->num_edges = g->num_edges;
+        table->landmarks = (vertex_t *)malloc(k * sizeof(vertex_t));
+        table->to = (int *)malloc(((size_t)n * k + 1) * sizeof(int));
+        table->from = (int *)malloc(((size_t)n * k + 1) * sizeof(int));
+    }
+    if (table == NULL || ws == NULL || table->landmarks == NULL ||
+        table->to == NULL || table->from == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed in build_landmarks()\n");
+        free_landmarks(table);
+        free_workspace(ws);
+        return NULL;
+    }
+
+    /* Random start vertex: splitmix64 of the seed */
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    vertex_t root = (vertex_t)((z ^ (z >> 31)) % (uint64_t)n);
+
+    int max_weight = 0;
+    for (edge_t e = 0; e < g->num_edges; e++) {
+        if (g->weights[e] > max_weight) max_weight = g->weights[e];
+    }
+
+    bool ok = true;
+    for (int i = 0; i < num_landmarks && ok; i++) {
+        vertex_t landmark;
+
+        if (strategy == LANDMARKS_AVOID) {
+            ok = dijkstra_workspace(ws, g, root);
+            landmark = ok ? select_avoid(table, i, root, ws) : -1;
+            /* Everything reachable from root is covered: fall back to farthest */
+            if (ok && landmark < 0) landmark = select_farthest(table, i, ws);
+        } else {
+            if (i == 0) ok = dijkstra_workspace(ws, g, root);
+            landmark = ok ? select_farthest(table, i, ws) : -1;
+        }
+        if (!ok || landmark < 0) {
+            ok = false;
+            break;
+        }
+
+        table->landmarks[i] = landmark;
+        ok = dijkstra_workspace(ws, g, landmark) &&
+             fill_column(table->from + i, k, g, max_weight, ws) &&
+             dijkstra_workspace(ws, &reverse, landmark) &&
+             fill_column(table->to + i, k, &reverse, max_weight, ws);
+    }
+
+    free_workspace(ws);
+    if (!ok) {
+        fprintf(stderr, "Error: Landmark preprocessing failed\n");
+        free_landmarks(table);
+        return NULL;
+    }
+    return table;
+}
+
+/*
+ * alt_search - A* with landmark lower bounds
+ *
+ * @ws:     Workspace with capacity >= g->num_vertices
+ * @g:      Graph the table was built for
+ * @table:  Landmark table from build_landmarks() or load_landmarks()
+ * @source: Starting vertex
+ * @target: Destination vertex
+ *
+ * Return: true on success; use workspace_distance(ws, target) and
+ *         workspace_path(ws, target)
+ */
+bool alt_search(DijkstraWorkspace *ws, const CSRGraph *g, const LandmarkTable *table,
+                vertex_t source, vertex_t target) {
+    if (table == NULL || g == NULL || table->num_edges != g->num_edges) {
+        fprintf(stderr, "Error: Landmark table does not belong to this graph\n");
+        return false;
+    }
+    Heuristic h = { HEURISTIC_LANDMARKS, 0.0, NULL, table };
+    return astar_search(ws, g, source, target, &h);
+}
+
+/*
+ * free_landmarks - Releases a landmark table (unmapping it if loaded)
+ */
+void free_landmarks(LandmarkTable *table) {
+    if (table == NULL) return;
+
+    if (table->mapping != NULL) {
+        munmap(table->mapping, table->mapping_size);
+    } else {
+        free(table->landmarks);
+        free(table->to);
+        free(table->from);
+    }
+    free(table);
+}
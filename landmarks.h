@@ -0,0 +1,68 @@
+/*
+ * landmarks.h - ALT Lower Bounds (internal)
+ *
+ * For any landmark L the triangle inequality gives two lower bounds on
+ * the distance from v to t:
+ *
+ *     d(v, t) >= d(v, L) - d(t, L)        (v → t → L is no shorter than v → L)
+ *     d(v, t) >= d(L, t) - d(L, v)        (L → v → t is no shorter than L → t)
+ *
+ * The ALT heuristic is the largest of these over all k landmarks. It is
+ * consistent, so A* with it settles every vertex at most once.
+ *
+ * Unreachable entries (INF) also carry information: if t can reach L but
+ * v cannot, then v cannot reach t either, and the bound is INF. So INF
+ * in a table means unreachable only; a vertex whose distance saturated
+ * (a path of INT_MAX or more) is stored as LANDMARK_FAR instead.
+ *
+ * Shared by the preprocessing (landmarks.c, "avoid" selection) and the
+ * query loop (astar.c), where it is inlined.
+ */
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "dijkstra.h"
+
+/*
+ * LANDMARK_FAR - Entry of a vertex reachable only by a path of INF or more
+ *
+ * Every bound stays a lower bound: read as d(v, L) it underestimates the
+ * true distance, and read as d(t, L) no other entry exceeds it, so it
+ * only ever yields a difference <= 0.
+ */
+#define LANDMARK_FAR (INF - 1)
+
+/*
+ * landmark_bound - ALT lower bound on d(v, t)
+ *
+ * @table:    Landmark table
+ * @v_to:     table->to   + v * k
+ * @v_from:   table->from + v * k
+ * @t_to:     table->to   + t * k
+ * @t_from:   table->from + t * k
+ *
+ * Taking row pointers lets the query hoist the target's rows out of the
+ * loop.
+ *
+ * Return: Lower bound (0 .. INF)
+ */
+static inline int landmark_bound(const LandmarkTable *table,
+                                 const int *v_to, const int *v_from,
+                                 const int *t_to, const int *t_from) {
+    int best = 0;
+
+    for (int i = 0; i < table->num_landmarks; i++) {
+        if (t_to[i] != INF) {
+            if (v_to[i] == INF) return INF;
+            if (v_to[i] - t_to[i] > best) best = v_to[i] - t_to[i];
+        }
+        if (v_from[i] != INF) {
+            if (t_from[i] == INF) return INF;
+            if (t_from[i] - v_from[i] > best) best = t_from[i] - v_from[i];
+        }
+    }
+    return best;
+}
+
+#endif /* LANDMARKS_H */
@@ -11,8 +11,12 @@
  * 4. Testing and verification
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "dijkstra.h"
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 /*
  * EXAMPLE GRAPHS
@@ -163,19 +167,114 @@ Graph *create_example_graph_3(void) {
     return g;
 }
 
+/*
+ * create_geometric_grid - side x side street grid with coordinates
+ * 
+ * Vertex (x, y) sits at (10x, 10y); each street has weight 10..14, so
+ * no edge is shorter than the straight line between its endpoints.
+ */
+Graph *create_geometric_grid(vertex_t side) {
+    Graph *g = create_graph(side * side);
+    if (g == NULL) return NULL;
+    
+    for (vertex_t y = 0; y < side; y++) {
+        for (vertex_t x = 0; x < side; x++) {
+            vertex_t v = y * side + x;
+            set_vertex_coord(g, v, 10.0 * x, 10.0 * y);
+            if (x + 1 < side) add_undirected_edge(g, v, v + 1, 10 + (int)((x * 7 + y * 3) % 5));
+            if (y + 1 < side) add_undirected_edge(g, v, v + side, 10 + (int)((x * 3 + y * 7) % 5));
+        }
+    }
+    return g;
+}
+
+/*
+ * manhattan_heuristic - Custom A* heuristic for create_geometric_grid()
+ * 
+ * Every street is axis-aligned and at least as long as it is heavy, so
+ * the Manhattan distance is a (tighter than Euclidean) lower bound.
+ */
+static int manhattan_heuristic(vertex_t v, vertex_t target, const void *context) {
+    const VertexCoord *coords = (const VertexCoord *)context;
+    double dx = coords[v].x - coords[target].x;
+    double dy = coords[v].y - coords[target].y;
+    return (int)((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+}
+
+/*
+ * next_random - Small deterministic LCG for the randomized tests
+ */
+static int next_random(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int)(*state >> 33);
+}
+
+/*
+ * TreeCheck / check_tree - Batch callback comparing each full search
+ * against the s-t answers of an earlier batch (row source of @distances)
+ * 
+ * Each worker counts into its own slot, so no lock is needed.
+ */
+typedef struct TreeCheck {
+    const int *distances;
+    vertex_t num_vertices;
+    int mismatches[4];
+} TreeCheck;
+
+static void check_tree(const BatchQuery *query, size_t index, int worker,
+                       const DijkstraWorkspace *ws, void *context) {
+    TreeCheck *check = (TreeCheck *)context;
+    const int *row = check->distances + (size_t)query->source * (size_t)check->num_vertices;
+    (void)index;
+    
+    for (vertex_t v = 0; v < check->num_vertices; v++) {
+        if (workspace_distance(ws, v) != row[v]) check->mismatches[worker]++;
+    }
+}
+
+/*
+ * load_text_graph - Writes @length bytes of @text to a temporary file and
+ * loads it with load_graph() on @num_threads parser threads
+ */
+static CSRGraph *load_text_graph(const char *text, size_t length, GraphFormat format,
+                                 int num_threads) {
+    char path[] = "/tmp/dijkstra_textXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    bool written = write(fd, text, length) == (ssize_t)length;
+    close(fd);
+    CSRGraph *g = written ? load_graph(path, format, num_threads) : NULL;
+    remove(path);
+    return g;
+}
+
+/*
+ * same_distances - Tells whether two graphs give the same distances from @source
+ */
+static bool same_distances(const CSRGraph *a, const CSRGraph *b, vertex_t source) {
+    if (a == NULL || b == NULL || a->num_vertices != b->num_vertices) return false;
+    DijkstraResult *ra = dijkstra_heap_csr(a, source);
+    DijkstraResult *rb = dijkstra_heap_csr(b, source);
+    bool same = ra != NULL && rb != NULL &&
+                memcmp(ra->distance, rb->distance, (size_t)a->num_vertices * sizeof(int)) == 0;
+    free_result(ra);
+    free_result(rb);
+    return same;
+}
+
 /*
  * verify_result - Checks if algorithm output matches expected values
  */
-bool verify_result(DijkstraResult *result, int *expected, int n) {
+bool verify_result(DijkstraResult *result, int *expected, vertex_t n) {
     if (result == NULL || expected == NULL) return false;
     
     bool correct = true;
-    for (int i = 0; i < n; i++) {
+    for (vertex_t i = 0; i < n; i++) {
         int got = result->distance[i];
         int exp = expected[i];
         
         if (got != exp) {
-            printf("  ❌ Vertex %d: got %d, expected %d\n", i, 
+            printf("  ❌ Vertex %" PRIdVERTEX ": got %d, expected %d\n", i, 
                    (got == INF) ? -1 : got, 
                    (exp == INF) ? -1 : exp);
             correct = false;
@@ -192,19 +291,19 @@ bool verify_result(DijkstraResult *result, int *expected, int n) {
 /*
  * demo_path_reconstruction - Shows how to use the get_path function
  */
-void demo_path_reconstruction(DijkstraResult *result, int dest) {
-    int path_length;
-    int *path = get_path(result, dest, &path_length);
+void demo_path_reconstruction(DijkstraResult *result, vertex_t dest) {
+    vertex_t path_length;
+    vertex_t *path = get_path(result, dest, &path_length);
     
     if (path == NULL) {
-        printf("  No path exists to vertex %d\n", dest);
+        printf("  No path exists to vertex %" PRIdVERTEX "\n", dest);
         return;
     }
     
-    printf("  Path to vertex %d (length %d): ", dest, path_length);
-    for (int i = 0; i < path_length; i++) {
+    printf("  Path to vertex %" PRIdVERTEX " (length %" PRIdVERTEX "): ", dest, path_length);
+    for (vertex_t i = 0; i < path_length; i++) {
         if (i > 0) printf(" → ");
-        printf("%d", path[i]);
+        printf("%" PRIdVERTEX, path[i]);
     }
     printf("\n");
     printf("  Total distance: %d\n", result->distance[dest]);
@@ -339,16 +438,21 @@ void run_comprehensive_demo(void) {
         if (result_array != NULL && result_heap != NULL) {
             printf("\n>>> Comparing results:\n");
             bool match = true;
-            for (int i = 0; i < g4->num_vertices; i++) {
+            for (vertex_t i = 0; i < g4->num_vertices; i++) {
                 if (result_array->distance[i] != result_heap->distance[i]) {
                     match = false;
-                    printf("  ❌ Mismatch at vertex %d\n", i);
+                    printf("  ❌ Mismatch at vertex %" PRIdVERTEX "\n", i);
                 }
             }
             if (match) {
                 printf("  ✓ Both implementations produce identical results!\n");
             }
             
+            printf("\n>>> Work done by the array implementation:\n");
+            print_stats(&result_array->stats);
+            printf("\n>>> Work done by the heap implementation:\n");
+            print_stats(&result_heap->stats);
+            
             printf("\n>>> Array implementation results:\n");
             print_result(result_array);
             
@@ -358,55 +462,1978 @@ void run_comprehensive_demo(void) {
         
         free_graph(g4);
     }
-}
-
-/*
- * print_complexity_analysis - Educational output about algorithm complexity
- */
-void print_complexity_analysis(void) {
+    
+    /*
+     * TEST 5: Frozen CSR engines vs adjacency-list engine
+     */
     printf("\n");
-    printf("╔══════════════════════════════════════════════════════════╗\n");
-    printf("║            COMPLEXITY ANALYSIS                           ║\n");
-    printf("╠══════════════════════════════════════════════════════════╣\n");
-    printf("║                                                          ║\n");
-    printf("║  Implementation  │ EXTRACT-MIN │ DECREASE-KEY │ Total    ║\n");
-    printf("║  ───────────────┼─────────────┼──────────────┼───────── ║\n");
-    printf("║  Array          │    O(V)     │     O(1)     │ O(V²)    ║\n");
-    printf("║  Binary Heap    │  O(log V)   │   O(log V)   │O((V+E)lgV)║\n");
-    printf("║  Fibonacci Heap │  O(log V)*  │     O(1)*    │O(VlgV+E) ║\n");
-    printf("║                                                          ║\n");
-    printf("║  * amortized                                             ║\n");
-    printf("║                                                          ║\n");
-    printf("║  When to use which:                                      ║\n");
-    printf("║  • Dense graphs (E ≈ V²): Array is simpler, same O(V²)  ║\n");
-    printf("║  • Sparse graphs (E ≈ V): Heap gives O(V log V)         ║\n");
-    printf("║                                                          ║\n");
-    printf("╚══════════════════════════════════════════════════════════╝\n");
-}
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 5: Frozen CSR Graph Engines                  \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g5 = create_example_graph_3();
+    if (g5 != NULL) {
+        CSRGraph *csr5 = freeze_graph(g5);
+        DijkstraResult *reference = dijkstra_heap(g5, 0);
+        DijkstraResult *result_csr = dijkstra_csr(csr5, 0);
+        DijkstraResult *result_heap_csr = dijkstra_heap_csr(csr5, 0);
+        DijkstraResult *result_dial = dijkstra_dial(csr5, 0);
+        DijkstraResult *result_radix = dijkstra_radix(csr5, 0);
+        
+        if (reference != NULL && result_csr != NULL && result_heap_csr != NULL &&
+            result_dial != NULL && result_radix != NULL) {
+            printf("\n>>> dijkstra_csr():\n");
+            verify_result(result_csr, reference->distance, g5->num_vertices);
+            printf(">>> dijkstra_heap_csr():\n");
+            verify_result(result_heap_csr, reference->distance, g5->num_vertices);
+            printf(">>> dijkstra_dial() (bucket queue):\n");
+            verify_result(result_dial, reference->distance, g5->num_vertices);
+            printf(">>> dijkstra_radix() (radix heap):\n");
+            verify_result(result_radix, reference->distance, g5->num_vertices);
+        }
+        
+        free_result(reference);
+        free_result(result_csr);
+        free_result(result_heap_csr);
+        free_result(result_dial);
+        free_result(result_radix);
+        free_csr_graph(csr5);
+        free_graph(g5);
+    }
 
-/*
- * print_usage - Shows how to use this program
- */
-void print_usage(void) {
-    printf("\n");
-    printf("╔══════════════════════════════════════════════════════════╗\n");
-    printf("║                    USAGE                                 ║\n");
-    printf("╠══════════════════════════════════════════════════════════╣\n");
-    printf("║                                                          ║\n");
-    printf("║  Compile:  gcc -Wall -o dijkstra main.c graph.c          ║\n");
-    printf("║                                   dijkstra.c             ║\n");
-    printf("║                                                          ║\n");
-    printf("║  Or use:   make                                          ║\n");
-    printf("║                                                          ║\n");
-    printf("║  Run:      ./dijkstra                                    ║\n");
-    printf("║                                                          ║\n");
-    printf("╚══════════════════════════════════════════════════════════╝\n");
-}
+    /* A 140-vertex chain of 2^24 weights: d(0, v) = v * 2^24 passes INT_MAX at v = 128 */
+    Graph *chain5 = create_graph(140);
+    for (vertex_t v = 0; chain5 != NULL && v < 139; v++) add_edge(chain5, v, v + 1, 1 << 24);
+    CSRGraph *chain_csr5 = (chain5 != NULL) ? freeze_graph(chain5) : NULL;
+    DijkstraResult *chain_dial = (chain_csr5 != NULL) ? dijkstra_dial(chain_csr5, 0) : NULL;
+    DijkstraResult *chain_radix = (chain_csr5 != NULL) ? dijkstra_radix(chain_csr5, 0) : NULL;
 
-/*
- * main - Program entry point
- */
-int main(void) {
+    bool chain_correct = (chain_dial != NULL && chain_radix != NULL);
+    for (vertex_t v = 0; chain_correct && v < 140; v++) {
+        int expected = (v < 128) ? v * (1 << 24) : INF;
+        chain_correct = (chain_dial->distance[v] == expected && chain_radix->distance[v] == expected);
+    }
+    printf("\n>>> Chain of 139 edges of weight 2^24 (overflow past vertex 127):\n");
+    if (chain_correct) {
+        printf("  ✓ Dial and radix saturate at INF instead of wrapping!\n");
+    } else {
+        printf("  ❌ Bucket queues wrapped past INT_MAX\n");
+    }
+    free_result(chain_dial);
+    free_result(chain_radix);
+    free_csr_graph(chain_csr5);
+    free_graph(chain5);
+
+    /*
+     * TEST 6: One workspace reused for every source
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 6: Reusable Query Workspace                  \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g6 = create_example_graph_3();
+    if (g6 != NULL) {
+        CSRGraph *csr6 = freeze_graph(g6);
+        DijkstraWorkspace *ws = (csr6 != NULL) ? create_workspace(csr6->num_vertices) : NULL;
+        
+        if (ws != NULL) {
+            bool correct = true;
+            for (vertex_t s = 0; s < csr6->num_vertices; s++) {
+                DijkstraResult *reference = dijkstra_heap_csr(csr6, s);
+                if (reference == NULL || !dijkstra_workspace(ws, csr6, s)) {
+                    free_result(reference);
+                    correct = false;
+                    break;
+                }
+                for (vertex_t v = 0; v < csr6->num_vertices; v++) {
+                    if (workspace_distance(ws, v) != reference->distance[v]) {
+                        printf("  ❌ Source %" PRIdVERTEX ", vertex %" PRIdVERTEX
+                               ": got %d, expected %d\n", s, v,
+                               workspace_distance(ws, v), reference->distance[v]);
+                        correct = false;
+                    }
+                }
+                free_result(reference);
+            }
+            
+            printf("\n>>> %" PRIdVERTEX " queries on one workspace:\n", csr6->num_vertices);
+            if (correct) {
+                printf("  ✓ All distances match dijkstra_heap_csr()!\n");
+            }
+        }
+        
+        free_workspace(ws);
+        free_csr_graph(csr6);
+        free_graph(g6);
+    }
+    
+    /*
+     * TEST 7: Point-to-point queries stop at the target
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 7: Point-to-Point Queries                    \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g7 = create_example_graph_1();
+    if (g7 != NULL) {
+        DijkstraResult *full = dijkstra_heap(g7, 0);
+        CSRGraph *csr7 = freeze_graph(g7);
+        DijkstraWorkspace *ws = (csr7 != NULL) ? create_workspace(csr7->num_vertices) : NULL;
+        
+        if (full != NULL && ws != NULL) {
+            printf("\n>>> dijkstra_to() (full search settles %" PRIu64 " vertices):\n",
+                   full->stats.vertices_settled);
+            bool correct = true;
+            for (vertex_t t = 0; t < g7->num_vertices; t++) {
+                ShortestPath *sp = dijkstra_to(g7, 0, t);
+                if (sp == NULL) {
+                    correct = false;
+                    continue;
+                }
+                print_shortest_path(sp);
+                printf("    settled %" PRIu64 " vertices\n", sp->stats.vertices_settled);
+                if (sp->distance != full->distance[t]) correct = false;
+                free_shortest_path(sp);
+                
+                /* Same query, allocation-free CSR form */
+                ShortestPath *wp = NULL;
+                if (dijkstra_workspace_to(ws, csr7, 0, t)) {
+                    wp = workspace_path(ws, t);
+                }
+                if (wp == NULL || wp->distance != full->distance[t]) correct = false;
+                free_shortest_path(wp);
+            }
+            
+            printf("\n>>> Verification:\n");
+            if (correct) {
+                printf("  ✓ dijkstra_to() and dijkstra_workspace_to() match dijkstra_heap()!\n");
+            } else {
+                printf("  ❌ Point-to-point distances differ from dijkstra_heap()\n");
+            }
+        }
+        
+        free_workspace(ws);
+        free_csr_graph(csr7);
+        free_result(full);
+        free_graph(g7);
+    }
+    
+    Graph *g8 = create_example_graph_3();
+    if (g8 != NULL) {
+        printf("\n>>> Unreachable target (graph 3, 0 → 4):\n");
+        ShortestPath *sp = dijkstra_to(g8, 0, 4);
+        print_shortest_path(sp);
+        free_shortest_path(sp);
+        free_graph(g8);
+    }
+    
+    /*
+     * TEST 8: Bidirectional search on every pair
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 8: Bidirectional Dijkstra                    \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("\n");
+    
+    Graph *(*examples[])(void) = {
+        create_example_graph_1, create_example_graph_2, create_example_graph_3
+    };
+    for (int e = 0; e < 3; e++) {
+        Graph *g = examples[e]();
+        CSRGraph *csr = (g != NULL) ? freeze_graph(g) : NULL;
+        DijkstraWorkspace *forward = (csr != NULL) ? create_workspace(csr->num_vertices) : NULL;
+        DijkstraWorkspace *backward = (csr != NULL) ? create_workspace(csr->num_vertices) : NULL;
+        
+        if (forward != NULL && backward != NULL && build_reverse_graph(csr)) {
+            bool correct = true;
+            for (vertex_t s = 0; s < csr->num_vertices; s++) {
+                for (vertex_t t = 0; t < csr->num_vertices; t++) {
+                    ShortestPath *expected = dijkstra_to(g, s, t);
+                    ShortestPath *sp = dijkstra_bidirectional(forward, backward, csr, s, t);
+                    if (expected == NULL || sp == NULL || sp->distance != expected->distance) {
+                        correct = false;
+                    } else if (sp->distance != INF) {
+                        /* The joined path must start at s, end at t, and add up */
+                        int total = 0;
+                        for (vertex_t i = 0; i + 1 < sp->length; i++) {
+                            int w = INF;
+                            for (Edge *edge = g->adj_list[sp->vertices[i]]; edge != NULL;
+                                 edge = edge->next) {
+                                if (edge->destination == sp->vertices[i + 1] && edge->weight < w) {
+                                    w = edge->weight;
+                                }
+                            }
+                            total = (w == INF) ? INF : total + w;
+                            if (w == INF) break;
+                        }
+                        if (sp->vertices[0] != s || sp->vertices[sp->length - 1] != t ||
+                            total != sp->distance) {
+                            correct = false;
+                        }
+                    }
+                    free_shortest_path(expected);
+                    free_shortest_path(sp);
+                }
+            }
+            
+            if (correct) {
+                printf("  ✓ Graph %d: all %" PRIdVERTEX " pairs match dijkstra_to()!\n",
+                       e + 1, csr->num_vertices * csr->num_vertices);
+            } else {
+                printf("  ❌ Graph %d: bidirectional result differs from dijkstra_to()\n", e + 1);
+            }
+        }
+        
+        free_workspace(forward);
+        free_workspace(backward);
+        free_csr_graph(csr);
+        free_graph(g);
+    }
+    
+    /*
+     * TEST 9: A* with coordinates
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 9: A* Search (10 x 10 street grid)           \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g9 = create_geometric_grid(10);
+    CSRGraph *csr9 = (g9 != NULL) ? freeze_graph(g9) : NULL;
+    DijkstraWorkspace *ws9 = (csr9 != NULL) ? create_workspace(csr9->num_vertices) : NULL;
+    if (ws9 != NULL) {
+        Heuristic heuristics[3] = {
+            { HEURISTIC_ZERO, 0.0, NULL, NULL },
+            { HEURISTIC_EUCLIDEAN, heuristic_scale(csr9, HEURISTIC_EUCLIDEAN), NULL, NULL },
+            { HEURISTIC_CUSTOM, 0.0, manhattan_heuristic, csr9->coords }
+        };
+        const char *names[3] = { "none (Dijkstra)", "Euclidean", "Manhattan (custom)" };
+        
+        printf("\n>>> Along one side (0 → 9), Euclidean scale %.3f:\n", heuristics[1].scale);
+        for (int k = 0; k < 3; k++) {
+            if (astar_search(ws9, csr9, 0, 9, &heuristics[k])) {
+                printf("  %-20s distance %d, settled %" PRIu64 " vertices\n", names[k],
+                       workspace_distance(ws9, 9), workspace_stats(ws9)->vertices_settled);
+            }
+        }
+        
+        bool correct = true;
+        for (vertex_t s = 0; s < csr9->num_vertices; s += 7) {
+            for (vertex_t t = 0; t < csr9->num_vertices; t++) {
+                ShortestPath *expected = dijkstra_to(g9, s, t);
+                for (int k = 1; k < 3 && expected != NULL; k++) {
+                    if (!astar_search(ws9, csr9, s, t, &heuristics[k]) ||
+                        workspace_distance(ws9, t) != expected->distance) {
+                        correct = false;
+                    }
+                }
+                if (expected == NULL) correct = false;
+                free_shortest_path(expected);
+            }
+        }
+        
+        printf("\n>>> Verification:\n");
+        if (correct) {
+            printf("  ✓ A* distances match dijkstra_to() for both heuristics!\n");
+        } else {
+            printf("  ❌ A* distances differ from dijkstra_to()\n");
+        }
+    }
+    free_workspace(ws9);
+    free_csr_graph(csr9);
+    free_graph(g9);
+    
+    /*
+     * TEST 10: ALT landmarks instead of coordinates
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 10: ALT Landmarks (same grid, no coords)     \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g10 = create_geometric_grid(10);
+    CSRGraph *csr10 = (g10 != NULL) ? freeze_graph(g10) : NULL;
+    DijkstraWorkspace *ws10 = (csr10 != NULL) ? create_workspace(csr10->num_vertices) : NULL;
+    if (ws10 != NULL) {
+        /* ALT must not need geometry */
+        free(csr10->coords);
+        csr10->coords = NULL;
+        
+        LandmarkStrategy strategies[2] = { LANDMARKS_FARTHEST, LANDMARKS_AVOID };
+        const char *names[2] = { "farthest", "avoid" };
+        bool correct = true;
+        
+        printf("\n>>> 4 landmarks, along one side (0 → 9):\n");
+        if (dijkstra_workspace_to(ws10, csr10, 0, 9)) {
+            printf("  %-20s distance %d, settled %" PRIu64 " vertices\n", "none (Dijkstra)",
+                   workspace_distance(ws10, 9), workspace_stats(ws10)->vertices_settled);
+        }
+        
+        for (int k = 0; k < 2; k++) {
+            LandmarkTable *table = build_landmarks(csr10, 4, strategies[k], 42);
+            if (table == NULL) {
+                correct = false;
+                continue;
+            }
+            if (alt_search(ws10, csr10, table, 0, 9)) {
+                printf("  %-20s distance %d, settled %" PRIu64 " vertices (landmarks",
+                       names[k], workspace_distance(ws10, 9),
+                       workspace_stats(ws10)->vertices_settled);
+                for (int i = 0; i < table->num_landmarks; i++) {
+                    printf(" %" PRIdVERTEX, table->landmarks[i]);
+                }
+                printf(")\n");
+            }
+            
+            for (vertex_t s = 0; s < csr10->num_vertices; s += 7) {
+                for (vertex_t t = 0; t < csr10->num_vertices; t++) {
+                    ShortestPath *expected = dijkstra_to(g10, s, t);
+                    if (expected == NULL || !alt_search(ws10, csr10, table, s, t) ||
+                        workspace_distance(ws10, t) != expected->distance) {
+                        correct = false;
+                    }
+                    free_shortest_path(expected);
+                }
+            }
+            free_landmarks(table);
+        }
+        
+        /* Disconnected graph: INF entries must prune, never lose a route */
+        Graph *g3 = create_example_graph_3();
+        CSRGraph *csr3 = (g3 != NULL) ? freeze_graph(g3) : NULL;
+        LandmarkTable *table3 = (csr3 != NULL) ? build_landmarks(csr3, 2, LANDMARKS_AVOID, 7) : NULL;
+        if (table3 == NULL) correct = false;
+        for (vertex_t s = 0; table3 != NULL && s < csr3->num_vertices; s++) {
+            for (vertex_t t = 0; t < csr3->num_vertices; t++) {
+                ShortestPath *expected = dijkstra_to(g3, s, t);
+                if (expected == NULL || !alt_search(ws10, csr3, table3, s, t) ||
+                    workspace_distance(ws10, t) != expected->distance) {
+                    correct = false;
+                }
+                free_shortest_path(expected);
+            }
+        }
+        free_landmarks(table3);
+        free_csr_graph(csr3);
+        free_graph(g3);
+        
+        /* Tables survive a save / load round trip */
+        char path[] = "/tmp/dijkstra_landmarksXXXXXX";
+        int fd = mkstemp(path);
+        LandmarkTable *built = build_landmarks(csr10, 4, LANDMARKS_AVOID, 42);
+        LandmarkTable *loaded = NULL;
+        if (fd >= 0 && built != NULL && save_landmarks(built, path)) {
+            loaded = load_landmarks(path, csr10);
+        }
+        size_t cells = (size_t)csr10->num_vertices * 4;
+        if (loaded == NULL || loaded->num_landmarks != built->num_landmarks ||
+            memcmp(loaded->to, built->to, cells * sizeof(int)) != 0 ||
+            memcmp(loaded->from, built->from, cells * sizeof(int)) != 0 ||
+            !alt_search(ws10, csr10, loaded, 0, 99) || workspace_distance(ws10, 99) == INF) {
+            correct = false;
+        }
+        free_landmarks(loaded);
+        free_landmarks(built);
+        if (fd >= 0) {
+            close(fd);
+            remove(path);
+        }
+        
+        printf("\n>>> Verification:\n");
+        if (correct) {
+            printf("  ✓ ALT distances match dijkstra_to() for both strategies!\n");
+            printf("  ✓ Disconnected graph and saved/loaded tables agree too!\n");
+        } else {
+            printf("  ❌ ALT distances differ from dijkstra_to()\n");
+        }
+    }
+    free_workspace(ws10);
+    free_csr_graph(csr10);
+    free_graph(g10);
+    
+    /*
+     * TEST 11: Contraction Hierarchies
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 11: Contraction Hierarchies                  \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *(*ch_examples[])(void) = {
+        create_example_graph_1, create_example_graph_2, create_example_graph_3
+    };
+    bool ch_correct = true;
+    for (int e = 0; e < 4; e++) {
+        Graph *g = (e < 3) ? ch_examples[e]() : create_geometric_grid(10);
+        CSRGraph *csr = (g != NULL) ? freeze_graph(g) : NULL;
+        ContractionHierarchy *ch = (csr != NULL) ? build_contraction_hierarchy(csr, 2) : NULL;
+        DijkstraWorkspace *forward = (ch != NULL) ? create_workspace(csr->num_vertices) : NULL;
+        DijkstraWorkspace *backward = (ch != NULL) ? create_workspace(csr->num_vertices) : NULL;
+        if (forward == NULL || backward == NULL) ch_correct = false;
+        
+        for (vertex_t s = 0; backward != NULL && s < csr->num_vertices; s++) {
+            for (vertex_t t = 0; t < csr->num_vertices; t++) {
+                ShortestPath *expected = dijkstra_to(g, s, t);
+                ShortestPath *sp = ch_shortest_path(forward, backward, ch, s, t);
+                if (expected == NULL || sp == NULL || sp->distance != expected->distance ||
+                    (sp->distance != INF &&
+                     (sp->vertices[0] != s || sp->vertices[sp->length - 1] != t))) {
+                    ch_correct = false;
+                } else if (sp->distance != INF) {
+                    /* Unpacked shortcuts must be real edges adding up to the distance */
+                    int total = 0;
+                    for (vertex_t i = 0; i + 1 < sp->length; i++) {
+                        int w = INF;
+                        for (Edge *edge = g->adj_list[sp->vertices[i]]; edge != NULL;
+                             edge = edge->next) {
+                            if (edge->destination == sp->vertices[i + 1] && edge->weight < w) {
+                                w = edge->weight;
+                            }
+                        }
+                        if (w == INF) {
+                            ch_correct = false;
+                            break;
+                        }
+                        total += w;
+                    }
+                    if (total != sp->distance) ch_correct = false;
+                }
+                free_shortest_path(expected);
+                free_shortest_path(sp);
+            }
+        }
+        
+        if (e == 3 && backward != NULL) {
+            ShortestPath *sp = ch_shortest_path(forward, backward, ch, 0, 99);
+            printf("\n>>> 10 x 10 grid: %" PRIdEDGE " shortcuts; query 0 → 99:\n",
+                   ch->num_shortcuts);
+            if (sp != NULL) {
+                printf("  CH distance %d, settled %" PRIu64 " vertices, path has %"
+                       PRIdVERTEX " vertices\n", sp->distance, sp->stats.vertices_settled,
+                       sp->length);
+            }
+            free_shortest_path(sp);
+        }
+        free_workspace(forward);
+        free_workspace(backward);
+        free_contraction_hierarchy(ch);
+        free_csr_graph(csr);
+        free_graph(g);
+    }
+    
+    printf("\n>>> Verification:\n");
+    if (ch_correct) {
+        printf("  ✓ CH distances and unpacked paths match dijkstra_to() on all pairs!\n");
+    } else {
+        printf("  ❌ CH results differ from dijkstra_to()\n");
+    }
+    
+    /*
+     * TEST 12: Multi-source search (nearest depot)
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 12: Multi-Source Dijkstra (4 depots)         \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g12 = create_geometric_grid(10);
+    vertex_t depots[4] = { 0, 9, 90, 55 };
+    DijkstraResult *multi = (g12 != NULL) ? dijkstra_multi(g12, depots, 4) : NULL;
+    if (multi != NULL) {
+        printf("\n>>> Voronoi cells (letter = nearest depot, capital = the depot):\n\n");
+        for (vertex_t y = 9; y >= 0; y--) {
+            printf("  ");
+            for (vertex_t x = 0; x < 10; x++) {
+                vertex_t v = y * 10 + x;
+                int k = 0;
+                while (k < 4 && depots[k] != multi->owner[v]) k++;
+                printf(" %c", (k == 4) ? '?' : (char)((v == depots[k] ? 'A' : 'a') + k));
+            }
+            printf("\n");
+        }
+        
+        /* One pass must equal the minimum over four single-source runs */
+        bool correct = true;
+        DijkstraResult *single[4];
+        for (int k = 0; k < 4; k++) single[k] = dijkstra_heap(g12, depots[k]);
+        for (vertex_t v = 0; v < g12->num_vertices; v++) {
+            int best = INF;
+            int owned = INF;
+            for (int k = 0; k < 4; k++) {
+                if (single[k] == NULL) {
+                    correct = false;
+                    continue;
+                }
+                if (single[k]->distance[v] < best) best = single[k]->distance[v];
+                if (depots[k] == multi->owner[v]) owned = single[k]->distance[v];
+            }
+            if (multi->distance[v] != best || owned != best) correct = false;
+        }
+        for (int k = 0; k < 4; k++) free_result(single[k]);
+        
+        printf("\n>>> Path from the nearest depot to vertex 77: ");
+        print_path(multi, 77);
+        printf(" (distance %d)\n", multi->distance[77]);
+        
+        printf("\n>>> Verification:\n");
+        if (correct) {
+            printf("  ✓ One pass matches the minimum of 4 dijkstra_heap() runs!\n");
+            printf("  ✓ Every vertex's owner is a nearest depot!\n");
+        } else {
+            printf("  ❌ Multi-source distances or owners are wrong\n");
+        }
+    }
+    free_result(multi);
+    free_graph(g12);
+    
+    /*
+     * TEST 13: Batch queries on a thread pool
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 13: Batch Queries (3 worker threads)         \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g13 = create_geometric_grid(10);
+    CSRGraph *csr13 = (g13 != NULL) ? freeze_graph(g13) : NULL;
+    QueryPool *pool = (csr13 != NULL) ? create_query_pool(csr13, 3) : NULL;
+    vertex_t n13 = (csr13 != NULL) ? csr13->num_vertices : 0;
+    BatchQuery *queries = (BatchQuery *)malloc(((size_t)n13 * (size_t)n13 + 1) *
+                                               sizeof(BatchQuery));
+    int *distances = (int *)malloc(((size_t)n13 * (size_t)n13 + 1) * sizeof(int));
+    if (pool != NULL && queries != NULL && distances != NULL) {
+        bool correct = true;
+        BatchStats stats;
+        
+        /* All pairs as s-t queries */
+        for (vertex_t s = 0; s < n13; s++) {
+            for (vertex_t t = 0; t < n13; t++) {
+                queries[s * n13 + t].source = s;
+                queries[s * n13 + t].target = t;
+            }
+        }
+        if (!run_batch(pool, queries, (size_t)n13 * (size_t)n13, distances,
+                       NULL, NULL, &stats)) {
+            correct = false;
+        }
+        printf("\n>>> %" PRIu64 " s-t queries on %d threads, %" PRIu64 " steals\n",
+               stats.queries, query_pool_threads(pool), stats.steals);
+        
+        /* Full trees via the callback, one per source */
+        for (vertex_t s = 0; s < n13; s++) {
+            queries[s].source = s;
+            queries[s].target = -1;
+        }
+        TreeCheck check = { distances, n13, { 0, 0, 0, 0 } };
+        if (!run_batch(pool, queries, (size_t)n13, NULL, check_tree, &check, &stats)) {
+            correct = false;
+        }
+        printf(">>> %" PRIu64 " full searches, %" PRIu64 " vertices settled in total\n",
+               stats.queries, stats.work.vertices_settled);
+        
+        for (vertex_t s = 0; s < n13 && correct; s++) {
+            DijkstraResult *expected = dijkstra_heap(g13, s);
+            for (vertex_t t = 0; expected != NULL && t < n13; t++) {
+                if (distances[s * n13 + t] != expected->distance[t]) correct = false;
+            }
+            if (expected == NULL) correct = false;
+            free_result(expected);
+        }
+        
+        printf("\n>>> Verification:\n");
+        for (int w = 0; w < 4; w++) {
+            if (check.mismatches[w] != 0) correct = false;
+        }
+        if (correct) {
+            printf("  ✓ Batch distances match dijkstra_heap() for all pairs!\n");
+            printf("  ✓ Callbacks saw the same trees on every worker!\n");
+        } else {
+            printf("  ❌ Batch results differ from dijkstra_heap()\n");
+        }
+    }
+    free(queries);
+    free(distances);
+    free_query_pool(pool);
+    free_csr_graph(csr13);
+    free_graph(g13);
+    
+    /*
+     * TEST 14: All-pairs table with blocked Floyd–Warshall
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 14: All-Pairs Floyd–Warshall (tiled)         \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    bool apsp_correct = true;
+    for (int e = 0; e < 4; e++) {
+        /* 13 x 13 grid = 169 vertices: three tiles per row, with padding */
+        Graph *g = (e < 3) ? ch_examples[e]() : create_geometric_grid(13);
+        CSRGraph *csr = (g != NULL) ? freeze_graph(g) : NULL;
+        DistanceMatrix *m = (csr != NULL) ? floyd_warshall(csr, 2) : NULL;
+        if (m == NULL) apsp_correct = false;
+        
+        for (vertex_t s = 0; m != NULL && s < m->num_vertices; s++) {
+            DijkstraResult *expected = dijkstra_heap(g, s);
+            for (vertex_t t = 0; t < m->num_vertices; t++) {
+                ShortestPath *sp = apsp_path(m, s, t);
+                if (expected == NULL || sp == NULL ||
+                    sp->distance != expected->distance[t]) {
+                    apsp_correct = false;
+                } else if (sp->distance != INF) {
+                    /* Next hops must follow real edges adding up to the distance */
+                    int total = 0;
+                    for (vertex_t i = 0; i + 1 < sp->length; i++) {
+                        int w = INF;
+                        for (Edge *edge = g->adj_list[sp->vertices[i]]; edge != NULL;
+                             edge = edge->next) {
+                            if (edge->destination == sp->vertices[i + 1] && edge->weight < w) {
+                                w = edge->weight;
+                            }
+                        }
+                        if (w == INF) {
+                            apsp_correct = false;
+                            break;
+                        }
+                        total += w;
+                    }
+                    if (total != sp->distance || sp->vertices[sp->length - 1] != t) {
+                        apsp_correct = false;
+                    }
+                }
+                free_shortest_path(sp);
+            }
+            free_result(expected);
+        }
+        
+        if (e == 0 && m != NULL) {
+            printf("\n>>> Distance table of graph 1 (row = source):\n\n     ");
+            for (vertex_t t = 0; t < m->num_vertices; t++) printf("%4" PRIdVERTEX, t);
+            printf("\n");
+            for (vertex_t s = 0; s < m->num_vertices; s++) {
+                printf("  %" PRIdVERTEX ": ", s);
+                for (vertex_t t = 0; t < m->num_vertices; t++) {
+                    printf("%4d", apsp_distance(m, s, t));
+                }
+                printf("\n");
+            }
+        }
+        free_distance_matrix(m);
+        free_csr_graph(csr);
+        free_graph(g);
+    }
+    
+    printf("\n>>> Verification:\n");
+    if (apsp_correct) {
+        printf("  ✓ Matrix matches dijkstra_heap() from every source!\n");
+        printf("  ✓ Next-hop paths use real edges and add up to the distance!\n");
+    } else {
+        printf("  ❌ All-pairs table differs from dijkstra_heap()\n");
+    }
+    
+    /*
+     * TEST 15: Delta-stepping
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 15: Parallel Delta-Stepping                  \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g15 = create_geometric_grid(10);
+    CSRGraph *csr15 = (g15 != NULL) ? freeze_graph(g15) : NULL;
+    if (csr15 != NULL) {
+        /* Weights are 10..14: Δ = 1 is Dial, 12 splits light / heavy, 1000 all light */
+        static const int deltas[] = { 1, 12, 1000, 0 };
+        bool correct = true;
+        DijkstraResult *expected = dijkstra_heap(g15, 0);
+        
+        printf("\n>>> Source 0 on the 10 x 10 grid:\n\n");
+        printf("  %8s  %8s  %10s  %12s\n", "delta", "threads", "settled", "relaxations");
+        for (int d = 0; d < 4; d++) {
+            for (int threads = 1; threads <= 3; threads += 2) {
+                DijkstraResult *r = dijkstra_delta(csr15, 0, deltas[d], threads);
+                if (r == NULL || expected == NULL) {
+                    correct = false;
+                    free_result(r);
+                    continue;
+                }
+                for (vertex_t v = 0; v < csr15->num_vertices; v++) {
+                    vertex_t p = r->parent[v];
+                    if (r->distance[v] != expected->distance[v]) correct = false;
+                    
+                    /* Ties may pick another parent, but it must lie on a shortest path */
+                    if (v != 0 && p < 0) {
+                        correct = false;
+                    } else if (v != 0) {
+                        bool tight = false;
+                        for (edge_t e = csr15->offsets[p]; e < csr15->offsets[p + 1]; e++) {
+                            if (csr15->destinations[e] == v &&
+                                r->distance[p] + csr15->weights[e] == r->distance[v]) {
+                                tight = true;
+                            }
+                        }
+                        if (!tight) correct = false;
+                    }
+                }
+                if (deltas[d] > 0) {
+                    printf("  %8d", deltas[d]);
+                } else {
+                    printf("  %8s", "auto");
+                }
+                printf("  %8d  %10" PRIu64 "  %12" PRIu64 "\n", threads,
+                       r->stats.vertices_settled, r->stats.relaxations);
+                free_result(r);
+            }
+        }
+        
+        printf("\n>>> Verification:\n");
+        if (correct) {
+            printf("  ✓ Every delta and thread count matches dijkstra_heap()!\n");
+            printf("  ✓ Every parent edge lies on a shortest path!\n");
+        } else {
+            printf("  ❌ Delta-stepping differs from dijkstra_heap()\n");
+        }
+        free_result(expected);
+    }
+    free_csr_graph(csr15);
+    free_graph(g15);
+
+    /* 0 -> 1 -> 2 with weights 2*10^9: d(0, 2) passes INT_MAX and must stay INF */
+    Graph *long15 = create_graph(3);
+    for (vertex_t v = 0; long15 != NULL && v < 2; v++) add_edge(long15, v, v + 1, 2000000000);
+    CSRGraph *long_csr15 = (long15 != NULL) ? freeze_graph(long15) : NULL;
+    bool saturated = (long_csr15 != NULL);
+    for (int run = 0; saturated && run < 3; run++) {
+        /* Δ = 1000 (2 * 10^6 buckets, one thread), then the default Δ on 1 and 3 threads */
+        DijkstraResult *r = dijkstra_delta(long_csr15, 0, (run == 0) ? 1000 : 0, (run == 2) ? 3 : 1);
+        saturated = (r != NULL && r->distance[0] == 0 && r->distance[1] == 2000000000 &&
+                     r->distance[2] == INF);
+        free_result(r);
+    }
+    printf("\n>>> Chain of two edges of weight 2*10^9:\n");
+    if (saturated) {
+        printf("  ✓ d(0, 2) saturates at INF for every delta!\n");
+    } else {
+        printf("  ❌ Delta-stepping wrapped past INT_MAX\n");
+    }
+    free_csr_graph(long_csr15);
+    free_graph(long15);
+
+    /*
+     * TEST 16: Dense matrix mode of the array engine
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 16: Dense Weight Matrix (SIMD array engine)  \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* 150 vertices, every pair connected with weights 1..97 (plus graphs 1-3) */
+    bool dense_correct = true;
+    for (int e = 0; e < 4; e++) {
+        Graph *g = (e < 3) ? ch_examples[e]() : create_graph(150);
+        for (vertex_t u = 0; e == 3 && g != NULL && u < g->num_vertices; u++) {
+            for (vertex_t v = 0; v < g->num_vertices; v++) {
+                if (u != v) add_edge(g, u, v, 1 + (int)((u * 31 + v * 17) % 97));
+            }
+        }
+        if (g == NULL || !build_weight_matrix(g)) {
+            dense_correct = false;
+            free_graph(g);
+            continue;
+        }
+        
+        /* Growing the graph afterwards must keep the matrix in step */
+        if (e == 0) {
+            vertex_t x = add_vertex(g);
+            add_edge(g, 4, x, 1);
+            add_edge(g, x, 1, 0);
+        }
+        
+        for (vertex_t s = 0; s < g->num_vertices; s++) {
+            DijkstraResult *expected = dijkstra(g, s);
+            DijkstraResult *r = dijkstra_dense(g, s);
+            for (vertex_t v = 0; expected != NULL && r != NULL && v < g->num_vertices; v++) {
+                if (r->distance[v] != expected->distance[v] ||
+                    r->parent[v] != expected->parent[v]) {
+                    dense_correct = false;
+                }
+            }
+            if (expected == NULL || r == NULL) dense_correct = false;
+            
+            if (e == 3 && s == 0 && r != NULL && expected != NULL) {
+                printf("\n>>> Complete graph on 150 vertices, source 0:\n");
+                printf("\n>>> Linked lists:\n");
+                print_stats(&expected->stats);
+                printf("\n>>> Dense matrix (edges scanned = matrix entries):\n");
+                print_stats(&r->stats);
+            }
+            free_result(expected);
+            free_result(r);
+        }
+        free_graph(g);
+    }
+    
+    printf("\n>>> Verification:\n");
+    if (dense_correct) {
+        printf("  ✓ Dense mode matches dijkstra() distances and parents!\n");
+        printf("  ✓ Matrix stays current through add_vertex() / add_edge()!\n");
+    } else {
+        printf("  ❌ Dense mode differs from dijkstra()\n");
+    }
+    
+    /*
+     * TEST 17: Typed engines (other weight / distance types)
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 17: Typed Weights and Saturating Distances   \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    bool typed_correct = true;
+    for (int e = 0; e < 3; e++) {
+        Graph *g = ch_examples[e]();
+        CSRGraph *csr = (g != NULL) ? freeze_graph(g) : NULL;
+        CSRGraph_u16 *g16 = (csr != NULL) ? typed_graph_u16(csr, NULL) : NULL;
+        CSRGraph_u32 *g32 = (csr != NULL) ? typed_graph_u32(csr, NULL) : NULL;
+        CSRGraph_f32 *gf = (csr != NULL) ? typed_graph_f32(csr, NULL) : NULL;
+        if (g16 == NULL || g32 == NULL || gf == NULL) typed_correct = false;
+        
+        for (vertex_t s = 0; typed_correct && s < csr->num_vertices; s++) {
+            DijkstraResult *expected = dijkstra_heap_csr(csr, s);
+            DijkstraResult_u16 *r16 = dijkstra_heap_u16(g16, s);
+            DijkstraResult_u32 *r32 = dijkstra_heap_u32(g32, s);
+            DijkstraResult_f32 *rf = dijkstra_heap_f32(gf, s);
+            if (expected == NULL || r16 == NULL || r32 == NULL || rf == NULL) {
+                typed_correct = false;
+            }
+            for (vertex_t v = 0; typed_correct && v < csr->num_vertices; v++) {
+                int d = expected->distance[v];
+                bool reachable = (d != INF);
+                if ((reachable ? r16->distance[v] != (uint32_t)d : r16->distance[v] != INF_u16) ||
+                    (reachable ? r32->distance[v] != (uint64_t)d : r32->distance[v] != INF_u32) ||
+                    (reachable ? rf->distance[v] != (double)d : rf->distance[v] != INF_f32) ||
+                    r16->parent[v] != expected->parent[v] ||
+                    r32->parent[v] != expected->parent[v] ||
+                    rf->parent[v] != expected->parent[v]) {
+                    typed_correct = false;
+                }
+            }
+            free_result(expected);
+            free_result_u16(r16);
+            free_result_u32(r32);
+            free_result_f32(rf);
+        }
+        free_typed_graph_u16(g16);
+        free_typed_graph_u32(g32);
+        free_typed_graph_f32(gf);
+        free_csr_graph(csr);
+        free_graph(g);
+    }
+    
+    /* A chain 0 -> 1 -> 2 -> 3 of 10^9 weights: d(0, 3) = 3*10^9 > INT_MAX */
+    Graph *g17 = create_graph(4);
+    for (vertex_t v = 0; g17 != NULL && v < 3; v++) add_edge(g17, v, v + 1, 1000000000);
+    CSRGraph *csr17 = (g17 != NULL) ? freeze_graph(g17) : NULL;
+    
+    printf("\n>>> Chain of three edges of weight 10^9, d(0, 3) = 3*10^9:\n");
+    bool overflow_correct = false;
+    if (csr17 != NULL) {
+        DijkstraResult *r_int = dijkstra_heap_csr(csr17, 0);
+        CSRGraph_u32 *c32 = typed_graph_u32(csr17, NULL);
+        DijkstraResult_u32 *r32 = (c32 != NULL) ? dijkstra_heap_u32(c32, 0) : NULL;
+        if (r_int != NULL && r32 != NULL) {
+            printf("  int distances:      d(0, 3) = %s\n",
+                   (r_int->distance[3] == INF) ? "INF (saturated)" : "wrapped!");
+            printf("  uint64_t distances: d(0, 3) = %" PRIu64 "\n", r32->distance[3]);
+            overflow_correct = (r_int->distance[3] == INF && r_int->distance[2] == 2000000000 &&
+                                r32->distance[3] == 3000000000u);
+        }
+        
+        CSRGraph_u16 *c16 = typed_graph_u16(csr17, NULL);
+        printf("  uint16_t weights:   %s\n", (c16 == NULL) ? "rejected (10^9 does not fit)" : "accepted!");
+        if (c16 != NULL) overflow_correct = false;
+        free_typed_graph_u16(c16);
+        
+        free_result(r_int);
+        free_result_u32(r32);
+        free_typed_graph_u32(c32);
+    }
+    
+    /* Real-valued lengths on the same structure */
+    bool float_correct = false;
+    if (csr17 != NULL) {
+        const float lengths[3] = { 0.5f, 0.25f, 0.125f };
+        CSRGraph_f32 *cf = typed_graph_f32(csr17, lengths);
+        DijkstraResult_f32 *rf = (cf != NULL) ? dijkstra_heap_f32(cf, 1) : NULL;
+        if (rf != NULL) {
+            printf("  float weights 0.5, 0.25, 0.125 from 1: d(1, 3) = %g, d(1, 0) = %s\n",
+                   rf->distance[3], (rf->distance[0] == INF_f32) ? "inf" : "finite!");
+            float_correct = (rf->distance[3] == 0.375 && rf->distance[0] == INF_f32);
+        }
+        free_result_f32(rf);
+        free_typed_graph_f32(cf);
+    }
+    free_csr_graph(csr17);
+    free_graph(g17);
+
+    /*
+     * Every int engine on weights near INT_MAX, from every source:
+     *   0 -> 1 -> 2 (2*10^9 each) overflows; 0 -> 3 -> 2 (10^9 each) fits;
+     *   2 -> 4 overflows on any path; 3 -> 5 ends at INT_MAX - 1; 5 -> 0 closes a cycle.
+     */
+    static const int big_edges[][3] = {
+        { 0, 1, 2000000000 }, { 1, 2, 2000000000 }, { 0, 3, 1000000000 }, { 3, 2, 1000000000 },
+        { 2, 4, 2147483000 }, { 3, 5, 1147483646 }, { 5, 0, 3 }
+    };
+    Graph *big = create_graph(6);
+    for (int e = 0; big != NULL && e < 7; e++) {
+        add_edge(big, big_edges[e][0], big_edges[e][1], big_edges[e][2]);
+    }
+    CSRGraph *big_csr = (big != NULL) ? freeze_graph(big) : NULL;
+    bool big_ready = big_csr != NULL && build_reverse_graph(big_csr);
+    ContractionHierarchy *big_ch = big_ready ? build_contraction_hierarchy(big_csr, 1) : NULL;
+    LandmarkTable *big_landmarks = big_ready ? build_landmarks(big_csr, 2, LANDMARKS_FARTHEST, 1) : NULL;
+    DistanceMatrix *big_apsp = big_ready ? floyd_warshall(big_csr, 2) : NULL;
+    DijkstraWorkspace *big_forward = create_workspace(6);
+    DijkstraWorkspace *big_backward = create_workspace(6);
+    const Heuristic zero = { HEURISTIC_ZERO, 1.0, NULL, NULL };
+
+    bool engines_agree = big_ch != NULL && big_landmarks != NULL && big_apsp != NULL &&
+                         big_forward != NULL && big_backward != NULL;
+    for (vertex_t s = 0; engines_agree && s < 6; s++) {
+        DijkstraResult *ref = dijkstra_heap(big, s);
+        DijkstraResult *all[7] = {
+            dijkstra(big, s), dijkstra_dense(big, s), dijkstra_multi(big, &s, 1),
+            dijkstra_csr(big_csr, s), dijkstra_heap_csr(big_csr, s),
+            dijkstra_radix(big_csr, s), dijkstra_delta(big_csr, s, 0, 2)
+        };
+        engines_agree = ref != NULL && dijkstra_workspace(big_forward, big_csr, s);
+        for (vertex_t t = 0; engines_agree && t < 6; t++) {
+            int d = ref->distance[t];
+            for (int k = 0; k < 7; k++) {
+                if (all[k] == NULL || all[k]->distance[t] != d) engines_agree = false;
+            }
+            if (workspace_distance(big_forward, t) != d) engines_agree = false;
+            if (apsp_distance(big_apsp, s, t) != d) engines_agree = false;
+        }
+        for (vertex_t t = 0; engines_agree && t < 6; t++) {
+            int d = ref->distance[t];
+            ShortestPath *to = dijkstra_to(big, s, t);
+            ShortestPath *both = dijkstra_bidirectional(big_forward, big_backward, big_csr, s, t);
+            engines_agree = to != NULL && to->distance == d && both != NULL && both->distance == d &&
+                            ch_distance(big_forward, big_backward, big_ch, s, t) == d &&
+                            astar_search(big_forward, big_csr, s, t, &zero) &&
+                            workspace_distance(big_forward, t) == d &&
+                            alt_search(big_forward, big_csr, big_landmarks, s, t) &&
+                            workspace_distance(big_forward, t) == d;
+            free_shortest_path(to);
+            free_shortest_path(both);
+        }
+        /* Spot-check the reference itself: saturated, never wrapped */
+        if (s == 0 && engines_agree) {
+            engines_agree = ref->distance[2] == 2000000000 && ref->distance[4] == INF &&
+                            ref->distance[5] == INT_MAX - 1;
+        }
+        free_result(ref);
+        for (int k = 0; k < 7; k++) free_result(all[k]);
+    }
+    printf("\n>>> Every int engine on weights near INT_MAX (6 vertices, all pairs):\n");
+    printf("  engines: array, heap, dense, multi, csr, heap_csr, radix, delta, workspace,\n"
+           "           to, bidirectional, CH, A*, ALT, Floyd-Warshall\n");
+    free_distance_matrix(big_apsp);
+    free_workspace(big_forward);
+    free_workspace(big_backward);
+    free_landmarks(big_landmarks);
+    free_contraction_hierarchy(big_ch);
+    free_csr_graph(big_csr);
+    free_graph(big);
+
+    printf("\n>>> Verification:\n");
+    if (typed_correct) {
+        printf("  ✓ u16 / u32 / f32 engines match dijkstra_heap_csr()!\n");
+    } else {
+        printf("  ❌ Typed engines differ from dijkstra_heap_csr()\n");
+    }
+    if (overflow_correct) {
+        printf("  ✓ int distances saturate at INF, uint64_t holds the long path!\n");
+    } else {
+        printf("  ❌ Overflow handling is wrong\n");
+    }
+    if (float_correct) {
+        printf("  ✓ float weights accumulate in double distances!\n");
+    } else {
+        printf("  ❌ Float engine gave wrong distances\n");
+    }
+    if (engines_agree) {
+        printf("  ✓ Every int engine saturates at INF and agrees with dijkstra_heap()!\n");
+    } else {
+        printf("  ❌ An int engine wrapped or disagrees near INT_MAX\n");
+    }
+    
+    /*
+     * TEST 18: Bulk edge insertion into the edge arena
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 18: Edge Arena and Bulk add_edges()          \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* 3000 pseudo-random edges on 200 vertices, one by one and in batches */
+    enum { ARENA_EDGES = 3000 };
+    static vertex_t arena_src[ARENA_EDGES], arena_dst[ARENA_EDGES];
+    static int arena_w[ARENA_EDGES];
+    for (int i = 0; i < ARENA_EDGES; i++) {
+        arena_src[i] = (vertex_t)((i * 37) % 200);
+        arena_dst[i] = (vertex_t)((i * 91 + 7) % 200);
+        arena_w[i] = 1 + (i * 13) % 50;
+    }
+    
+    Graph *single = create_graph(200);
+    Graph *bulk = create_graph(200);
+    bool arena_correct = (single != NULL && bulk != NULL);
+    for (int i = 0; arena_correct && i < ARENA_EDGES; i++) {
+        add_edge(single, arena_src[i], arena_dst[i], arena_w[i]);
+    }
+    if (arena_correct) {
+        arena_correct = add_edges(bulk, arena_src, arena_dst, arena_w, 1) &&
+                        add_edges(bulk, arena_src + 1, arena_dst + 1, arena_w + 1, 999) &&
+                        add_edges(bulk, arena_src + 1000, arena_dst + 1000, arena_w + 1000, 2000) &&
+                        add_edges(bulk, NULL, NULL, NULL, 0);
+    }
+    
+    for (vertex_t v = 0; arena_correct && v < 200; v++) {
+        Edge *a = single->adj_list[v];
+        Edge *b = bulk->adj_list[v];
+        for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+            if (a->destination != b->destination || a->weight != b->weight) break;
+        }
+        if (a != NULL || b != NULL) arena_correct = false;
+    }
+    if (arena_correct) {
+        printf("\n>>> %d edges: add_edge() one at a time and add_edges() in 3 batches\n",
+               ARENA_EDGES);
+        printf("  Edges: %" PRIdEDGE " / %" PRIdEDGE "\n", single->num_edges, bulk->num_edges);
+        arena_correct = (single->num_edges == ARENA_EDGES && bulk->num_edges == ARENA_EDGES);
+    }
+    
+    /* A batch with one bad vertex id is rejected as a whole */
+    bool arena_atomic = false;
+    if (bulk != NULL) {
+        vertex_t bad_dst[3] = { 1, 2, 200 };
+        arena_atomic = !add_edges(bulk, arena_src, bad_dst, arena_w, 3) &&
+                       bulk->num_edges == ARENA_EDGES;
+    }
+    free_graph(single);
+    free_graph(bulk);
+    
+    printf("\n>>> Verification:\n");
+    if (arena_correct) {
+        printf("  ✓ add_edges() builds the same lists as add_edge()!\n");
+    } else {
+        printf("  ❌ add_edges() lists differ from add_edge()\n");
+    }
+    if (arena_atomic) {
+        printf("  ✓ Invalid batch rejected without adding any edge!\n");
+    } else {
+        printf("  ❌ Invalid batch was partially applied\n");
+    }
+    
+    /*
+     * TEST 19: Repairing a cached result after edge weight changes
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 19: Dynamic Updates and Tree Repair          \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* 300 vertices, 2400 pseudo-random edges kept by handle */
+    enum { DYN_VERTICES = 300, DYN_EDGES = 2400, DYN_ROUNDS = 40 };
+    static Edge *dyn_edge[DYN_EDGES];
+    static vertex_t dyn_src[DYN_EDGES];
+    uint64_t dyn_state = 12345;
+    Graph *g19 = create_graph(DYN_VERTICES);
+    for (int i = 0; g19 != NULL && i < DYN_EDGES; i++) {
+        dyn_src[i] = (vertex_t)(next_random(&dyn_state) % DYN_VERTICES);
+        vertex_t dest = (vertex_t)(next_random(&dyn_state) % DYN_VERTICES);
+        dyn_edge[i] = add_edge(g19, dyn_src[i], dest, 1 + next_random(&dyn_state) % 100);
+    }
+    DijkstraResult *cached = (g19 != NULL) ? dijkstra_heap(g19, 0) : NULL;
+    TreeRepair *repair = (g19 != NULL) ? create_tree_repair(g19) : NULL;
+    bool dyn_correct = (cached != NULL && repair != NULL);
+    bool removal_correct = dyn_correct;
+    uint64_t repair_scans = 0, full_scans = 0;
+    
+    for (int round = 0; dyn_correct && round < DYN_ROUNDS; round++) {
+        /* Up to 8 changes: remove, make heavier, or make lighter */
+        EdgeChange changes[8];
+        size_t k = 0;
+        for (int j = 0; j < 8; j++) {
+            int i = next_random(&dyn_state) % DYN_EDGES;
+            int w = dyn_edge[i]->weight;
+            if (w == INF) continue;
+            int action = next_random(&dyn_state) % 4;
+            bool applied = (action == 0) ? remove_edge(g19, dyn_src[i], dyn_edge[i]) :
+                           (action == 1) ? update_edge_weight(g19, dyn_src[i], dyn_edge[i], 3 * w + 10) :
+                                           update_edge_weight(g19, dyn_src[i], dyn_edge[i], w / 3);
+            if (!applied) removal_correct = false;
+            changes[k].source = dyn_src[i];
+            changes[k].edge = dyn_edge[i];
+            k++;
+        }
+        
+        DijkstraResult *fresh = dijkstra_heap(g19, 0);
+        if (fresh == NULL || !repair_result(repair, cached, changes, k)) {
+            dyn_correct = false;
+            free_result(fresh);
+            break;
+        }
+        repair_scans += cached->stats.edges_scanned;
+        full_scans += fresh->stats.edges_scanned;
+        
+        /* Same distances; every parent edge must carry its child's distance */
+        for (vertex_t v = 0; v < DYN_VERTICES; v++) {
+            if (cached->distance[v] != fresh->distance[v]) dyn_correct = false;
+            vertex_t p = cached->parent[v];
+            if (v == 0 || cached->distance[v] == INF) {
+                if (p != -1) dyn_correct = false;
+                continue;
+            }
+            bool tight = false;
+            for (Edge *edge = (p >= 0) ? g19->adj_list[p] : NULL; edge != NULL; edge = edge->next) {
+                if (edge->destination == v &&
+                    cached->distance[p] + edge->weight == cached->distance[v]) {
+                    tight = true;
+                }
+            }
+            if (!tight) dyn_correct = false;
+        }
+        free_result(fresh);
+    }
+    
+    /* Removed edges are gone from the lists and cannot be removed twice */
+    for (int i = 0; removal_correct && i < DYN_EDGES; i++) {
+        if (dyn_edge[i]->weight != INF) continue;
+        for (Edge *edge = g19->adj_list[dyn_src[i]]; edge != NULL; edge = edge->next) {
+            if (edge == dyn_edge[i]) removal_correct = false;
+        }
+        if (remove_edge(g19, dyn_src[i], dyn_edge[i])) removal_correct = false;
+    }
+    
+    /* Remove 1 -> 2, then add 0 -> 2: the edge count is back, the index is stale */
+    bool stale_refused = false;
+    Graph *tri = create_graph(3);
+    Edge *tri_12 = (tri != NULL) ? add_edge(tri, 1, 2, 1) : NULL;
+    if (tri_12 != NULL && add_edge(tri, 0, 1, 1) != NULL && add_edge(tri, 0, 2, 100) != NULL) {
+        DijkstraResult *tri_result = dijkstra_heap(tri, 0);
+        TreeRepair *tri_repair = create_tree_repair(tri);
+        Edge *tri_02 = NULL;
+        if (tri_result != NULL && tri_repair != NULL && remove_edge(tri, 1, tri_12)) {
+            tri_02 = add_edge(tri, 0, 2, 5);
+        }
+        EdgeChange tri_changes[2] = { { 1, tri_12 }, { 0, tri_02 } };
+        if (tri_02 != NULL && !repair_result(tri_repair, tri_result, tri_changes, 1)) {
+            /* A context built after the insertion sees both changes */
+            free_tree_repair(tri_repair);
+            tri_repair = create_tree_repair(tri);
+            stale_refused = repair_result(tri_repair, tri_result, tri_changes, 2) &&
+                            tri_result->distance[2] == 5 && tri_result->parent[2] == 0;
+        }
+        free_tree_repair(tri_repair);
+        free_result(tri_result);
+    }
+    free_graph(tri);
+    
+    /* INF is a weight, not the removed mark; a wrong source must not touch the matrix */
+    bool handles_correct = false;
+    Graph *pair = create_graph(3);
+    Edge *pair_01 = (pair != NULL) ? add_edge(pair, 0, 1, 7) : NULL;
+    if (pair_01 != NULL && build_weight_matrix(pair)) {
+        const int *row2 = &pair->matrix[2 * (size_t)pair->matrix_stride];
+        handles_correct = update_edge_weight(pair, 0, pair_01, INF) &&
+                          update_edge_weight(pair, 0, pair_01, 4) &&
+                          !update_edge_weight(pair, 2, pair_01, 3) && row2[1] == INF &&
+                          remove_edge(pair, 0, pair_01) &&
+                          !update_edge_weight(pair, 0, pair_01, 4) &&
+                          !remove_edge(pair, 0, pair_01) && pair->num_edges == 0;
+    }
+    free_graph(pair);
+    
+    if (dyn_correct) {
+        printf("\n>>> %d batches of up to 8 changes on %d edges:\n", DYN_ROUNDS, DYN_EDGES);
+        printf("  Edges scanned, full reruns:  %" PRIu64 "\n", full_scans);
+        printf("  Edges scanned, tree repairs: %" PRIu64 "\n", repair_scans);
+    }
+    free_tree_repair(repair);
+    free_result(cached);
+    free_graph(g19);
+    
+    printf("\n>>> Verification:\n");
+    if (dyn_correct) {
+        printf("  ✓ Repaired results match a full rerun after every batch!\n");
+    } else {
+        printf("  ❌ Repaired result differs from a full rerun\n");
+    }
+    if (removal_correct) {
+        printf("  ✓ remove_edge() unlinks edges, second removal refused!\n");
+    } else {
+        printf("  ❌ Edge updates / removals misbehaved\n");
+    }
+    if (handles_correct) {
+        printf("  ✓ INF weights stay updatable, wrong source refused with a matrix!\n");
+    } else {
+        printf("  ❌ Edge handle checks misbehaved\n");
+    }
+    if (stale_refused) {
+        printf("  ✓ Stale index refused after remove + add, rebuilt context repairs!\n");
+    } else {
+        printf("  ❌ Repair used an index that misses an added edge\n");
+    }
+    
+    /*
+     * TEST 20: Batch path extraction into caller buffers
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 20: Batch Path Extraction                    \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* Graphs 1-3 and a 30x30 grid; every vertex as destination, twice */
+    bool paths_correct = true;
+    for (int e = 0; e < 4; e++) {
+        Graph *g = (e < 3) ? ch_examples[e]() : create_geometric_grid(30);
+        CSRGraph *csr = (g != NULL) ? freeze_graph(g) : NULL;
+        DijkstraResult *r = (g != NULL) ? dijkstra_heap(g, 0) : NULL;
+        if (csr == NULL || r == NULL) {
+            paths_correct = false;
+            free_csr_graph(csr);
+            free_result(r);
+            free_graph(g);
+            continue;
+        }
+        
+        vertex_t n = g->num_vertices;
+        size_t count = 2 * (size_t)n;
+        vertex_t *targets = (vertex_t *)malloc(count * sizeof(vertex_t));
+        vertex_t *depth = (vertex_t *)malloc((size_t)n * sizeof(vertex_t));
+        edge_t *offsets = (edge_t *)malloc((count + 1) * sizeof(edge_t));
+        for (size_t i = 0; targets != NULL && i < count; i++) {
+            targets[i] = (vertex_t)((i * 7) % (size_t)n);
+        }
+        for (vertex_t v = 0; depth != NULL && v < n; v++) depth[v] = -1;
+        
+        edge_t total = (targets != NULL && depth != NULL && offsets != NULL)
+                     ? measure_paths(r, targets, count, depth, offsets) : -1;
+        vertex_t *vertices = (total >= 0) ? (vertex_t *)malloc(((size_t)total + 1) * sizeof(vertex_t)) : NULL;
+        edge_t *edge_ids = (total >= 0) ? (edge_t *)malloc(((size_t)total + 1) * sizeof(edge_t)) : NULL;
+        int *cumulative = (total >= 0) ? (int *)malloc(((size_t)total + 1) * sizeof(int)) : NULL;
+        if (vertices == NULL || edge_ids == NULL || cumulative == NULL ||
+            !extract_paths(r, csr, targets, count, depth, offsets, vertices, edge_ids, cumulative)) {
+            paths_correct = false;
+        }
+        
+        for (size_t i = 0; paths_correct && i < count; i++) {
+            vertex_t length;
+            vertex_t *expected = get_path(r, targets[i], &length);
+            if (offsets[i + 1] - offsets[i] != (edge_t)length) paths_correct = false;
+            for (vertex_t k = 0; paths_correct && k < length; k++) {
+                edge_t j = offsets[i] + k;
+                vertex_t v = vertices[j];
+                edge_t id = edge_ids[j];
+                if (v != expected[k] || cumulative[j] != r->distance[v]) paths_correct = false;
+                if (k == 0) {
+                    if (id != -1) paths_correct = false;
+                } else if (id < csr->offsets[vertices[j - 1]] || id >= csr->offsets[vertices[j - 1] + 1] ||
+                           csr->destinations[id] != v ||
+                           cumulative[j - 1] + csr->weights[id] != cumulative[j]) {
+                    paths_correct = false;
+                }
+            }
+            free(expected);
+        }
+        
+        if (e == 3 && paths_correct) {
+            printf("\n>>> 30x30 grid, %zu destinations: %" PRIdEDGE " path entries\n", count, total);
+            printf("  Path to %" PRIdVERTEX ": ", targets[1]);
+            for (edge_t j = offsets[1]; j < offsets[2]; j++) {
+                printf("%s%" PRIdVERTEX, (j > offsets[1]) ? " → " : "", vertices[j]);
+            }
+            printf("\n  Cumulative:  ");
+            for (edge_t j = offsets[1]; j < offsets[2]; j++) {
+                printf("%s%d", (j > offsets[1]) ? ", " : "", cumulative[j]);
+            }
+            printf("\n");
+        }
+        
+        free(targets);
+        free(depth);
+        free(offsets);
+        free(vertices);
+        free(edge_ids);
+        free(cumulative);
+        free_result(r);
+        free_csr_graph(csr);
+        free_graph(g);
+    }
+    
+    /* A 200000-hop chain: far deeper than any recursion could go */
+    const vertex_t chain = 200000;
+    bool deep_correct = false;
+    Graph *g20 = create_graph(chain);
+    for (vertex_t v = 0; g20 != NULL && v + 1 < chain; v++) add_edge(g20, v, v + 1, 1);
+    DijkstraResult *r20 = (g20 != NULL) ? dijkstra_heap(g20, 0) : NULL;
+    vertex_t *depth20 = (vertex_t *)malloc((size_t)chain * sizeof(vertex_t));
+    vertex_t *path20 = (vertex_t *)malloc((size_t)chain * sizeof(vertex_t));
+    if (r20 != NULL && depth20 != NULL && path20 != NULL) {
+        for (vertex_t v = 0; v < chain; v++) depth20[v] = -1;
+        vertex_t last = chain - 1;
+        edge_t offsets20[2];
+        deep_correct = measure_paths(r20, &last, 1, depth20, offsets20) == chain &&
+                       extract_paths(r20, NULL, &last, 1, depth20, offsets20, path20, NULL, NULL) &&
+                       path20[0] == 0 && path20[chain - 1] == last;
+    }
+    free(depth20);
+    free(path20);
+    free_result(r20);
+    free_graph(g20);
+    
+    printf("\n>>> Verification:\n");
+    if (paths_correct) {
+        printf("  ✓ Vertices, edge ids and distances match get_path()!\n");
+    } else {
+        printf("  ❌ Batch paths differ from get_path()\n");
+    }
+    if (deep_correct) {
+        printf("  ✓ %" PRIdVERTEX "-vertex path extracted iteratively!\n", chain);
+    } else {
+        printf("  ❌ Deep path extraction failed\n");
+    }
+    
+    /*
+     * TEST 21: Deterministic graph generators
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 21: Graph Generators                         \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    GraphSpec specs[] = {
+        grid_spec(12, 9, 1, 100, 7),
+        grid_spec(6, 5, 4, 100, 7),
+        geometric_spec(600, 2.0, 50, 7),
+        rmat_spec(10, 8000, 100, 7),
+        erdos_renyi_spec(700, 5000, 100, 7)
+    };
+    const char *spec_names[] = { "grid 12x9", "grid 6x5x4", "geometric", "R-MAT", "G(n, m)" };
+    bool same_seed = true, structure = true, file_matches = true;
+    
+    printf("\n>>> Generated graphs (seed 7):\n");
+    for (int k = 0; k < 5; k++) {
+        CSRGraph *a = generate_graph(&specs[k]);
+        CSRGraph *b = generate_graph(&specs[k]);
+        GraphSpec reseeded = specs[k];
+        reseeded.seed = 8;
+        CSRGraph *c = generate_graph(&reseeded);
+        if (a == NULL || b == NULL || c == NULL) {
+            same_seed = false;
+            free_csr_graph(a);
+            free_csr_graph(b);
+            free_csr_graph(c);
+            continue;
+        }
+        vertex_t n = a->num_vertices;
+        edge_t m = a->num_edges;
+        printf("  %-11s %5" PRIdVERTEX " vertices, %5" PRIdEDGE " edges\n", spec_names[k], n, m);
+        
+        /* Same seed: identical arrays; another seed: different weights */
+        if (b->num_edges != m ||
+            memcmp(a->offsets, b->offsets, ((size_t)n + 1) * sizeof(edge_t)) != 0 ||
+            memcmp(a->destinations, b->destinations, (size_t)m * sizeof(vertex_t)) != 0 ||
+            memcmp(a->weights, b->weights, (size_t)m * sizeof(int)) != 0 ||
+            (c->num_edges == m && memcmp(a->weights, c->weights, (size_t)m * sizeof(int)) == 0)) {
+            same_seed = false;
+        }
+        
+        /* Weights in range; grids and geometric graphs are symmetric */
+        for (vertex_t u = 0; u < n; u++) {
+            for (edge_t i = a->offsets[u]; i < a->offsets[u + 1]; i++) {
+                vertex_t v = a->destinations[i];
+                if (v < 0 || v >= n || a->weights[i] < specs[k].min_weight ||
+                    a->weights[i] > specs[k].max_weight) {
+                    structure = false;
+                }
+                if (k > 2) continue;
+                bool back = false;
+                for (edge_t j = a->offsets[v]; j < a->offsets[v + 1]; j++) {
+                    if (a->destinations[j] == u && a->weights[j] == a->weights[i]) back = true;
+                }
+                if (!back) structure = false;
+            }
+        }
+        
+        if (k == 0 && (m != 2 * (11 * 9 + 12 * 8) || a->coords == NULL)) structure = false;
+        if (k == 1 && m != 2 * (5 * 5 * 4 + 6 * 4 * 4 + 6 * 5 * 3)) structure = false;
+        if (k >= 3 && m != specs[k].num_edges) structure = false;
+        if (k == 3 && n != 1024) structure = false;
+        if (k == 2) {
+            /* Every pair closer than the radius is joined, and no other */
+            edge_t pairs = 0;
+            for (vertex_t u = 0; u < n; u++) {
+                for (vertex_t v = 0; v < n; v++) {
+                    double dx = a->coords[u].x - a->coords[v].x;
+                    double dy = a->coords[u].y - a->coords[v].y;
+                    if (u != v && dx * dx + dy * dy <= 4.0) pairs++;
+                }
+            }
+            if (pairs != m) structure = false;
+        }
+        for (vertex_t u = 0; k == 4 && u < n; u++) {
+            for (edge_t i = a->offsets[u]; i < a->offsets[u + 1]; i++) {
+                if (a->destinations[i] == u) structure = false;
+            }
+        }
+        
+        /* Streamed through a 64-byte buffer: many slices, same file */
+        char path[] = "/tmp/dijkstra_generatedXXXXXX";
+        int fd = mkstemp(path);
+        CSRGraph *mapped = NULL;
+        if (fd >= 0 && generate_graph_file(&specs[k], path, 64)) {
+            mapped = map_csr_graph(path);
+        }
+        if (mapped == NULL || mapped->num_vertices != n || mapped->num_edges != m ||
+            memcmp(mapped->offsets, a->offsets, ((size_t)n + 1) * sizeof(edge_t)) != 0 ||
+            memcmp(mapped->destinations, a->destinations, (size_t)m * sizeof(vertex_t)) != 0 ||
+            memcmp(mapped->weights, a->weights, (size_t)m * sizeof(int)) != 0) {
+            file_matches = false;
+        }
+        free_csr_graph(mapped);
+        if (fd >= 0) {
+            close(fd);
+            remove(path);
+        }
+        
+        free_csr_graph(a);
+        free_csr_graph(b);
+        free_csr_graph(c);
+    }
+    
+    printf("\n>>> Verification:\n");
+    if (same_seed) {
+        printf("  ✓ Same seed, same graph; another seed, other weights!\n");
+    } else {
+        printf("  ❌ Generators are not reproducible\n");
+    }
+    if (structure) {
+        printf("  ✓ Edge counts, weight ranges and symmetry as specified!\n");
+    } else {
+        printf("  ❌ Generated graphs do not match their spec\n");
+    }
+    if (file_matches) {
+        printf("  ✓ Streamed graph files map back identical!\n");
+    } else {
+        printf("  ❌ Streamed graph file differs from generate_graph()\n");
+    }
+    
+    /*
+     * TEST 22: Hardware performance counters around an engine call
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 22: Hardware Performance Counters            \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    Graph *g22 = create_geometric_grid(60);
+    PerfCounters *pc = create_perf_counters();
+    PerfSample sample;
+    DijkstraResult *plain = (g22 != NULL) ? dijkstra_heap(g22, 0) : NULL;
+    DijkstraResult *measured = NULL;
+    PERF_MEASURE(pc, &sample, measured = (g22 != NULL) ? dijkstra_heap(g22, 0) : NULL);
+    
+    /* A NULL handle (creation failed) must still run the call */
+    DijkstraResult *unmeasured = NULL;
+    PerfSample empty;
+    PERF_MEASURE(NULL, &empty, unmeasured = (g22 != NULL) ? dijkstra_heap(g22, 0) : NULL);
+    
+    bool same_result = plain != NULL && measured != NULL && unmeasured != NULL &&
+                       memcmp(plain->distance, measured->distance,
+                              (size_t)plain->num_vertices * sizeof(int)) == 0 &&
+                       memcmp(plain->distance, unmeasured->distance,
+                              (size_t)plain->num_vertices * sizeof(int)) == 0;
+    bool counts_sane = !empty.valid[COUNTER_CYCLES] && !empty.valid[COUNTER_PAGE_FAULTS];
+    if (sample.valid[COUNTER_CYCLES] && sample.value[COUNTER_CYCLES] == 0) counts_sane = false;
+    if (sample.valid[COUNTER_INSTRUCTIONS] &&
+        (measured == NULL || sample.value[COUNTER_INSTRUCTIONS] < measured->stats.edges_scanned)) {
+        counts_sane = false;
+    }
+    
+    int available = perf_counters_available(pc);
+    printf("\n>>> dijkstra_heap() on a 60x60 grid, %d of %d counters available\n",
+           available, (int)NUM_PERF_COUNTERS);
+    if (perf_counters_error(pc) != NULL) {
+        printf("  (others: %s)\n", perf_counters_error(pc));
+    }
+    if (measured != NULL) {
+        print_perf_sample(&sample, &measured->stats);
+    }
+    
+    printf("\n>>> Verification:\n");
+    if (same_result) {
+        printf("  ✓ Measured and unmeasured runs give the same distances!\n");
+    } else {
+        printf("  ❌ PERF_MEASURE() changed the result\n");
+    }
+    if (counts_sane) {
+        printf("  ✓ Counters are plausible, missing ones reported as n/a!\n");
+    } else {
+        printf("  ❌ Implausible counter values\n");
+    }
+    free_result(plain);
+    free_result(measured);
+    free_result(unmeasured);
+    free_perf_counters(pc);
+    free_graph(g22);
+    
+    /*
+     * TEST 23: Binary graph files
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 23: Binary Graph Files (save / map)          \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* A 20x20 grid saved and mapped back, then corrupted one entry at a time */
+    Graph *g23 = create_geometric_grid(20);
+    CSRGraph *csr23 = (g23 != NULL) ? freeze_graph(g23) : NULL;
+    char file23[] = "/tmp/dijkstra_fileXXXXXX";
+    int fd23 = mkstemp(file23);
+    bool round_trip = false;
+    bool corrupt_rejected = false;
+    if (csr23 != NULL && fd23 >= 0 && save_csr_graph(csr23, file23)) {
+        vertex_t n = csr23->num_vertices;
+        edge_t m = csr23->num_edges;
+        CSRGraph *mapped = map_csr_graph(file23);
+        round_trip = mapped != NULL && mapped->num_vertices == n && mapped->num_edges == m &&
+                     memcmp(mapped->offsets, csr23->offsets, ((size_t)n + 1) * sizeof(edge_t)) == 0 &&
+                     memcmp(mapped->destinations, csr23->destinations, (size_t)m * sizeof(vertex_t)) == 0 &&
+                     memcmp(mapped->weights, csr23->weights, (size_t)m * sizeof(int)) == 0;
+        DijkstraResult *from_file = round_trip ? dijkstra_heap_csr(mapped, 0) : NULL;
+        DijkstraResult *from_memory = dijkstra_heap_csr(csr23, 0);
+        round_trip = from_file != NULL && from_memory != NULL &&
+                     memcmp(from_file->distance, from_memory->distance, (size_t)n * sizeof(int)) == 0;
+        free_result(from_file);
+        free_result(from_memory);
+        
+        /* File positions of a destination and an offset in the middle */
+        off_t dest_pos = 0, offset_pos = 0;
+        if (round_trip) {
+            const char *base = (const char *)mapped->mapping;
+            dest_pos = (off_t)((const char *)&mapped->destinations[m / 2] - base);
+            offset_pos = (off_t)((const char *)&mapped->offsets[n / 2] - base);
+        }
+        free_csr_graph(mapped);
+        
+        /* A destination past the last vertex: rejected unless trusted */
+        vertex_t bad_dest = n;
+        edge_t bad_offset = m;
+        corrupt_rejected = round_trip &&
+            pwrite(fd23, &bad_dest, sizeof(bad_dest), dest_pos) == (ssize_t)sizeof(bad_dest);
+        CSRGraph *bad = corrupt_rejected ? map_csr_graph(file23) : NULL;
+        CSRGraph *trusted = corrupt_rejected ? map_csr_graph_trusted(file23) : NULL;
+        if (bad != NULL || trusted == NULL) corrupt_rejected = false;
+        free_csr_graph(bad);
+        free_csr_graph(trusted);
+        
+        /* The destination restored, then an offset that goes backwards */
+        vertex_t good_dest = csr23->destinations[m / 2];
+        corrupt_rejected = corrupt_rejected &&
+            pwrite(fd23, &good_dest, sizeof(good_dest), dest_pos) == (ssize_t)sizeof(good_dest) &&
+            pwrite(fd23, &bad_offset, sizeof(bad_offset), offset_pos) == (ssize_t)sizeof(bad_offset);
+        bad = corrupt_rejected ? map_csr_graph(file23) : NULL;
+        if (bad != NULL) corrupt_rejected = false;
+        free_csr_graph(bad);
+        
+        /* Cut off inside the destinations */
+        corrupt_rejected = corrupt_rejected && ftruncate(fd23, dest_pos) == 0;
+        bad = corrupt_rejected ? map_csr_graph_trusted(file23) : NULL;
+        if (bad != NULL) corrupt_rejected = false;
+        free_csr_graph(bad);
+    }
+    if (fd23 >= 0) {
+        close(fd23);
+        remove(file23);
+    }
+    free_csr_graph(csr23);
+    free_graph(g23);
+    
+    printf("\n>>> Verification:\n");
+    if (round_trip) {
+        printf("  ✓ save_csr_graph() -> map_csr_graph() gives the same arrays and distances!\n");
+    } else {
+        printf("  ❌ Mapped graph differs from the saved one\n");
+    }
+    if (corrupt_rejected) {
+        printf("  ✓ Bad destination, decreasing offset and truncation rejected!\n");
+    } else {
+        printf("  ❌ A corrupt graph file was accepted\n");
+    }
+    
+    /*
+     * TEST 24: Text graph loaders
+     */
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("         TEST 24: DIMACS and Edge-List Loaders             \n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    
+    /* The same 4-vertex graph with comments, CRLF, a blank line and no final newline */
+    static const char dimacs24[] =
+        "c 4 vertices, 5 arcs\r\np sp 4 5\r\nc arcs follow\r\na 1 2 3\r\na 2 3 4\r\n\r\n"
+        "a 3 4 5\r\na 4 1 6\r\na 1 3 10";
+    static const char edges24[] =
+        "# 4 vertices\n% 5 edges\n0 1 3\n1 2 4\r\n\n  2 3 5\n3 0\t6\n0 2 10";
+    static const int expected24[4] = { 0, 3, 7, 12 };
+    static const int thread_counts24[3] = { 1, 3, 64 };
+    bool formats_correct = true;
+    for (int k = 0; k < 6; k++) {
+        bool dimacs = (k < 3);
+        const char *text = dimacs ? dimacs24 : edges24;
+        CSRGraph *g = load_text_graph(text, strlen(text),
+                                      dimacs ? GRAPH_FORMAT_DIMACS : GRAPH_FORMAT_EDGE_LIST,
+                                      thread_counts24[k % 3]);
+        DijkstraResult *r = (g != NULL) ? dijkstra_heap_csr(g, 0) : NULL;
+        if (r == NULL || g->num_vertices != 4 || g->num_edges != 5 ||
+            memcmp(r->distance, expected24, sizeof(expected24)) != 0) {
+            formats_correct = false;
+        }
+        free_result(r);
+        free_csr_graph(g);
+    }
+    
+    /*
+     * Malformed lines are skipped, never reinterpreted: fractions, words,
+     * extra fields, unknown line kinds, arcs outside "p sp 2 1", a late "p"
+     */
+    static const char bad_dimacs24[] =
+        "p sp 2 1\na 1 5 3\na 1 2 2.9\na 2 1 abc\na 1 2 7 8\nx 1 2\na 1 2 4\np sp 9 9\n";
+    static const char bad_edges24[] =
+        "0 1 2.9\n1 2 abc\n0 2 5 x\n2x 0\n0 1\n1 2 3\n";
+    CSRGraph *bad_d = load_text_graph(bad_dimacs24, strlen(bad_dimacs24), GRAPH_FORMAT_DIMACS, 2);
+    CSRGraph *bad_e = load_text_graph(bad_edges24, strlen(bad_edges24), GRAPH_FORMAT_EDGE_LIST, 2);
+    bool malformed_skipped =
+        bad_d != NULL && bad_d->num_vertices == 2 && bad_d->num_edges == 1 &&
+        bad_d->destinations[0] == 1 && bad_d->weights[0] == 4 &&
+        bad_e != NULL && bad_e->num_vertices == 3 && bad_e->num_edges == 2 &&
+        bad_e->offsets[1] == 1 && bad_e->weights[0] == 1 && bad_e->weights[1] == 3;
+    free_csr_graph(bad_d);
+    free_csr_graph(bad_e);
+    
+    /* 20000 random edges, every other line CRLF: many lines per slice on 1-64 threads */
+    enum { TEXT_VERTICES = 2000, TEXT_EDGES = 20000 };
+    char *big_text = (char *)malloc((size_t)TEXT_EDGES * 32);
+    Graph *direct = create_graph(TEXT_VERTICES);
+    size_t big_length = 0;
+    uint64_t text_state = 777;
+    for (int i = 0; big_text != NULL && direct != NULL && i < TEXT_EDGES; i++) {
+        int u = next_random(&text_state) % TEXT_VERTICES;
+        int v = next_random(&text_state) % TEXT_VERTICES;
+        int w = 1 + next_random(&text_state) % 1000;
+        add_edge(direct, u, v, w);
+        big_length += (size_t)sprintf(big_text + big_length, "%d %d %d%s", u, v, w,
+                                      (i == TEXT_EDGES - 1) ? "" : (i % 2) ? "\r\n" : "\n");
+    }
+    CSRGraph *direct_csr = (direct != NULL) ? freeze_graph(direct) : NULL;
+    bool slices_correct = (big_text != NULL && direct_csr != NULL);
+    for (int k = 0; slices_correct && k < 3; k++) {
+        CSRGraph *loaded = load_text_graph(big_text, big_length, GRAPH_FORMAT_EDGE_LIST,
+                                           thread_counts24[k]);
+        slices_correct = loaded != NULL && loaded->num_edges == TEXT_EDGES &&
+                         same_distances(loaded, direct_csr, 0) &&
+                         same_distances(loaded, direct_csr, TEXT_VERTICES / 2);
+        free_csr_graph(loaded);
+    }
+    free(big_text);
+    free_csr_graph(direct_csr);
+    free_graph(direct);
+    
+    printf("\n>>> Verification:\n");
+    if (formats_correct) {
+        printf("  ✓ DIMACS and edge lists load the same graph on 1, 3 and 64 threads!\n");
+    } else {
+        printf("  ❌ Comments, CRLF or a missing final newline broke a loader\n");
+    }
+    if (malformed_skipped) {
+        printf("  ✓ Malformed lines and arcs outside the \"p\" line are skipped!\n");
+    } else {
+        printf("  ❌ Malformed input was turned into edges\n");
+    }
+    if (slices_correct) {
+        printf("  ✓ 20000-line file matches add_edge() on every thread count!\n");
+    } else {
+        printf("  ❌ Loading across slices lost or changed edges\n");
+    }
+}
+
+/*
+ * print_complexity_analysis - Educational output about algorithm complexity
+ */
+void print_complexity_analysis(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════╗\n");
+    printf("║            COMPLEXITY ANALYSIS                           ║\n");
+    printf("╠══════════════════════════════════════════════════════════╣\n");
+    printf("║                                                          ║\n");
+    printf("║  Implementation  │ EXTRACT-MIN │ DECREASE-KEY │ Total    ║\n");
+    printf("║  ───────────────┼─────────────┼──────────────┼───────── ║\n");
+    printf("║  Array          │    O(V)     │     O(1)     │ O(V²)    ║\n");
+    printf("║  Binary Heap    │  O(log V)   │   O(log V)   │O((V+E)lgV)║\n");
+    printf("║  Fibonacci Heap │  O(log V)*  │     O(1)*    │O(VlgV+E) ║\n");
+    printf("║                                                          ║\n");
+    printf("║  * amortized                                             ║\n");
+    printf("║                                                          ║\n");
+    printf("║  When to use which:                                      ║\n");
+    printf("║  • Dense graphs (E ≈ V²): Array is simpler, same O(V²)  ║\n");
+    printf("║  • Sparse graphs (E ≈ V): Heap gives O(V log V)         ║\n");
+    printf("║                                                          ║\n");
+    printf("╚══════════════════════════════════════════════════════════╝\n");
+}
+
+/*
+ * print_usage - Shows how to use this program
+ */
+void print_usage(void) {
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════╗\n");
+    printf("║                    USAGE                                 ║\n");
+    printf("╠══════════════════════════════════════════════════════════╣\n");
+    printf("║                                                          ║\n");
+    printf("║  Compile:  make                                          ║\n");
+    printf("║                                                          ║\n");
+    printf("║  Run:      ./dijkstra                  (demonstration)   ║\n");
+    printf("║            ./dijkstra GRAPH [SOURCE]   (query a file)    ║\n");
+    printf("║            ./dijkstra GRAPH SOURCE TARGET (one route)    ║\n");
+    printf("║            ./dijkstra --convert GRAPH OUT.bin            ║\n");
+    printf("║            ./dijkstra --generate FAM SCALE SEED OUT.bin  ║\n");
+    printf("║                                                          ║\n");
+    printf("║  GRAPH is a DIMACS .gr file, a \"u v [w]\" edge list,      ║\n");
+    printf("║  or a binary graph file written by --convert.            ║\n");
+    printf("║                                                          ║\n");
+    printf("║  FAM is grid, grid3d, geometric, rmat or gnm, with       ║\n");
+    printf("║  about 2^SCALE vertices (average degree 8 for the        ║\n");
+    printf("║  last three).                                            ║\n");
+    printf("║                                                          ║\n");
+    printf("╚══════════════════════════════════════════════════════════╝\n");
+}
+
+/*
+ * elapsed_ms - Milliseconds between two CLOCK_MONOTONIC readings
+ */
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+/*
+ * run_point_to_point - Answers one source → target query on a loaded graph
+ * 
+ * Return: Process exit status
+ */
+int run_point_to_point(const CSRGraph *g, vertex_t source, vertex_t target) {
+    struct timespec t0, t1;
+    
+    DijkstraWorkspace *ws = create_workspace(g->num_vertices);
+    if (ws == NULL) return EXIT_FAILURE;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    ShortestPath *sp = NULL;
+    if (dijkstra_workspace_to(ws, g, source, target)) {
+        sp = workspace_path(ws, target);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free_workspace(ws);
+    if (sp == NULL) return EXIT_FAILURE;
+    
+    printf("Query %" PRIdVERTEX " → %" PRIdVERTEX " (%.3f ms)\n",
+           source, target, elapsed_ms(t0, t1));
+    if (sp->length <= 50) {
+        print_shortest_path(sp);
+    } else {
+        printf("  distance %d, %" PRIdVERTEX " vertices on path\n", sp->distance, sp->length);
+    }
+    print_stats(&sp->stats);
+    
+    free_shortest_path(sp);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * run_graph_file - Loads a graph file and runs Dijkstra from one source
+ * 
+ * @path:   Graph file (DIMACS .gr, edge list, or binary graph file)
+ * @source: Source vertex (0-based)
+ * @target: Destination vertex, or -1 for the full shortest-path tree
+ * 
+ * Return: Process exit status
+ */
+int run_graph_file(const char *path, vertex_t source, vertex_t target) {
+    struct timespec t0, t1, t2;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    CSRGraph *g = load_graph(path, GRAPH_FORMAT_AUTO, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (g == NULL) return EXIT_FAILURE;
+    
+    printf("Loaded '%s': %" PRIdVERTEX " vertices, %" PRIdEDGE " edges (%.1f ms)\n",
+           path, g->num_vertices, g->num_edges, elapsed_ms(t0, t1));
+    
+    if (target >= 0) {
+        int status = run_point_to_point(g, source, target);
+        free_csr_graph(g);
+        return status;
+    }
+    
+    PerfCounters *pc = create_perf_counters();
+    PerfSample sample;
+    DijkstraResult *result = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    PERF_MEASURE(pc, &sample, result = dijkstra_heap_csr(g, source));
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    if (result == NULL) {
+        free_perf_counters(pc);
+        free_csr_graph(g);
+        return EXIT_FAILURE;
+    }
+    
+    vertex_t reached = 0;
+    vertex_t farthest = source;
+    for (vertex_t v = 0; v < result->num_vertices; v++) {
+        if (result->distance[v] == INF) continue;
+        reached++;
+        if (result->distance[v] > result->distance[farthest]) farthest = v;
+    }
+    
+    printf("Dijkstra from %" PRIdVERTEX ": %" PRIdVERTEX " vertices reached (%.1f ms)\n",
+           source, reached, elapsed_ms(t1, t2));
+    printf("Farthest vertex: %" PRIdVERTEX " at distance %d\n",
+           farthest, result->distance[farthest]);
+    print_stats(&result->stats);
+    if (perf_counters_available(pc) > 0) {
+        print_perf_sample(&sample, &result->stats);
+    }
+    if (perf_counters_error(pc) != NULL) {
+        printf("Some hardware counters unavailable: %s\n", perf_counters_error(pc));
+    }
+    free_perf_counters(pc);
+    
+    if (result->num_vertices <= 20) {
+        print_result(result);
+    }
+    
+    free_result(result);
+    free_csr_graph(g);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * convert_graph_file - Converts a text graph into a binary graph file
+ * 
+ * Return: Process exit status
+ */
+int convert_graph_file(const char *input, const char *output) {
+    struct timespec t0, t1;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    CSRGraph *g = load_graph(input, GRAPH_FORMAT_AUTO, 0);
+    if (g == NULL) return EXIT_FAILURE;
+    
+    bool ok = save_csr_graph(g, output);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    
+    if (ok) {
+        printf("Wrote '%s': %" PRIdVERTEX " vertices, %" PRIdEDGE " edges (%.1f ms)\n",
+               output, g->num_vertices, g->num_edges, elapsed_ms(t0, t1));
+    }
+    free_csr_graph(g);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ * generate_graph_command - Writes a generated graph to a binary graph file
+ * 
+ * @family: grid, grid3d, geometric, rmat or gnm
+ * @scale:  About 2^scale vertices
+ * @seed:   Generator seed
+ * @output: Output file
+ * 
+ * Return: Process exit status
+ */
+int generate_graph_command(const char *family, int scale, uint64_t seed, const char *output) {
+    struct timespec t0, t1;
+    vertex_t n = (vertex_t)1 << scale;
+    vertex_t side = (vertex_t)1 << (scale / 2);
+    vertex_t cube = (vertex_t)1 << (scale / 3);
+    GraphSpec spec;
+    
+    if (strcmp(family, "grid") == 0) {
+        spec = grid_spec(n / side, side, 1, 100, seed);
+    } else if (strcmp(family, "grid3d") == 0) {
+        spec = grid_spec(n / (cube * cube), cube, cube, 100, seed);
+    } else if (strcmp(family, "geometric") == 0) {
+        spec = geometric_spec(n, sqrt(8.0 / 3.14159265358979), 100, seed);
+    } else if (strcmp(family, "rmat") == 0) {
+        spec = rmat_spec(scale, 8 * (edge_t)n, 100, seed);
+    } else if (strcmp(family, "gnm") == 0) {
+        spec = erdos_renyi_spec(n, 8 * (edge_t)n, 100, seed);
+    } else {
+        fprintf(stderr, "Error: Unknown graph family '%s'\n", family);
+        return EXIT_FAILURE;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    bool ok = generate_graph_file(&spec, output, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!ok) return EXIT_FAILURE;
+    
+    CSRGraph *g = map_csr_graph(output);
+    if (g == NULL) return EXIT_FAILURE;
+    printf("Wrote '%s': %" PRIdVERTEX " vertices, %" PRIdEDGE " edges (%.1f ms)\n",
+           output, g->num_vertices, g->num_edges, elapsed_ms(t0, t1));
+    free_csr_graph(g);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * main - Program entry point
+ * 
+ * With no arguments, runs the demonstration. Otherwise:
+ *   ./dijkstra GRAPH [SOURCE [TARGET]]
+ *   ./dijkstra --convert GRAPH OUT.bin
+ *   ./dijkstra --generate FAMILY SCALE SEED OUT.bin
+ */
+int main(int argc, char **argv) {
+    if (argc >= 2) {
+        if (strcmp(argv[1], "--convert") == 0 && argc == 4) {
+            return convert_graph_file(argv[2], argv[3]);
+        }
+        if (strcmp(argv[1], "--generate") == 0 && argc == 6) {
+            int scale = atoi(argv[3]);
+            if (scale < 1 || scale > (int)(8 * sizeof(vertex_t)) - 2) {
+                fprintf(stderr, "Error: SCALE must be between 1 and %d\n",
+                        (int)(8 * sizeof(vertex_t)) - 2);
+                return EXIT_FAILURE;
+            }
+            return generate_graph_command(argv[2], scale,
+                                          (uint64_t)strtoull(argv[4], NULL, 10), argv[5]);
+        }
+        if (argv[1][0] != '-' && argc <= 4) {
+            vertex_t source = (argc >= 3) ? (vertex_t)strtoll(argv[2], NULL, 10) : 0;
+            vertex_t target = (argc == 4) ? (vertex_t)strtoll(argv[3], NULL, 10) : -1;
+            return run_graph_file(argv[1], source, target);
+        }
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    
     /* Run the comprehensive demonstration */
     run_comprehensive_demo();
     
@@ -0,0 +1,291 @@
+/*
+ * perf_counters.c - Hardware Performance Counters Around Engine Calls
+ *
+ * Wall time says how long a query took, not why. Linux exposes the
+ * CPU's performance monitoring unit through perf_event_open(); this file
+ * opens one counter per event for the calling thread and reads them
+ * around any engine call:
+ *
+ *   PerfCounters *pc = create_perf_counters();
+ *   PerfSample sample;
+ *   PERF_MEASURE(pc, &sample, r = dijkstra_heap(g, 0));
+ *   print_perf_sample(&sample, &r->stats);    (per settled vertex / edge)
+ *
+ * Events (user space only, so perf_event_paranoid <= 2 suffices):
+ *
+ *   cycles, instructions     IPC of the relaxation loop
+ *   branch misses            unpredictable compares (heap sift, relax)
+ *   L1D / LLC read misses    locality of distance[] and the edge arrays
+ *   dTLB read misses         page-crossing random access on big graphs
+ *   page faults              first touch of freshly allocated arrays
+ *                            (a software event, works on most VMs too)
+ *
+ * Counters are opened separately, not as a group, so that one event the
+ * CPU lacks does not take the others down. When the kernel has to share
+ * the hardware counters among more events than it has, each counter only
+ * runs part of the time; its value is scaled by time enabled / running.
+ *
+ * Graceful degradation: in containers (seccomp), VMs without a virtual
+ * PMU, or with perf_event_paranoid > 2, perf_event_open() fails. Those
+ * counters are simply marked invalid, perf_counters_error() says why, and
+ * PERF_MEASURE() still runs the call. On other systems nothing is opened.
+ */
+
+#define _GNU_SOURCE
+
+#include "dijkstra.h"
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * PerfCounters - Open counters of one thread
+ *
+ * Members:
+ *   fd:    File descriptor per counter, -1 if it could not be opened
+ *   error: Why the first counter that failed is unavailable, NULL if
+ *          every counter opened
+ */
+struct PerfCounters {
+    int fd[NUM_PERF_COUNTERS];
+    const char *error;
+};
+
+static const char *const counter_names[NUM_PERF_COUNTERS] = {
+    "cycles", "instructions", "branch misses", "L1D misses", "LLC misses",
+    "dTLB misses", "page faults"
+};
+
+/*
+ * perf_counter_name - Display name of a counter
+ */
+const char *perf_counter_name(PerfCounter counter) {
+    return (counter >= 0 && counter < NUM_PERF_COUNTERS) ? counter_names[counter] : "?";
+}
+
+#ifdef __linux__
+/*
+ * cache_miss_config - Config word of a PERF_TYPE_HW_CACHE read miss event
+ */
+static uint64_t cache_miss_config(uint64_t cache) {
+    return cache | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |
+           ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+/*
+ * open_counter - perf_event_open() of one counter for this thread, any CPU
+ *
+ * Return: File descriptor, or -1 (errno set)
+ */
+static int open_counter(PerfCounter counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (counter) {
+    case COUNTER_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case COUNTER_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case COUNTER_BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case COUNTER_L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_miss_config(PERF_COUNT_HW_CACHE_L1D);
+        break;
+    case COUNTER_LLC_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_miss_config(PERF_COUNT_HW_CACHE_LL);
+        break;
+    case COUNTER_DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_miss_config(PERF_COUNT_HW_CACHE_DTLB);
+        break;
+    case COUNTER_PAGE_FAULTS:
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * open_error - Explains a perf_event_open() errno
+ */
+static const char *open_error(int error) {
+    switch (error) {
+    case ENOENT:
+    case EOPNOTSUPP:
+        return "event not supported (no PMU, e.g. a virtual machine)";
+    case EACCES:
+    case EPERM:
+        return "not permitted (see /proc/sys/kernel/perf_event_paranoid)";
+    case ENOSYS:
+        return "perf_event_open() not available (container / seccomp)";
+    default:
+        return "perf_event_open() failed";
+    }
+}
+#endif
+
+/*
+ * create_perf_counters - Opens the counters for the calling thread
+ *
+ * Counters that cannot be opened are left out; the handle is still
+ * valid and measuring with it is harmless (see perf_counters_error()).
+ * Only work done by the calling thread is counted.
+ *
+ * Return: Handle, or NULL if out of memory. Free with free_perf_counters()
+ */
+PerfCounters *create_perf_counters(void) {
+    PerfCounters *pc = (PerfCounters *)malloc(sizeof(PerfCounters));
+    if (pc == NULL) {
+        fprintf(stderr, "Error: Failed to allocate performance counters\n");
+        return NULL;
+    }
+    pc->error = NULL;
+
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+#ifdef __linux__
+        pc->fd[c] = open_counter((PerfCounter)c);
+        if (pc->fd[c] < 0 && pc->error == NULL) pc->error = open_error(errno);
+#else
+        pc->fd[c] = -1;
+        pc->error = "perf_event_open() needs Linux";
+#endif
+    }
+    return pc;
+}
+
+/*
+ * perf_counters_available - Number of counters that opened
+ */
+int perf_counters_available(const PerfCounters *pc) {
+    int available = 0;
+    for (int c = 0; pc != NULL && c < NUM_PERF_COUNTERS; c++) {
+        if (pc->fd[c] >= 0) available++;
+    }
+    return available;
+}
+
+/*
+ * perf_counters_error - Why some counters are missing
+ *
+ * Return: Reason for the first counter that failed, or NULL if all opened
+ */
+const char *perf_counters_error(const PerfCounters *pc) {
+    return (pc != NULL) ? pc->error : "no counters";
+}
+
+/*
+ * perf_begin - Zeroes and starts every open counter
+ */
+void perf_begin(PerfCounters *pc) {
+    if (pc == NULL) return;
+#ifdef __linux__
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (pc->fd[c] < 0) continue;
+        ioctl(pc->fd[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fd[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/*
+ * perf_end - Stops the counters and reads them
+ *
+ * @pc:     Counters started by perf_begin()
+ * @sample: Output; value[c] is only meaningful where valid[c]
+ *
+ * Counters that were multiplexed are scaled up to the whole interval; a
+ * counter that never got scheduled is reported invalid.
+ *
+ * Return: true if at least one counter is valid
+ */
+bool perf_end(PerfCounters *pc, PerfSample *sample) {
+    if (sample == NULL) return false;
+    memset(sample, 0, sizeof(*sample));
+    if (pc == NULL) return false;
+
+    bool any = false;
+#ifdef __linux__
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (pc->fd[c] >= 0) ioctl(pc->fd[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        uint64_t data[3];   /* value, time enabled, time running */
+        if (pc->fd[c] < 0 || read(pc->fd[c], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+        if (data[2] == 0) continue;
+        sample->value[c] = (data[2] < data[1])
+                         ? (uint64_t)((double)data[0] * (double)data[1] / (double)data[2])
+                         : data[0];
+        sample->valid[c] = true;
+        any = true;
+    }
+#endif
+    return any;
+}
+
+/*
+ * free_perf_counters - Closes the counters
+ */
+void free_perf_counters(PerfCounters *pc) {
+    if (pc == NULL) return;
+#ifdef __linux__
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (pc->fd[c] >= 0) close(pc->fd[c]);
+    }
+#endif
+    free(pc);
+}
+
+/*
+ * print_perf_sample - Prints counters per settled vertex and per scanned edge
+ *
+ * @sample: Counters of one measured call
+ * @stats:  Work counters of the same call (NULL: totals only)
+ */
+void print_perf_sample(const PerfSample *sample, const DijkstraStats *stats) {
+    if (sample == NULL) return;
+    double settled = (stats != NULL) ? (double)stats->vertices_settled : 0;
+    double scanned = (stats != NULL) ? (double)stats->edges_scanned : 0;
+
+    printf("  %-14s %16s %12s %12s\n", "counter", "total", "per vertex", "per edge");
+    for (int c = 0; c < NUM_PERF_COUNTERS; c++) {
+        if (!sample->valid[c]) {
+            printf("  %-14s %16s\n", counter_names[c], "n/a");
+            continue;
+        }
+        double value = (double)sample->value[c];
+        printf("  %-14s %16" PRIu64, counter_names[c], sample->value[c]);
+        if (settled > 0) printf(" %12.2f", value / settled);
+        if (scanned > 0) printf(" %12.2f", value / scanned);
+        printf("\n");
+    }
+    if (sample->valid[COUNTER_CYCLES] && sample->valid[COUNTER_INSTRUCTIONS] &&
+        sample->value[COUNTER_CYCLES] > 0) {
+        printf("  IPC %.2f\n", (double)sample->value[COUNTER_INSTRUCTIONS] /
+                               (double)sample->value[COUNTER_CYCLES]);
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * simd.h - 32-bit Integer Vector Layer for the Dense Kernels (internal)
+ *
+ * The dense engines (dijkstra_dense(), floyd_warshall()) sweep whole
+ * rows of ints, so each inner loop is written once against these macros
+ * and compiled for whatever the compiler targets:
+ *
+ *   simd_vec     lanes   when
+ *   __m256i        8     __AVX2__ (make MARCH=native on a recent CPU)
+ *   __m128i        4     __SSE2__ (every x86-64 build)
+ *   int32_t        1     anything else (portable scalar fallback)
+ *
+ * Comparisons are signed and return all-ones / all-zero lanes;
+ * vec_select(mask, a, b) takes a where mask is set, b elsewhere, and
+ * vec_movemask() packs the lane masks into the low SIMD_LANES bits.
+ * Loads and stores are unaligned, so rows need no special allocation,
+ * only a length that is a multiple of SIMD_LANES.
+ *
+ * Additions wrap around like the hardware does (no undefined behavior
+ * in the vector paths); kernels must mask out lanes that could overflow.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+typedef __m256i simd_vec;
+#define SIMD_LANES 8
+#define vec_load(p)            _mm256_loadu_si256((const __m256i *)(p))
+#define vec_store(p, v)        _mm256_storeu_si256((__m256i *)(p), (v))
+#define vec_set1(x)            _mm256_set1_epi32(x)
+#define vec_add(a, b)          _mm256_add_epi32((a), (b))
+#define vec_gt(a, b)           _mm256_cmpgt_epi32((a), (b))
+#define vec_eq(a, b)           _mm256_cmpeq_epi32((a), (b))
+#define vec_andnot(a, b)       _mm256_andnot_si256((a), (b))
+#define vec_min(a, b)          _mm256_min_epi32((a), (b))
+#define vec_select(mask, a, b) _mm256_blendv_epi8((b), (a), (mask))
+#define vec_movemask(mask)     _mm256_movemask_ps(_mm256_castsi256_ps(mask))
+#elif defined(__SSE2__)
+typedef __m128i simd_vec;
+#define SIMD_LANES 4
+#define vec_load(p)            _mm_loadu_si128((const __m128i *)(p))
+#define vec_store(p, v)        _mm_storeu_si128((__m128i *)(p), (v))
+#define vec_set1(x)            _mm_set1_epi32(x)
+#define vec_add(a, b)          _mm_add_epi32((a), (b))
+#define vec_gt(a, b)           _mm_cmpgt_epi32((a), (b))
+#define vec_eq(a, b)           _mm_cmpeq_epi32((a), (b))
+#define vec_andnot(a, b)       _mm_andnot_si128((a), (b))
+/* SSE2 has no 32-bit min or blend: select with and / andnot masks */
+#define vec_select(mask, a, b) _mm_or_si128(_mm_and_si128((mask), (a)), \
+                                            _mm_andnot_si128((mask), (b)))
+#define vec_min(a, b)          vec_select(vec_gt((a), (b)), (b), (a))
+#define vec_movemask(mask)     _mm_movemask_ps(_mm_castsi128_ps(mask))
+#else
+typedef int32_t simd_vec;
+#define SIMD_LANES 1
+#define vec_load(p)            (*(p))
+#define vec_store(p, v)        (*(p) = (v))
+#define vec_set1(x)            (x)
+#define vec_add(a, b)          ((int32_t)((uint32_t)(a) + (uint32_t)(b)))
+#define vec_gt(a, b)           (((a) > (b)) ? -1 : 0)
+#define vec_eq(a, b)           (((a) == (b)) ? -1 : 0)
+#define vec_andnot(a, b)       (~(a) & (b))
+#define vec_min(a, b)          (((a) < (b)) ? (a) : (b))
+#define vec_select(mask, a, b) ((mask) ? (a) : (b))
+#define vec_movemask(mask)     ((mask) & 1)
+#endif
+
+#endif /* SIMD_H */
@@ -0,0 +1,105 @@
+/*
+ * threads.h - Thread Counts and Fork-Join Tasks (internal)
+ *
+ * Every parallel entry point takes a num_threads argument with the same
+ * meaning, resolved here once:
+ *
+ *   num_threads = thread_count(num_threads, max);    <= 0: one per online CPU
+ *
+ * The short-lived parallel steps (parser chunks, CH rounds, APSP phases)
+ * run a fixed array of tasks and wait for all of them:
+ *
+ *   TaskThreads team;
+ *   start_tasks(&team, worker, tasks, sizeof(tasks[0]), count);
+ *   ...                               (the caller may overlap other work)
+ *   join_tasks(&team);
+ *
+ * or simply run_tasks(worker, tasks, sizeof(tasks[0]), count).
+ *
+ * A lone task runs on the caller. A task whose thread cannot be created
+ * also runs on the caller, right away, so a failed pthread_create() only
+ * costs parallelism, never correctness.
+ *
+ * Includers define _POSIX_C_SOURCE before any header (for sysconf()).
+ */
+
+#ifndef THREADS_H
+#define THREADS_H
+
+#include "dijkstra.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/* Most tasks one fork-join step can run */
+#define TASK_MAX_THREADS 64
+
+/*
+ * TaskThreads - Threads of one fork-join step
+ *
+ * Members:
+ *   count:    Tasks started
+ *   threads:  Thread of task t (valid only where threaded[t])
+ *   threaded: Task t runs on its own thread and needs a join
+ */
+typedef struct TaskThreads {
+    int count;
+    pthread_t threads[TASK_MAX_THREADS];
+    bool threaded[TASK_MAX_THREADS];
+} TaskThreads;
+
+/*
+ * thread_count - Resolves a num_threads argument
+ *
+ * @num_threads: Requested threads; 0 (or less) means one per online CPU
+ * @max_threads: Upper limit of the caller
+ *
+ * Return: Number of threads in [1, max_threads]
+ */
+static inline int thread_count(int num_threads, int max_threads) {
+    if (num_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (cpus > 0) ? (int)cpus : 1;
+    }
+    return (num_threads > max_threads) ? max_threads : num_threads;
+}
+
+/*
+ * start_tasks - Starts worker(&tasks[t]) for t < @count
+ *
+ * @team:      Receives the threads, for join_tasks()
+ * @worker:    Thread function
+ * @tasks:     Array of @count tasks of @task_size bytes each
+ * @count:     Number of tasks, at most TASK_MAX_THREADS
+ */
+static inline void start_tasks(TaskThreads *team, void *(*worker)(void *),
+                               void *tasks, size_t task_size, int count) {
+    char *task = (char *)tasks;
+    team->count = count;
+    for (int t = 0; t < count; t++, task += task_size) {
+        team->threaded[t] = count > 1 &&
+            pthread_create(&team->threads[t], NULL, worker, task) == 0;
+        if (!team->threaded[t]) {
+            worker(task);   /* Single task, or serial fallback */
+        }
+    }
+}
+
+/*
+ * join_tasks - Waits for every task started by start_tasks()
+ */
+static inline void join_tasks(TaskThreads *team) {
+    for (int t = 0; t < team->count; t++) {
+        if (team->threaded[t]) pthread_join(team->threads[t], NULL);
+    }
+}
+
+/*
+ * run_tasks - start_tasks() followed by join_tasks()
+ */
+static inline void run_tasks(void *(*worker)(void *), void *tasks, size_t task_size, int count) {
+    TaskThreads team;
+    start_tasks(&team, worker, tasks, task_size, count);
+    join_tasks(&team);
+}
+
+#endif /* THREADS_H */
@@ -0,0 +1,68 @@
+/*
+ * typed.c - Dijkstra Specialized for Other Weight / Distance Types
+ *
+ * The int engines use 4-byte weights and saturate at INF = INT_MAX.
+ * That is too narrow for long paths (a chain of a thousand 3-million
+ * weights already overflows) and too wide for small weights, which
+ * cost bandwidth on every edge scan. This file instantiates the
+ * heap engine in typed_engine.h once per DIJKSTRA_WEIGHT_TYPES entry.
+ *
+ * Each instance is compiled with its own heap (keys of the distance
+ * type) and its own saturating add, so there is no run-time dispatch
+ * and no branch in the relaxation arithmetic.
+ *
+ * An #include cannot be expanded from a macro, so the instances are
+ * written out below. They cannot drift from the X-macro:
+ *   - an instance without an entry has no CSRGraph_<suffix> type;
+ *   - an instance whose types differ from its entry fails to compile
+ *     (incompatible pointer types);
+ *   - an entry without an instance fails the check at the end.
+ */
+
+#include "dijkstra.h"
+#include "heap.h"
+#include <float.h>
+
+/* u16: uint16_t weights, uint32_t distances */
+#define TE_SUFFIX     u16
+#define TE_WEIGHT     uint16_t
+#define TE_DIST       uint32_t
+#define TE_WEIGHT_MAX UINT16_MAX
+#define TE_FLOATING   0
+#include "typed_engine.h"
+#undef TE_SUFFIX
+#undef TE_WEIGHT
+#undef TE_DIST
+#undef TE_WEIGHT_MAX
+#undef TE_FLOATING
+
+/* u32: uint32_t weights, uint64_t distances */
+#define TE_SUFFIX     u32
+#define TE_WEIGHT     uint32_t
+#define TE_DIST       uint64_t
+#define TE_WEIGHT_MAX UINT32_MAX
+#define TE_FLOATING   0
+#include "typed_engine.h"
+#undef TE_SUFFIX
+#undef TE_WEIGHT
+#undef TE_DIST
+#undef TE_WEIGHT_MAX
+#undef TE_FLOATING
+
+/* f32: float weights, double distances */
+#define TE_SUFFIX     f32
+#define TE_WEIGHT     float
+#define TE_DIST       double
+#define TE_WEIGHT_MAX FLT_MAX
+#define TE_FLOATING   1
+#include "typed_engine.h"
+#undef TE_SUFFIX
+#undef TE_WEIGHT
+#undef TE_DIST
+#undef TE_WEIGHT_MAX
+#undef TE_FLOATING
+
+/* Names typed_instance_<suffix> of every entry: undeclared if its instance is missing */
+#define TE_REQUIRE_INSTANCE(S, W, D) typed_instance_##S +
+enum { TYPED_INSTANCES = DIJKSTRA_WEIGHT_TYPES(TE_REQUIRE_INSTANCE) 0 };
+#undef TE_REQUIRE_INSTANCE
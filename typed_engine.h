@@ -0,0 +1,227 @@
+/*
+ * typed_engine.h - Body of one typed engine (internal, see typed.c)
+ *
+ * Included once per DIJKSTRA_WEIGHT_TYPES entry, without an include
+ * guard. Before each inclusion define:
+ *
+ *   TE_SUFFIX       Name suffix of the entry (u16, u32, f32)
+ *   TE_WEIGHT       Weight type of the entry
+ *   TE_DIST         Distance type of the entry
+ *   TE_WEIGHT_MAX   Largest weight the type holds (range check on
+ *                   conversion from int weights)
+ *   TE_FLOATING     1 for floating-point types, 0 for unsigned integers
+ *
+ * Every generated type and function is TE_NAME(name) = name_<suffix>,
+ * including a private d-ary heap with TE_DIST keys (heap_impl.h). The
+ * unreachable distance TE_INF is INF_<suffix> from dijkstra.h.
+ */
+
+#define TE_CAT2(a, b) a##_##b
+#define TE_CAT(a, b)  TE_CAT2(a, b)
+#define TE_NAME(name) TE_CAT(name, TE_SUFFIX)
+#define TE_STR2(x)    #x
+#define TE_STR(x)     TE_STR2(x)
+#define TE_INF2(s)    INF_##s
+#define TE_INF1(s)    TE_INF2(s)
+#define TE_INF        TE_INF1(TE_SUFFIX)
+
+/* Marks this entry as instantiated (checked at the end of typed.c) */
+enum { TE_NAME(typed_instance) = 1 };
+
+#define HEAP_KEY        TE_DIST
+#define HEAP_NAME(name) TE_NAME(name)
+#include "heap_impl.h"
+#undef HEAP_KEY
+#undef HEAP_NAME
+
+/*
+ * dist_add - Saturating d + w in the distance type
+ *
+ * Unsigned: the wrapped sum is smaller than d exactly when the addition
+ * overflowed; the comparison (0 or 1) is negated into an all-ones mask
+ * and OR-ed in, so overflow yields TE_INF without a branch.
+ * Floating point: IEEE addition already saturates to +infinity.
+ *
+ * Return: min(d + w, TE_INF)
+ */
+static inline TE_DIST TE_NAME(dist_add)(TE_DIST d, TE_WEIGHT w) {
+#if TE_FLOATING
+    return d + (TE_DIST)w;
+#else
+    TE_DIST sum = d + (TE_DIST)w;
+    return sum | (TE_DIST)((TE_DIST)0 - (TE_DIST)(sum < d));
+#endif
+}
+
+/*
+ * typed_graph - Builds the typed view of a CSR graph
+ *
+ * @g:       Source CSR graph (offsets / destinations are borrowed)
+ * @weights: num_edges weights in CSR edge order, or NULL to convert
+ *           g->weights (each must fit in TE_WEIGHT)
+ *
+ * Time Complexity: O(E)
+ *
+ * Return: New typed graph, or NULL if a weight is out of range / negative
+ */
+TE_NAME(CSRGraph) *TE_NAME(typed_graph)(const CSRGraph *g, const TE_WEIGHT *weights) {
+    if (g == NULL) {
+        fprintf(stderr, "Error: Invalid input to typed_graph_" TE_STR(TE_SUFFIX) "()\n");
+        return NULL;
+    }
+
+    TE_NAME(CSRGraph) *t = (TE_NAME(CSRGraph) *)malloc(sizeof(TE_NAME(CSRGraph)));
+    TE_WEIGHT *w = (TE_WEIGHT *)malloc(((size_t)g->num_edges + 1) * sizeof(TE_WEIGHT));
+    if (t == NULL || w == NULL) {
+        free(t);
+        free(w);
+        return NULL;
+    }
+
+    for (edge_t e = 0; e < g->num_edges; e++) {
+        if (weights != NULL) {
+#if TE_FLOATING
+            /* written as !(x >= 0) so that NaN is rejected too */
+            if (!(weights[e] >= 0)) {
+                fprintf(stderr, "Error: Negative weight at edge %" PRIdEDGE "\n", e);
+                free(t);
+                free(w);
+                return NULL;
+            }
+#endif
+            w[e] = weights[e];
+        } else {
+            int x = g->weights[e];
+            if (x < 0 || (double)x > (double)TE_WEIGHT_MAX) {
+                fprintf(stderr, "Error: Weight %d at edge %" PRIdEDGE " does not fit in "
+                        TE_STR(TE_WEIGHT) "\n", x, e);
+                free(t);
+                free(w);
+                return NULL;
+            }
+            w[e] = (TE_WEIGHT)x;
+        }
+    }
+
+    t->num_vertices = g->num_vertices;
+    t->num_edges = g->num_edges;
+    t->offsets = g->offsets;
+    t->destinations = g->destinations;
+    t->weights = w;
+    return t;
+}
+
+/*
+ * free_typed_graph - Frees the typed weights (not the borrowed structure)
+ */
+void TE_NAME(free_typed_graph)(TE_NAME(CSRGraph) *g) {
+    if (g == NULL) return;
+    free(g->weights);
+    free(g);
+}
+
+/*
+ * free_result - Frees a typed result
+ */
+void TE_NAME(free_result)(TE_NAME(DijkstraResult) *result) {
+    if (result == NULL) return;
+    free(result->distance);
+    free(result->parent);
+    free(result);
+}
+
+/*
+ * dijkstra_heap - Heap-optimized Dijkstra in the typed arithmetic
+ *
+ * @g:      Typed CSR graph
+ * @source: Starting vertex
+ *
+ * Same loop as dijkstra_heap_csr(), with TE_WEIGHT loads, TE_DIST
+ * distances and heap keys, and the saturating dist_add() above.
+ *
+ * Time Complexity: O((V + E) log V)
+ *
+ * Return: Typed result (unreachable vertices at TE_INF), NULL on failure
+ */
+TE_NAME(DijkstraResult) *TE_NAME(dijkstra_heap)(const TE_NAME(CSRGraph) *g, vertex_t source) {
+    if (g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_heap_" TE_STR(TE_SUFFIX) "()\n");
+        return NULL;
+    }
+
+    vertex_t n = g->num_vertices;
+    TE_NAME(DijkstraResult) *result =
+        (TE_NAME(DijkstraResult) *)calloc(1, sizeof(TE_NAME(DijkstraResult)));
+    if (result == NULL) return NULL;
+    result->distance = (TE_DIST *)malloc(((size_t)n + 1) * sizeof(TE_DIST));
+    result->parent = (vertex_t *)malloc(((size_t)n + 1) * sizeof(vertex_t));
+
+    TE_NAME(DaryHeap) heap;
+    if (result->distance == NULL || result->parent == NULL ||
+        !TE_NAME(heap_init)(&heap, n)) {
+        TE_NAME(free_result)(result);
+        return NULL;
+    }
+    result->source = source;
+    result->num_vertices = n;
+
+    const edge_t *offsets = g->offsets;
+    const vertex_t *destinations = g->destinations;
+    const TE_WEIGHT *weights = g->weights;
+    TE_DIST *distance = result->distance;
+    vertex_t *parent = result->parent;
+    DijkstraStats stats = {0};
+
+    for (vertex_t v = 0; v < n; v++) {
+        distance[v] = TE_INF;
+        parent[v] = -1;
+    }
+
+    distance[source] = 0;
+    TE_NAME(heap_push)(&heap, source, 0);
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
+
+    while (!TE_NAME(heap_empty)(&heap)) {
+        vertex_t u = TE_NAME(heap_pop)(&heap).vertex;
+        TE_DIST du = distance[u];
+        stats.heap_pops++;
+        stats.vertices_settled++;
+
+        edge_t end = offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - offsets[u]);
+        for (edge_t i = offsets[u]; i < end; i++) {
+            vertex_t v = destinations[i];
+            TE_DIST candidate = TE_NAME(dist_add)(du, weights[i]);
+            if (candidate < distance[v]) {
+                distance[v] = candidate;
+                parent[v] = u;
+                stats.relaxations++;
+
+                if (TE_NAME(heap_contains)(&heap, v)) {
+                    TE_NAME(heap_decrease_key)(&heap, v, candidate);
+                    stats.heap_decrease_keys++;
+                } else {
+                    TE_NAME(heap_push)(&heap, v, candidate);
+                    stats.heap_pushes++;
+                    if ((uint64_t)heap.size > stats.max_heap_size) {
+                        stats.max_heap_size = (uint64_t)heap.size;
+                    }
+                }
+            }
+        }
+    }
+
+    TE_NAME(heap_free)(&heap);
+    result->stats = stats;
+    return result;
+}
+
+#undef TE_CAT2
+#undef TE_CAT
+#undef TE_NAME
+#undef TE_STR2
+#undef TE_STR
+#undef TE_INF2
+#undef TE_INF1
+#undef TE_INF
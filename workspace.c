@@ -0,0 +1,274 @@
+/*
+ * workspace.c - Dijkstra Queries on a Reusable Workspace
+ *
+ * dijkstra_heap_csr() allocates and initializes V-sized arrays on every
+ * call. For local queries on a huge graph that O(V) setup costs more
+ * than the search itself. Here the arrays are allocated once per thread
+ * in a DijkstraWorkspace (see workspace.h) and every query only pays
+ * for the vertices it actually touches.
+ *
+ * Typical use:
+ *
+ *   DijkstraWorkspace *ws = create_workspace(g->num_vertices);
+ *   for each query:
+ *       dijkstra_workspace(ws, g, source);
+ *       ... workspace_distance(ws, v), workspace_parent(ws, v) ...
+ *   free_workspace(ws);
+ *
+ * For single-pair routing, dijkstra_workspace_to() stops as soon as the
+ * target is settled and workspace_path() extracts the route.
+ *
+ * A workspace must not be shared by concurrent queries; use one per
+ * thread.
+ */
+
+#include "workspace.h"
+
+/*
+ * create_workspace - Allocates a workspace for graphs of up to @capacity vertices
+ *
+ * @capacity: Number of vertices of the largest graph it will be used with
+ *
+ * Time Complexity: O(V) - once, not per query
+ *
+ * Return: Pointer to the workspace, or NULL on failure
+ *         Caller must call free_workspace()!
+ */
+DijkstraWorkspace *create_workspace(vertex_t capacity) {
+    if (capacity < 0) {
+        fprintf(stderr, "Error: Invalid capacity in create_workspace()\n");
+        return NULL;
+    }
+
+    DijkstraWorkspace *ws = (DijkstraWorkspace *)malloc(sizeof(DijkstraWorkspace));
+    if (ws == NULL) return NULL;
+
+    size_t n = (size_t)capacity + 1;
+    ws->stamp = (uint32_t *)calloc(n, sizeof(uint32_t));
+    ws->distance = (int *)malloc(n * sizeof(int));
+    ws->parent = (vertex_t *)malloc(n * sizeof(vertex_t));
+    ws->touched = (vertex_t *)malloc(n * sizeof(vertex_t));
+    bool heap_ok = heap_init(&ws->heap, capacity);
+
+    if (ws->stamp == NULL || ws->distance == NULL || ws->parent == NULL ||
+        ws->touched == NULL || !heap_ok) {
+        fprintf(stderr, "Error: Memory allocation failed for workspace\n");
+        if (heap_ok) heap_free(&ws->heap);
+        free(ws->stamp);
+        free(ws->distance);
+        free(ws->parent);
+        free(ws->touched);
+        free(ws);
+        return NULL;
+    }
+
+    ws->capacity = capacity;
+    ws->generation = 1;  /* All stamps are 0: nothing touched yet */
+    ws->num_touched = 0;
+    ws->source = -1;
+    ws->stats = (DijkstraStats){0};
+    return ws;
+}
+
+/*
+ * free_workspace - Releases a workspace
+ */
+void free_workspace(DijkstraWorkspace *ws) {
+    if (ws == NULL) return;
+    heap_free(&ws->heap);
+    free(ws->stamp);
+    free(ws->distance);
+    free(ws->parent);
+    free(ws->touched);
+    free(ws);
+}
+
+/*
+ * ws_search - Heap-based search into a workspace
+ *
+ * @target: Vertex at which to stop, or -1 to settle everything reachable
+ *
+ * The heap is left as-is when stopping early; ws_begin_query() of the
+ * next query clears whatever is still in it.
+ */
+static bool ws_search(DijkstraWorkspace *ws, const CSRGraph *g,
+                      vertex_t source, vertex_t target) {
+    if (g->num_vertices > ws->capacity) {
+        fprintf(stderr, "Error: Graph has %" PRIdVERTEX " vertices, workspace holds %"
+                PRIdVERTEX "\n", g->num_vertices, ws->capacity);
+        return false;
+    }
+
+    ws_begin_query(ws, source);
+
+    const edge_t *offsets = g->offsets;
+    const vertex_t *destinations = g->destinations;
+    const int *weights = g->weights;
+    DaryHeap *heap = &ws->heap;
+    DijkstraStats stats = {0};
+
+    ws_set(ws, source, 0, -1);
+    heap_push(heap, source, 0);
+    stats.heap_pushes = 1;
+    stats.max_heap_size = 1;
+
+    while (!heap_empty(heap)) {
+        vertex_t u = heap_pop(heap).vertex;
+        int du = ws->distance[u];
+        stats.heap_pops++;
+        stats.vertices_settled++;
+        if (u == target) break;
+
+        edge_t end = offsets[u + 1];
+        stats.edges_scanned += (uint64_t)(end - offsets[u]);
+        for (edge_t i = offsets[u]; i < end; i++) {
+            vertex_t v = destinations[i];
+            int candidate = dist_add(du, weights[i]);
+            if (candidate < ws_distance(ws, v)) {
+                ws_set(ws, v, candidate, u);
+                stats.relaxations++;
+
+                if (heap_contains(heap, v)) {
+                    heap_decrease_key(heap, v, candidate);
+                    stats.heap_decrease_keys++;
+                } else {
+                    heap_push(heap, v, candidate);
+                    stats.heap_pushes++;
+                    if ((uint64_t)heap->size > stats.max_heap_size) {
+                        stats.max_heap_size = (uint64_t)heap->size;
+                    }
+                }
+            }
+        }
+    }
+
+    ws->stats = stats;
+    return true;
+}
+
+/*
+ * dijkstra_workspace - Heap-based Dijkstra into a reusable workspace
+ *
+ * @ws:     Workspace with capacity >= g->num_vertices
+ * @g:      Pointer to the CSR graph
+ * @source: Starting vertex
+ *
+ * Same search as dijkstra_heap_csr(), but nothing is allocated and
+ * nothing V-sized is initialized: results of the previous query are
+ * invalidated by bumping the workspace generation.
+ *
+ * Time Complexity: O((T + E_T) log T), T = vertices touched,
+ *                  E_T = edges scanned - independent of V
+ *
+ * Return: true on success; results are read with workspace_distance()
+ *         and workspace_parent() until the next query on @ws
+ */
+bool dijkstra_workspace(DijkstraWorkspace *ws, const CSRGraph *g, vertex_t source) {
+    if (ws == NULL || g == NULL || source < 0 || source >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_workspace()\n");
+        return false;
+    }
+    return ws_search(ws, g, source, -1);
+}
+
+/*
+ * dijkstra_workspace_to - Point-to-point query into a reusable workspace
+ *
+ * @ws:     Workspace with capacity >= g->num_vertices
+ * @g:      Pointer to the CSR graph
+ * @source: Starting vertex
+ * @target: Destination vertex; the search stops once it is settled
+ *
+ * The allocation-free form of dijkstra_to() for serving many
+ * single-pair queries. Only @target's distance and parent chain are
+ * final afterwards; other touched vertices may hold tentative values.
+ *
+ * Time Complexity: O((T + E_T) log T) for the T vertices closer than
+ *                  @target - independent of V
+ *
+ * Return: true on success; use workspace_distance(ws, target) and
+ *         workspace_path(ws, target)
+ */
+bool dijkstra_workspace_to(DijkstraWorkspace *ws, const CSRGraph *g,
+                           vertex_t source, vertex_t target) {
+    if (ws == NULL || g == NULL || source < 0 || source >= g->num_vertices ||
+        target < 0 || target >= g->num_vertices) {
+        fprintf(stderr, "Error: Invalid input to dijkstra_workspace_to()\n");
+        return false;
+    }
+    return ws_search(ws, g, source, target);
+}
+
+/*
+ * workspace_path - Extracts the path to @target from the last query
+ *
+ * @ws:     Workspace after dijkstra_workspace() or dijkstra_workspace_to()
+ * @target: Destination vertex (must be settled by that query)
+ *
+ * Time Complexity: O(path length)
+ *
+ * Return: ShortestPath (distance INF and no vertices if unreachable),
+ *         or NULL on invalid input / allocation failure
+ *         Caller must call free_shortest_path()!
+ */
+ShortestPath *workspace_path(const DijkstraWorkspace *ws, vertex_t target) {
+    if (ws == NULL || target < 0 || target >= ws->capacity || ws->source < 0) {
+        fprintf(stderr, "Error: Invalid input to workspace_path()\n");
+        return NULL;
+    }
+
+    ShortestPath *sp = (ShortestPath *)malloc(sizeof(ShortestPath));
+    if (sp == NULL) return NULL;
+
+    sp->source = ws->source;
+    sp->target = target;
+    sp->distance = ws_distance(ws, target);
+    sp->vertices = NULL;
+    sp->length = 0;
+    sp->stats = ws->stats;
+    if (sp->distance == INF) return sp;
+
+    for (vertex_t v = target; v != -1; v = ws->parent[v]) {
+        sp->length++;
+    }
+
+    sp->vertices = (vertex_t *)malloc((size_t)sp->length * sizeof(vertex_t));
+    if (sp->vertices == NULL) {
+        free(sp);
+        return NULL;
+    }
+
+    vertex_t v = target;
+    for (vertex_t i = sp->length - 1; i >= 0; i--) {
+        sp->vertices[i] = v;
+        v = ws->parent[v];
+    }
+    return sp;
+}
+
+/*
+ * workspace_distance - Distance from the last query's source to @v
+ *
+ * Return: Shortest distance, or INF if @v was not reached
+ */
+int workspace_distance(const DijkstraWorkspace *ws, vertex_t v) {
+    if (v < 0 || v >= ws->capacity) return INF;
+    return ws_distance(ws, v);
+}
+
+/*
+ * workspace_parent - Predecessor of @v on its shortest path
+ *
+ * Return: Parent vertex, or -1 for the source and unreached vertices
+ */
+vertex_t workspace_parent(const DijkstraWorkspace *ws, vertex_t v) {
+    if (v < 0 || v >= ws->capacity || !ws_touched(ws, v)) return -1;
+    return ws->parent[v];
+}
+
+/*
+ * workspace_stats - Work counters of the last query
+ */
+const DijkstraStats *workspace_stats(const DijkstraWorkspace *ws) {
+    return &ws->stats;
+}
@@ -0,0 +1,99 @@
+/*
+ * workspace.h - Reusable Per-Thread Query State (internal)
+ *
+ * A DijkstraWorkspace owns every array a query needs: distances,
+ * parents, the heap, and the list of vertices the query touched. It is
+ * allocated once and reused, so a query costs O(touched), not O(V).
+ *
+ * Generation Stamping:
+ *   Instead of resetting distance[] to INF before every query, each
+ *   vertex carries the generation number of the query that last wrote
+ *   it. Starting a query just increments the generation:
+ *
+ *     stamp[v] == generation   →  distance[v], parent[v] are valid
+ *     stamp[v] != generation   →  v is untouched: distance INF, parent -1
+ *
+ *   The stamps are only cleared for real when the 32-bit generation
+ *   counter wraps around, once every 2^32 - 1 queries.
+ *
+ * The struct is exposed here (not in dijkstra.h) so that engines in
+ * other files can inline the accessors; library users only see the
+ * opaque handle and the functions in dijkstra.h.
+ */
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include "dijkstra.h"
+#include "heap.h"
+#include <string.h>
+
+/*
+ * DijkstraWorkspace - Query state reused across queries
+ *
+ * Members:
+ *   capacity:    Largest number of vertices a graph may have
+ *   generation:  Stamp of the current query (never 0)
+ *   stamp:       stamp[v] == generation if v was touched by this query
+ *   distance:    Tentative / final distances (valid only where stamped)
+ *   parent:      Parent pointers (valid only where stamped)
+ *   touched:     Vertices touched by this query, in first-touch order
+ *   num_touched: Length of touched
+ *   source:      Source of the current query (-1 before the first)
+ *   heap:        Priority queue, empty between queries
+ *   stats:       Work counters of the last query
+ */
+struct DijkstraWorkspace {
+    vertex_t capacity;
+    uint32_t generation;
+    uint32_t *stamp;
+    int *distance;
+    vertex_t *parent;
+    vertex_t *touched;
+    vertex_t num_touched;
+    vertex_t source;
+    DaryHeap heap;
+    DijkstraStats stats;
+};
+
+/*
+ * ws_begin_query - Invalidates the previous query's state
+ *
+ * Time Complexity: O(size of leftover heap), O(V) once every 2^32 queries
+ */
+static inline void ws_begin_query(DijkstraWorkspace *ws, vertex_t source) {
+    heap_clear(&ws->heap);
+    ws->generation++;
+    if (ws->generation == 0) {
+        memset(ws->stamp, 0, (size_t)ws->capacity * sizeof(uint32_t));
+        ws->generation = 1;
+    }
+    ws->num_touched = 0;
+    ws->source = source;
+    ws->stats = (DijkstraStats){0};
+}
+
+static inline bool ws_touched(const DijkstraWorkspace *ws, vertex_t v) {
+    return ws->stamp[v] == ws->generation;
+}
+
+/*
+ * ws_distance - Distance of @v in the current query (INF if untouched)
+ */
+static inline int ws_distance(const DijkstraWorkspace *ws, vertex_t v) {
+    return ws_touched(ws, v) ? ws->distance[v] : INF;
+}
+
+/*
+ * ws_set - Records a new tentative distance and parent for @v
+ */
+static inline void ws_set(DijkstraWorkspace *ws, vertex_t v, int dist, vertex_t parent) {
+    if (!ws_touched(ws, v)) {
+        ws->stamp[v] = ws->generation;
+        ws->touched[ws->num_touched++] = v;
+    }
+    ws->distance[v] = dist;
+    ws->parent[v] = parent;
+}
+
+#endif /* WORKSPACE_H */